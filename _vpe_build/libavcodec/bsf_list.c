@@ -0,0 +1,5 @@
+static const AVBitStreamFilter * const bitstream_filters[] = {
+    &ff_h264_mp4toannexb_bsf,
+    &ff_hevc_mp4toannexb_bsf,
+    &ff_null_bsf,
+    NULL };
@@ -0,0 +1,14 @@
+static const AVCodec * const codec_list[] = {
+    &ff_rawvideo_encoder,
+    &ff_wrapped_avframe_encoder,
+    &ff_h264_vpe_encoder,
+    &ff_hevc_vpe_encoder,
+    &ff_vp9_vpe_encoder,
+    &ff_h264_decoder,
+    &ff_hevc_decoder,
+    &ff_rawvideo_decoder,
+    &ff_wrapped_avframe_decoder,
+    &ff_h264_vpe_decoder,
+    &ff_hevc_vpe_decoder,
+    &ff_vp9_vpe_decoder,
+    NULL };
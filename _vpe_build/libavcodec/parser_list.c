@@ -0,0 +1,4 @@
+static const AVCodecParser * const parser_list[] = {
+    &ff_h264_parser,
+    &ff_hevc_parser,
+    NULL };
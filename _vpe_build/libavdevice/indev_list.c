@@ -0,0 +1,3 @@
+static const AVInputFormat * const indev_list[] = {
+    &ff_lavfi_demuxer,
+    NULL };
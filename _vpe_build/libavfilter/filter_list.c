@@ -0,0 +1,24 @@
+static const AVFilter * const filter_list[] = {
+    &ff_af_aformat,
+    &ff_af_anull,
+    &ff_af_atrim,
+    &ff_vf_format,
+    &ff_vf_hflip,
+    &ff_vf_hwdownload,
+    &ff_vf_hwmap,
+    &ff_vf_hwupload,
+    &ff_vf_null,
+    &ff_vf_scale,
+    &ff_vf_split,
+    &ff_vf_transpose,
+    &ff_vf_trim,
+    &ff_vf_vflip,
+    &ff_vf_spliter_vpe,
+    &ff_vf_pp_vpe,
+    &ff_vsrc_testsrc,
+    &ff_vsink_nullsink,
+    &ff_asrc_abuffer,
+    &ff_vsrc_buffer,
+    &ff_asink_abuffer,
+    &ff_vsink_buffer,
+    NULL };
@@ -0,0 +1,6 @@
+static const AVInputFormat * const demuxer_list[] = {
+    &ff_h264_demuxer,
+    &ff_hevc_demuxer,
+    &ff_nut_demuxer,
+    &ff_rawvideo_demuxer,
+    NULL };
@@ -0,0 +1,9 @@
+static const AVOutputFormat * const muxer_list[] = {
+    &ff_framemd5_muxer,
+    &ff_h264_muxer,
+    &ff_hevc_muxer,
+    &ff_md5_muxer,
+    &ff_null_muxer,
+    &ff_nut_muxer,
+    &ff_rawvideo_muxer,
+    NULL };
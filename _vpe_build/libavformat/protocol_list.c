@@ -0,0 +1,4 @@
+static const URLProtocol * const url_protocols[] = {
+    &ff_file_protocol,
+    &ff_pipe_protocol,
+    NULL };
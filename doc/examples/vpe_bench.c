@@ -0,0 +1,772 @@
+/*
+ * Verisilicon sample benchmarking concurrent VPE transcode channels.
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * VPE multi-channel transcode benchmark.
+ *
+ * @example vpe_bench.c
+ * Run N transcode channels concurrently, each in its own thread with its
+ * own demuxer, VPE decoder, spliter_vpe graph and one VPE encoder per
+ * rendition of the ladder, on one or several devices. Every combination of
+ * the given ladder shapes and encoder performance profiles is run in turn,
+ * and for each the aggregate fps, the latency percentiles of every
+ * rendition per channel and in total, the host CPU per channel and an
+ * estimate of the device frame buffer memory are reported. The packets
+ * are not written anywhere.
+ *
+ * Usage: vpe_bench [options] <input file>
+ *   -c channels   number of concurrent channels [1]
+ *   -d device     device path, ':' separated list or "auto" [/dev/transcoder0]
+ *   -e encoder    h264enc_vpe, hevcenc_vpe or vp9enc_vpe [h264enc_vpe]
+ *   -l ladder     ',' separated downscaled renditions, e.g.
+ *                 1280x720,640x360; repeat to sweep several ladders
+ *                 [full resolution only]
+ *   -p profiles   ',' separated perf_profile values to sweep [none]
+ *   -b bitrate    bitrate of the full resolution rendition, the others
+ *                 are scaled by their area [10000000]
+ *   -n frames     stop each channel after this many frames, 0 for the
+ *                 whole input [0]
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <libavcodec/avcodec.h>
+#include <libavfilter/buffersink.h>
+#include <libavfilter/buffersrc.h>
+#include <libavformat/avformat.h>
+#include <libavutil/avstring.h>
+#include <libavutil/hwcontext.h>
+#include <libavutil/hwcontext_vpe.h>
+#include <libavutil/opt.h>
+#include <libavutil/parseutils.h>
+#include <libavutil/time.h>
+
+#define MAX_CHANNELS   64
+#define MAX_RENDITIONS 4
+#define MAX_LADDERS    16
+#define NB_PENDING     256
+
+typedef struct Channel {
+    int index;
+    pthread_t thread;
+
+    AVFormatContext *fmt_ctx;
+    int stream_index;
+    AVCodecContext *dec_ctx;
+    AVFilterGraph *graph;
+    AVFilterContext *src;
+    AVFilterContext *sinks[MAX_RENDITIONS];
+    AVCodecContext *enc_ctx[MAX_RENDITIONS];
+
+    /* submission time of the packets still in the pipeline, by pts, and
+       the renditions which already output them */
+    struct {
+        int64_t pts;
+        int64_t time;
+        unsigned done;
+    } pending[NB_PENDING];
+    int pending_pos;
+
+    /* packet to packet latencies of each rendition, in us */
+    int64_t *latencies[MAX_RENDITIONS];
+    int nb_latencies[MAX_RENDITIONS];
+    int latencies_size[MAX_RENDITIONS];
+
+    int nb_packets;
+    int64_t nb_frames;
+    int64_t elapsed;
+    int64_t cpu_time;
+    int ret;
+} Channel;
+
+static const char *input_file;
+static const char *device = "/dev/transcoder0";
+static const char *encoder = "h264enc_vpe";
+static const char *ladders[MAX_LADDERS];
+static int nb_ladders;
+static const char *profiles = "none";
+static int64_t bitrate = 10000000;
+static int nb_channels = 1;
+static int max_frames;
+
+static AVBufferRef *hw_device_ctx;
+static pthread_barrier_t start_barrier;
+static pthread_mutex_t running_lock = PTHREAD_MUTEX_INITIALIZER;
+static int nb_running;
+
+/* the ladder and profile of the current run */
+static int nb_renditions;
+static int rendition_w[MAX_RENDITIONS], rendition_h[MAX_RENDITIONS];
+static const char *profile;
+
+static int64_t thread_cpu_time(int who)
+{
+    struct rusage usage;
+
+    if (getrusage(who, &usage) < 0)
+        return 0;
+    return usage.ru_utime.tv_sec * 1000000LL + usage.ru_utime.tv_usec +
+           usage.ru_stime.tv_sec * 1000000LL + usage.ru_stime.tv_usec;
+}
+
+/* CPU time of the calling thread, -1 where getrusage() cannot measure it */
+static int64_t channel_cpu_time(void)
+{
+#ifdef RUSAGE_THREAD
+    return thread_cpu_time(RUSAGE_THREAD);
+#else
+    return -1;
+#endif
+}
+
+static void channel_submit(Channel *ch, int64_t pts)
+{
+    ch->pending[ch->pending_pos].pts  = pts;
+    ch->pending[ch->pending_pos].time = av_gettime_relative();
+    ch->pending[ch->pending_pos].done = 0;
+    ch->pending_pos = (ch->pending_pos + 1) % NB_PENDING;
+}
+
+static int channel_complete(Channel *ch, int rendition, int64_t pts)
+{
+    int64_t *latencies;
+    int size = ch->latencies_size[rendition];
+    int i;
+
+    if (!rendition)
+        ch->nb_frames++;
+    for (i = 0; i < NB_PENDING; i++) {
+        if (ch->pending[i].time && ch->pending[i].pts == pts &&
+            !(ch->pending[i].done & (1 << rendition)))
+            break;
+    }
+    if (i == NB_PENDING)
+        return 0;
+
+    if (ch->nb_latencies[rendition] == size) {
+        latencies = av_realloc_array(ch->latencies[rendition],
+                                     FFMAX(2 * size, 1024),
+                                     sizeof(*latencies));
+        if (!latencies)
+            return AVERROR(ENOMEM);
+        ch->latencies[rendition]      = latencies;
+        ch->latencies_size[rendition] = FFMAX(2 * size, 1024);
+    }
+    ch->latencies[rendition][ch->nb_latencies[rendition]++] =
+        av_gettime_relative() - ch->pending[i].time;
+    /* the entry is free once every rendition output the packet */
+    ch->pending[i].done |= 1 << rendition;
+    if (ch->pending[i].done == (1 << nb_renditions) - 1)
+        ch->pending[i].time = 0;
+
+    return 0;
+}
+
+static int open_decoder(Channel *ch)
+{
+    AVDictionary *opts = NULL;
+    AVStream *stream;
+    const char *name;
+    AVCodec *dec;
+    char low_res[256];
+    int i, ret;
+
+    ret = avformat_open_input(&ch->fmt_ctx, input_file, NULL, NULL);
+    if (ret < 0)
+        return ret;
+    ret = avformat_find_stream_info(ch->fmt_ctx, NULL);
+    if (ret < 0)
+        return ret;
+    ret = av_find_best_stream(ch->fmt_ctx, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0);
+    if (ret < 0)
+        return ret;
+    ch->stream_index = ret;
+    stream           = ch->fmt_ctx->streams[ch->stream_index];
+
+    switch (stream->codecpar->codec_id) {
+    case AV_CODEC_ID_H264: name = "h264_vpe"; break;
+    case AV_CODEC_ID_HEVC: name = "hevc_vpe"; break;
+    case AV_CODEC_ID_VP9:  name = "vp9_vpe";  break;
+    default:
+        fprintf(stderr, "Input must be H264, HEVC or VP9\n");
+        return AVERROR(EINVAL);
+    }
+    dec = avcodec_find_decoder_by_name(name);
+    if (!dec)
+        return AVERROR_DECODER_NOT_FOUND;
+
+    ch->dec_ctx = avcodec_alloc_context3(dec);
+    if (!ch->dec_ctx)
+        return AVERROR(ENOMEM);
+    avcodec_parameters_to_context(ch->dec_ctx, stream->codecpar);
+    ch->dec_ctx->framerate     = av_guess_frame_rate(ch->fmt_ctx, stream, NULL);
+    ch->dec_ctx->hw_device_ctx = av_buffer_ref(hw_device_ctx);
+    if (!ch->dec_ctx->hw_device_ctx)
+        return AVERROR(ENOMEM);
+
+    av_dict_set(&opts, "transcode", "1", 0);
+    if (nb_renditions > 1) {
+        snprintf(low_res, sizeof(low_res), "%d:", nb_renditions);
+        for (i = 1; i < nb_renditions; i++)
+            av_strlcatf(low_res, sizeof(low_res), "(%dx%d)",
+                        rendition_w[i], rendition_h[i]);
+        av_dict_set(&opts, "low_res", low_res, 0);
+    }
+    ret = avcodec_open2(ch->dec_ctx, dec, &opts);
+    av_dict_free(&opts);
+
+    return ret;
+}
+
+/**
+ * buffer -> spliter_vpe -> format -> buffersink for each rendition, the
+ * format filters make spliter_vpe count the outputs as consumed.
+ */
+static int init_filters(Channel *ch, const AVFrame *frame)
+{
+    AVStream *stream = ch->fmt_ctx->streams[ch->stream_index];
+    AVBufferSrcParameters *par;
+    AVFilterContext *spliter, *format;
+    char name[32], args[32];
+    int i, ret;
+
+    ch->graph = avfilter_graph_alloc();
+    par       = av_buffersrc_parameters_alloc();
+    if (!ch->graph || !par) {
+        av_free(par);
+        return AVERROR(ENOMEM);
+    }
+
+    snprintf(args, sizeof(args), "outputs=%d", nb_renditions);
+    ret = avfilter_graph_create_filter(&ch->src,
+                                       avfilter_get_by_name("buffer"), "in",
+                                       NULL, NULL, ch->graph);
+    if (ret < 0)
+        goto end;
+    par->format              = frame->format;
+    par->width               = frame->width;
+    par->height              = frame->height;
+    par->time_base           = stream->time_base;
+    par->sample_aspect_ratio = frame->sample_aspect_ratio;
+    par->hw_frames_ctx       = frame->hw_frames_ctx;
+    ret = av_buffersrc_parameters_set(ch->src, par);
+    if (ret < 0)
+        goto end;
+
+    ret = avfilter_graph_create_filter(&spliter,
+                                       avfilter_get_by_name("spliter_vpe"),
+                                       "spliter", args, NULL, ch->graph);
+    if (ret < 0)
+        goto end;
+    ret = avfilter_link(ch->src, 0, spliter, 0);
+    if (ret < 0)
+        goto end;
+
+    for (i = 0; i < nb_renditions; i++) {
+        snprintf(name, sizeof(name), "format%d", i);
+        ret = avfilter_graph_create_filter(&format,
+                                           avfilter_get_by_name("format"),
+                                           name, "pix_fmts=vpe", NULL,
+                                           ch->graph);
+        if (ret < 0)
+            goto end;
+        snprintf(name, sizeof(name), "out%d", i);
+        ret = avfilter_graph_create_filter(&ch->sinks[i],
+                                           avfilter_get_by_name("buffersink"),
+                                           name, NULL, NULL, ch->graph);
+        if (ret < 0)
+            goto end;
+        if ((ret = avfilter_link(spliter, i, format, 0)) < 0 ||
+            (ret = avfilter_link(format, 0, ch->sinks[i], 0)) < 0)
+            goto end;
+    }
+
+    for (i = 0; i < ch->graph->nb_filters; i++) {
+        ch->graph->filters[i]->hw_device_ctx = av_buffer_ref(hw_device_ctx);
+        if (!ch->graph->filters[i]->hw_device_ctx) {
+            ret = AVERROR(ENOMEM);
+            goto end;
+        }
+    }
+
+    ret = avfilter_graph_config(ch->graph, NULL);
+
+end:
+    av_free(par);
+    return ret;
+}
+
+static int open_encoders(Channel *ch)
+{
+    AVCodec *enc = avcodec_find_encoder_by_name(encoder);
+    AVDictionary *opts = NULL;
+    AVCodecContext *enc_ctx;
+    AVBufferRef *hw_frames_ctx;
+    char ladder[32];
+    int i, ret;
+
+    if (!enc)
+        return AVERROR_ENCODER_NOT_FOUND;
+
+    for (i = 0; i < nb_renditions; i++) {
+        enc_ctx = ch->enc_ctx[i] = avcodec_alloc_context3(enc);
+        if (!enc_ctx)
+            return AVERROR(ENOMEM);
+        enc_ctx->width     = av_buffersink_get_w(ch->sinks[i]);
+        enc_ctx->height    = av_buffersink_get_h(ch->sinks[i]);
+        enc_ctx->pix_fmt   = av_buffersink_get_format(ch->sinks[i]);
+        enc_ctx->time_base = av_buffersink_get_time_base(ch->sinks[i]);
+        enc_ctx->framerate = ch->dec_ctx->framerate;
+        enc_ctx->bit_rate  = bitrate * enc_ctx->width * enc_ctx->height /
+                             (ch->dec_ctx->width * ch->dec_ctx->height);
+        enc_ctx->sample_aspect_ratio =
+            av_buffersink_get_sample_aspect_ratio(ch->sinks[i]);
+
+        hw_frames_ctx          = av_buffersink_get_hw_frames_ctx(ch->sinks[i]);
+        enc_ctx->hw_frames_ctx = av_buffer_ref(hw_frames_ctx);
+        enc_ctx->hw_device_ctx = av_buffer_ref(hw_device_ctx);
+        if (!enc_ctx->hw_frames_ctx || !enc_ctx->hw_device_ctx)
+            return AVERROR(ENOMEM);
+
+        av_dict_set(&opts, "perf_profile", profile, 0);
+        if (nb_renditions > 1) {
+            snprintf(ladder, sizeof(ladder), "bench%d", ch->index);
+            av_dict_set(&opts, "ladder", ladder, 0);
+        }
+        ret = avcodec_open2(enc_ctx, enc, &opts);
+        av_dict_free(&opts);
+        if (ret < 0) {
+            fprintf(stderr, "Channel %d: cannot open encoder %d: %s\n",
+                    ch->index, i, av_err2str(ret));
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+static int encode(Channel *ch, int rendition, AVFrame *frame)
+{
+    AVCodecContext *enc_ctx = ch->enc_ctx[rendition];
+    AVPacket pkt = { 0 };
+    int ret;
+
+    ret = avcodec_send_frame(enc_ctx, frame);
+    if (ret < 0)
+        return ret;
+
+    while (1) {
+        ret = avcodec_receive_packet(enc_ctx, &pkt);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+            return 0;
+        if (ret < 0)
+            return ret;
+        ret = channel_complete(ch, rendition, pkt.pts);
+        av_packet_unref(&pkt);
+        if (ret < 0)
+            return ret;
+    }
+}
+
+static int filter_frames(Channel *ch, AVFrame *frame)
+{
+    int i, ret;
+
+    for (i = 0; i < nb_renditions; i++) {
+        while ((ret = av_buffersink_get_frame(ch->sinks[i], frame)) >= 0) {
+            ret = encode(ch, i, frame);
+            av_frame_unref(frame);
+            if (ret < 0)
+                return ret;
+        }
+        if (ret != AVERROR(EAGAIN) && ret != AVERROR_EOF)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int decode_frames(Channel *ch, AVFrame *frame)
+{
+    int ret;
+
+    while (1) {
+        ret = avcodec_receive_frame(ch->dec_ctx, frame);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+            return 0;
+        if (ret < 0)
+            return ret;
+
+        /* the low_res sizes are only known once a frame is decoded */
+        if (!ch->graph) {
+            if ((ret = init_filters(ch, frame)) < 0 ||
+                (ret = open_encoders(ch)) < 0) {
+                av_frame_unref(frame);
+                return ret;
+            }
+        }
+
+        frame->pts = frame->best_effort_timestamp;
+        ret = av_buffersrc_add_frame(ch->src, frame);
+        if (ret < 0)
+            return ret;
+        ret = filter_frames(ch, frame);
+        if (ret < 0)
+            return ret;
+    }
+}
+
+static int channel_run(Channel *ch)
+{
+    AVPacket pkt = { 0 };
+    AVFrame *frame;
+    int i, ret = 0;
+
+    frame = av_frame_alloc();
+    if (!frame)
+        return AVERROR(ENOMEM);
+
+    while (!max_frames || ch->nb_packets < max_frames) {
+        ret = av_read_frame(ch->fmt_ctx, &pkt);
+        if (ret < 0)
+            break;
+        if (pkt.stream_index != ch->stream_index) {
+            av_packet_unref(&pkt);
+            continue;
+        }
+
+        channel_submit(ch, pkt.pts);
+        ch->nb_packets++;
+        ret = avcodec_send_packet(ch->dec_ctx, &pkt);
+        av_packet_unref(&pkt);
+        if (ret < 0)
+            goto end;
+        ret = decode_frames(ch, frame);
+        if (ret < 0)
+            goto end;
+    }
+
+    /* flush the decoder, the graph and the encoders */
+    ret = avcodec_send_packet(ch->dec_ctx, NULL);
+    if (ret < 0 || (ret = decode_frames(ch, frame)) < 0 || !ch->graph)
+        goto end;
+    ret = av_buffersrc_add_frame(ch->src, NULL);
+    if (ret < 0 || (ret = filter_frames(ch, frame)) < 0)
+        goto end;
+    for (i = 0; i < nb_renditions; i++) {
+        ret = encode(ch, i, NULL);
+        if (ret < 0)
+            goto end;
+    }
+
+end:
+    av_frame_free(&frame);
+    return ret;
+}
+
+static void *channel_thread(void *arg)
+{
+    Channel *ch = arg;
+    int64_t start, cpu_start;
+
+    pthread_barrier_wait(&start_barrier);
+
+    start     = av_gettime_relative();
+    cpu_start = channel_cpu_time();
+    ch->ret   = channel_run(ch);
+    ch->cpu_time = cpu_start < 0 ? -1 : channel_cpu_time() - cpu_start;
+    ch->elapsed  = av_gettime_relative() - start;
+    if (ch->ret < 0)
+        fprintf(stderr, "Channel %d failed: %s\n", ch->index,
+                av_err2str(ch->ret));
+
+    pthread_mutex_lock(&running_lock);
+    nb_running--;
+    pthread_mutex_unlock(&running_lock);
+
+    return NULL;
+}
+
+static void channel_free(Channel *ch)
+{
+    int i;
+
+    for (i = 0; i < MAX_RENDITIONS; i++)
+        avcodec_free_context(&ch->enc_ctx[i]);
+    avfilter_graph_free(&ch->graph);
+    avcodec_free_context(&ch->dec_ctx);
+    avformat_close_input(&ch->fmt_ctx);
+    for (i = 0; i < MAX_RENDITIONS; i++)
+        av_freep(&ch->latencies[i]);
+}
+
+static int cmp_int64(const void *a, const void *b)
+{
+    int64_t va = *(const int64_t *)a, vb = *(const int64_t *)b;
+
+    return (va > vb) - (va < vb);
+}
+
+static double percentile(const int64_t *sorted, int nb, int p)
+{
+    if (!nb)
+        return 0;
+    return sorted[FFMIN((int64_t)nb * p / 100, nb - 1)] / 1000.0;
+}
+
+static int parse_ladder(const char *ladder)
+{
+    const char *p = ladder;
+    char size[32];
+    int ret;
+
+    nb_renditions = 1;
+    while (*p) {
+        if (nb_renditions == MAX_RENDITIONS) {
+            fprintf(stderr, "At most %d renditions per ladder\n",
+                    MAX_RENDITIONS);
+            return AVERROR(EINVAL);
+        }
+        av_strlcpy(size, p, FFMIN(strcspn(p, ",") + 1, sizeof(size)));
+        ret = av_parse_video_size(&rendition_w[nb_renditions],
+                                  &rendition_h[nb_renditions], size);
+        if (ret < 0) {
+            fprintf(stderr, "Invalid rendition size '%s'\n", size);
+            return ret;
+        }
+        nb_renditions++;
+        p += strcspn(p, ",");
+        if (*p)
+            p++;
+    }
+
+    return 0;
+}
+
+static void print_latencies(int rendition, int64_t *latencies, int nb)
+{
+    qsort(latencies, nb, sizeof(*latencies), cmp_int64);
+    printf("    rendition %d %4dx%-4d: latency ms p50 %6.1f p90 %6.1f "
+           "p99 %6.1f max %6.1f\n", rendition, rendition_w[rendition],
+           rendition_h[rendition], percentile(latencies, nb, 50),
+           percentile(latencies, nb, 90), percentile(latencies, nb, 99),
+           percentile(latencies, nb, 100));
+}
+
+static void report(Channel *channels, int64_t elapsed, int64_t cpu_time,
+                   const AVVpeDeviceLoad *max_load, int nb_devices)
+{
+    AVVpeDeviceContext *device_hwctx =
+        ((AVHWDeviceContext *)hw_device_ctx->data)->hwctx;
+    int64_t *all = NULL, nb_frames = 0;
+    int64_t frame_bytes = 0;
+    int nb_all, i, j;
+
+    if (channels[0].dec_ctx) {
+        rendition_w[0] = channels[0].dec_ctx->width;
+        rendition_h[0] = channels[0].dec_ctx->height;
+    }
+
+    for (i = 0; i < nb_channels; i++) {
+        Channel *ch = &channels[i];
+
+        printf("  channel %2d: %6"PRId64" frames %7.1f fps", i, ch->nb_frames,
+               ch->nb_frames * 1000000.0 / FFMAX(ch->elapsed, 1));
+        if (ch->cpu_time >= 0)
+            printf(", cpu %5.1f%%", ch->cpu_time * 100.0 / FFMAX(ch->elapsed, 1));
+        printf("%s\n", ch->ret < 0 ? " (failed)" : "");
+        for (j = 0; j < nb_renditions; j++)
+            print_latencies(j, ch->latencies[j], ch->nb_latencies[j]);
+        nb_frames += ch->nb_frames;
+    }
+
+    printf("  aggregate : %6"PRId64" frames %7.1f fps\n", nb_frames,
+           nb_frames * 1000000.0 / FFMAX(elapsed, 1));
+    for (j = 0; j < nb_renditions; j++) {
+        nb_all = 0;
+        for (i = 0; i < nb_channels; i++)
+            nb_all += channels[i].nb_latencies[j];
+        all = nb_all ? av_malloc_array(nb_all, sizeof(*all)) : NULL;
+        if (!all)
+            continue;
+        nb_all = 0;
+        for (i = 0; i < nb_channels; i++) {
+            memcpy(all + nb_all, channels[i].latencies[j],
+                   channels[i].nb_latencies[j] * sizeof(*all));
+            nb_all += channels[i].nb_latencies[j];
+        }
+        print_latencies(j, all, nb_all);
+        av_free(all);
+    }
+    printf("  host cpu  : %.1f%% per channel, VPI threads included\n",
+           cpu_time * 100.0 / FFMAX(elapsed, 1) / nb_channels);
+
+    /* NV12 size of one frame of every rendition: the device may pad or
+       align the buffers, so the memory is only an estimate */
+    for (i = 0; i < nb_renditions; i++)
+        frame_bytes += rendition_w[i] * rendition_h[i] * 3 / 2;
+    for (i = 0; i < nb_devices; i++)
+        printf("  device %2d : max %d sessions, max %d frame buffers "
+               "(estimated ~%.1f MiB as NV12)\n", device_hwctx->devices[i],
+               max_load[i].nb_sessions, max_load[i].nb_frames,
+               max_load[i].nb_frames * frame_bytes / (1024.0 * 1024.0));
+}
+
+static int run(const char *ladder)
+{
+    AVHWDeviceContext *device_ctx = (AVHWDeviceContext *)hw_device_ctx->data;
+    AVVpeDeviceContext *device_hwctx = device_ctx->hwctx;
+    AVVpeDeviceLoad max_load[AV_VPE_MAX_DEVICES] = { { 0 } };
+    AVVpeDeviceLoad load;
+    Channel *channels;
+    int64_t start, elapsed, cpu_start;
+    int i, running, ret = 0;
+
+    ret = parse_ladder(ladder);
+    if (ret < 0)
+        return ret;
+    printf("ladder %s, perf_profile %s, %d channels, %d renditions\n",
+           *ladder ? ladder : "none", profile, nb_channels, nb_renditions);
+
+    channels = av_mallocz_array(nb_channels, sizeof(*channels));
+    if (!channels)
+        return AVERROR(ENOMEM);
+
+    for (i = 0; i < nb_channels; i++) {
+        channels[i].index = i;
+        ret = open_decoder(&channels[i]);
+        if (ret < 0) {
+            fprintf(stderr, "Channel %d: cannot open the input: %s\n", i,
+                    av_err2str(ret));
+            goto end;
+        }
+    }
+
+    pthread_barrier_init(&start_barrier, NULL, nb_channels + 1);
+    nb_running = nb_channels;
+    for (i = 0; i < nb_channels; i++) {
+        if (pthread_create(&channels[i].thread, NULL, channel_thread,
+                           &channels[i])) {
+            fprintf(stderr, "Cannot start channel %d\n", i);
+            exit(1);
+        }
+    }
+
+    pthread_barrier_wait(&start_barrier);
+    start     = av_gettime_relative();
+    cpu_start = thread_cpu_time(RUSAGE_SELF);
+
+    /* sample the device load while the channels run */
+    do {
+        for (i = 0; i < device_hwctx->nb_devices; i++) {
+            if (av_vpe_device_get_load(device_ctx, i, &load) < 0)
+                continue;
+            max_load[i].nb_sessions = FFMAX(max_load[i].nb_sessions,
+                                            load.nb_sessions);
+            max_load[i].nb_frames   = FFMAX(max_load[i].nb_frames,
+                                            load.nb_frames);
+        }
+        av_usleep(100000);
+        pthread_mutex_lock(&running_lock);
+        running = nb_running;
+        pthread_mutex_unlock(&running_lock);
+    } while (running);
+
+    for (i = 0; i < nb_channels; i++)
+        pthread_join(channels[i].thread, NULL);
+    elapsed = av_gettime_relative() - start;
+    pthread_barrier_destroy(&start_barrier);
+
+    report(channels, elapsed, thread_cpu_time(RUSAGE_SELF) - cpu_start,
+           max_load, device_hwctx->nb_devices);
+
+end:
+    for (i = 0; i < nb_channels; i++)
+        channel_free(&channels[i]);
+    av_free(channels);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    char *profile_list = NULL, *saveptr = NULL;
+    int opt, i, ret = 0;
+
+    while ((opt = getopt(argc, argv, "c:d:e:l:p:b:n:")) != -1) {
+        switch (opt) {
+        case 'c': nb_channels = atoi(optarg);    break;
+        case 'd': device      = optarg;          break;
+        case 'e': encoder     = optarg;          break;
+        case 'p': profiles    = optarg;          break;
+        case 'b': bitrate     = atoll(optarg);   break;
+        case 'n': max_frames  = atoi(optarg);    break;
+        case 'l':
+            if (nb_ladders < MAX_LADDERS)
+                ladders[nb_ladders++] = optarg;
+            break;
+        default:
+            optind = argc;
+            break;
+        }
+    }
+    if (optind != argc - 1 || nb_channels < 1 ||
+        nb_channels > MAX_CHANNELS || bitrate <= 0 || max_frames < 0) {
+        fprintf(stderr, "Usage: %s [-c channels] [-d device] [-e encoder] "
+                "[-l ladder]... [-p profiles] [-b bitrate] [-n frames] "
+                "<input file>\n", argv[0]);
+        return 1;
+    }
+    input_file = argv[optind];
+    if (!nb_ladders)
+        ladders[nb_ladders++] = "";
+
+    av_log_set_level(AV_LOG_ERROR);
+    ret = av_hwdevice_ctx_create(&hw_device_ctx, AV_HWDEVICE_TYPE_VPE, device,
+                                 NULL, 0);
+    if (ret < 0) {
+        fprintf(stderr, "Failed to open the VPE device %s\n", device);
+        return 1;
+    }
+
+    for (i = 0; i < nb_ladders && ret >= 0; i++) {
+        av_freep(&profile_list);
+        profile_list = av_strdup(profiles);
+        if (!profile_list) {
+            ret = AVERROR(ENOMEM);
+            break;
+        }
+        for (profile = av_strtok(profile_list, ",", &saveptr);
+             profile && ret >= 0;
+             profile = av_strtok(NULL, ",", &saveptr))
+            ret = run(ladders[i]);
+    }
+
+    av_free(profile_list);
+    av_buffer_unref(&hw_device_ctx);
+    return ret < 0;
+}
@@ -45,6 +45,7 @@ struct timeval *out_time = NULL;
 #endif
 
 static const int avloglevel = AV_LOG_INFO;
+/* a device path, a ':' separated list of them or "auto" */
 static const char *device   = "/dev/transcoder0";
 static char *enc_codec;
 static char *output_file;
@@ -452,9 +453,12 @@ int main(int argc, char **argv)
 
     if (argc <= 2) {
         av_log(NULL, AV_LOG_ERROR,
-               "Usage: %s <input file> <codec name> <output file>\n", argv[0]);
+               "Usage: %s <input file> <codec name> <output file> [device]\n",
+               argv[0]);
         return 1;
     }
+    if (argc > 4)
+        device = argv[4];
     ret = init_vpe_device();
     if (ret < 0) {
         av_log(NULL, AV_LOG_ERROR, "Failed to init a VPE device\n");
@@ -0,0 +1,233 @@
+/*
+ * Verisilicon sample measuring VPE hwupload/hwdownload throughput.
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * VPE transfer benchmark.
+ *
+ * @example vpe_transfer.c
+ * Upload and download NV12 frames between the host and a VPE device with
+ * av_hwframe_transfer_data() and report the achieved GB/s, for a given
+ * number of in-flight uploads (AVVpeFramesContext.transfer_depth).
+ *
+ * Usage: vpe_transfer <device> <width> <height> <frames> [transfer_depth]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libavutil/hwcontext.h>
+#include <libavutil/hwcontext_vpe.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/time.h>
+
+/* hw frames uploaded to in a round robin, more than any transfer_depth */
+#define NB_HW_FRAMES 32
+
+static int width, height, nb_frames;
+
+static AVBufferRef *create_frames_ctx(AVBufferRef *device_ctx, int depth)
+{
+    AVBufferRef *frames_ref;
+    AVHWFramesContext *frames_ctx;
+    AVVpeFramesContext *vpe_frames_ctx;
+
+    frames_ref = av_hwframe_ctx_alloc(device_ctx);
+    if (!frames_ref)
+        return NULL;
+    frames_ctx     = (AVHWFramesContext *)frames_ref->data;
+    vpe_frames_ctx = frames_ctx->hwctx;
+
+    frames_ctx->format             = AV_PIX_FMT_VPE;
+    frames_ctx->sw_format          = AV_PIX_FMT_NV12;
+    frames_ctx->width              = width;
+    frames_ctx->height             = height;
+    vpe_frames_ctx->transfer_depth = depth;
+
+    if (av_hwframe_ctx_init(frames_ref) < 0) {
+        fprintf(stderr, "Failed to initialize the VPE frames context\n");
+        av_buffer_unref(&frames_ref);
+    }
+    return frames_ref;
+}
+
+static AVFrame *alloc_sw_frame(void)
+{
+    AVFrame *frame = av_frame_alloc();
+    int i;
+
+    if (!frame)
+        return NULL;
+    frame->format = AV_PIX_FMT_NV12;
+    frame->width  = width;
+    frame->height = height;
+    if (av_frame_get_buffer(frame, 0) < 0) {
+        av_frame_free(&frame);
+        return NULL;
+    }
+
+    /* a gradient, so the device does not see constant pages */
+    for (i = 0; i < height; i++)
+        memset(frame->data[0] + i * frame->linesize[0], i & 0xff, width);
+    for (i = 0; i < height / 2; i++)
+        memset(frame->data[1] + i * frame->linesize[1], 0x80, width);
+
+    return frame;
+}
+
+static void report(const char *name, int64_t elapsed)
+{
+    double bytes = (double)av_image_get_buffer_size(AV_PIX_FMT_NV12, width,
+                                                    height, 1) * nb_frames;
+
+    printf("%-8s %d frames %dx%d: %.3f s, %.1f fps, %.3f GB/s\n", name,
+           nb_frames, width, height, elapsed / 1000000.0,
+           nb_frames * 1000000.0 / FFMAX(elapsed, 1),
+           bytes / FFMAX(elapsed, 1) / 1000.0);
+}
+
+static int bench_upload(AVBufferRef *device_ctx, int depth, AVFrame *sw_frame)
+{
+    AVFrame *hw_frames[NB_HW_FRAMES] = { NULL };
+    AVBufferRef *frames_ref;
+    int64_t start;
+    int i, ret = 0;
+
+    frames_ref = create_frames_ctx(device_ctx, depth);
+    if (!frames_ref)
+        return AVERROR(ENOMEM);
+
+    start = av_gettime_relative();
+    for (i = 0; i < nb_frames; i++) {
+        AVFrame **hw_frame = &hw_frames[i % NB_HW_FRAMES];
+
+        av_frame_free(hw_frame);
+        *hw_frame = av_frame_alloc();
+        if (!*hw_frame) {
+            ret = AVERROR(ENOMEM);
+            break;
+        }
+        ret = av_hwframe_get_buffer(frames_ref, *hw_frame, 0);
+        if (ret < 0)
+            break;
+        ret = av_hwframe_transfer_data(*hw_frame, sw_frame, 0);
+        if (ret < 0)
+            break;
+    }
+
+    /* freeing the frames context waits for the uploads still in flight */
+    for (i = 0; i < NB_HW_FRAMES; i++)
+        av_frame_free(&hw_frames[i]);
+    av_buffer_unref(&frames_ref);
+
+    if (ret < 0) {
+        fprintf(stderr, "Upload failed: %s\n", av_err2str(ret));
+        return ret;
+    }
+    report("upload", av_gettime_relative() - start);
+
+    return 0;
+}
+
+static int bench_download(AVBufferRef *device_ctx, AVFrame *sw_frame)
+{
+    AVBufferRef *frames_ref;
+    AVFrame *hw_frame;
+    int64_t start;
+    int i, ret;
+
+    frames_ref = create_frames_ctx(device_ctx, 0);
+    hw_frame   = av_frame_alloc();
+    if (!frames_ref || !hw_frame) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+
+    ret = av_hwframe_get_buffer(frames_ref, hw_frame, 0);
+    if (ret < 0)
+        goto end;
+    ret = av_hwframe_transfer_data(hw_frame, sw_frame, 0);
+    if (ret < 0)
+        goto end;
+
+    start = av_gettime_relative();
+    for (i = 0; i < nb_frames; i++) {
+        ret = av_hwframe_transfer_data(sw_frame, hw_frame, 0);
+        if (ret < 0)
+            goto end;
+    }
+    report("download", av_gettime_relative() - start);
+
+end:
+    if (ret < 0)
+        fprintf(stderr, "Download failed: %s\n", av_err2str(ret));
+    av_frame_free(&hw_frame);
+    av_buffer_unref(&frames_ref);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    AVBufferRef *device_ctx = NULL;
+    AVFrame *sw_frame       = NULL;
+    int depth = 0;
+    int ret;
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <device> <width> <height> <frames> "
+                "[transfer_depth]\n", argv[0]);
+        return 1;
+    }
+    width     = atoi(argv[2]);
+    height    = atoi(argv[3]);
+    nb_frames = atoi(argv[4]);
+    if (argc > 5)
+        depth = atoi(argv[5]);
+    if (width <= 0 || height <= 0 || nb_frames <= 0 || depth < 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 1;
+    }
+
+    ret = av_hwdevice_ctx_create(&device_ctx, AV_HWDEVICE_TYPE_VPE, argv[1],
+                                 NULL, 0);
+    if (ret < 0) {
+        fprintf(stderr, "Failed to open the VPE device %s\n", argv[1]);
+        return 1;
+    }
+
+    sw_frame = alloc_sw_frame();
+    if (!sw_frame) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+
+    printf("transfer_depth %d\n", depth);
+    ret = bench_upload(device_ctx, depth, sw_frame);
+    if (ret < 0)
+        goto end;
+    ret = bench_download(device_ctx, sw_frame);
+
+end:
+    av_frame_free(&sw_frame);
+    av_buffer_unref(&device_ctx);
+    return ret < 0;
+}
@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <limits.h>
+#include <setjmp.h>
 #include <stdatomic.h>
 #include <stdint.h>
 
@@ -90,6 +91,11 @@
 #include <sys/select.h>
 #endif
 
+#if HAVE_FORK
+#include <sys/socket.h>
+#include <sys/wait.h>
+#endif
+
 #if HAVE_TERMIOS_H
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -130,6 +136,11 @@ static void do_video_stats(OutputStream *ost, int frame_size);
 static BenchmarkTimeStamps get_benchmark_time_stamps(void);
 static int64_t getmaxrss(void);
 static int ifilter_has_all_input_formats(FilterGraph *fg);
+#if HAVE_THREADS
+static void free_encoder_thread(OutputStream *ost);
+static void free_decoder_thread(InputStream *ist);
+#endif
+static int reap_filters(int flush);
 
 static int run_as_daemon  = 0;
 static int nb_frames_dup = 0;
@@ -141,6 +152,10 @@ static int want_sdp = 1;
 
 static BenchmarkTimeStamps current_time;
 AVIOContext *progress_avio = NULL;
+AVIOContext *benchmark_report_avio = NULL;
+static int64_t report_last_time = -1;
+static int qp_histogram[52];
+static int64_t benchmark_report_last_time = -1;
 
 static uint8_t *subtitle_out;
 
@@ -219,6 +234,39 @@ static void sub2video_copy_rect(uint8_t *dst, int dst_linesize, int w, int h,
     }
 }
 
+#if HAVE_THREADS
+/* queue a frame, or EOF if frame is NULL, to a threaded filtergraph,
+ * encoding its output while the queue is full */
+static int ifilter_send_threaded(InputFilter *ifilter, AVFrame *frame, int64_t eof_pts)
+{
+    int ret;
+
+    while ((ret = ifilter_thread_send(ifilter, frame, eof_pts)) == AVERROR(EAGAIN)) {
+        ret = reap_filters(0);
+        if (ret < 0)
+            return ret;
+        ret = filtergraph_thread_wait(ifilter->graph, 1);
+        if (ret < 0 && ret != AVERROR(EAGAIN) && ret != AVERROR_EOF)
+            return ret;
+    }
+    return ret;
+}
+
+/* wait until the filtering thread of fg has run out of work, encoding its
+ * output meanwhile */
+static int sync_filtergraph_thread(FilterGraph *fg)
+{
+    int ret;
+
+    while ((ret = filtergraph_thread_wait(fg, 0)) >= 0) {
+        ret = reap_filters(0);
+        if (ret < 0)
+            return ret;
+    }
+    return ret == AVERROR(EAGAIN) || ret == AVERROR_EOF ? 0 : ret;
+}
+#endif
+
 static void sub2video_push_ref(InputStream *ist, int64_t pts)
 {
     AVFrame *frame = ist->sub2video.frame;
@@ -228,6 +276,11 @@ static void sub2video_push_ref(InputStream *ist, int64_t pts)
     av_assert1(frame->data[0]);
     ist->sub2video.last_pts = frame->pts = pts;
     for (i = 0; i < ist->nb_filters; i++) {
+#if HAVE_THREADS
+        if (ist->filters[i]->graph->thread_started)
+            ret = ifilter_send_threaded(ist->filters[i], frame, AV_NOPTS_VALUE);
+        else
+#endif
         ret = av_buffersrc_add_frame_flags(ist->filters[i]->filter, frame,
                                            AV_BUFFERSRC_FLAG_KEEP_REF |
                                            AV_BUFFERSRC_FLAG_PUSH);
@@ -295,7 +348,7 @@ static void sub2video_heartbeat(InputStream *ist, int64_t pts)
             (!ist2->sub2video.frame->data[0] && ist2->sub2video.end_pts < INT64_MAX))
             sub2video_update(ist2, NULL);
         for (j = 0, nb_reqs = 0; j < ist2->nb_filters; j++)
-            nb_reqs += av_buffersrc_get_nb_failed_requests(ist2->filters[j]->filter);
+            nb_reqs += ifilter_get_nb_failed_requests(ist2->filters[j]);
         if (nb_reqs)
             sub2video_push_ref(ist2, pts2);
     }
@@ -309,6 +362,11 @@ static void sub2video_flush(InputStream *ist)
     if (ist->sub2video.end_pts < INT64_MAX)
         sub2video_update(ist, NULL);
     for (i = 0; i < ist->nb_filters; i++) {
+#if HAVE_THREADS
+        if (ist->filters[i]->graph->thread_started)
+            ret = ifilter_send_threaded(ist->filters[i], NULL, AV_NOPTS_VALUE);
+        else
+#endif
         ret = av_buffersrc_add_frame(ist->filters[i]->filter, NULL);
         if (ret != AVERROR_EOF && ret < 0)
             av_log(NULL, AV_LOG_WARNING, "Flush the frame error.\n");
@@ -337,6 +395,11 @@ static atomic_int transcode_init_done = ATOMIC_VAR_INIT(0);
 static volatile int ffmpeg_exited = 0;
 static int main_return_code = 0;
 
+/* a job of -batch is running, exit_program() returns to run_batch() */
+static int batch_job_running;
+static jmp_buf batch_job_env;
+static int batch_job_ret;
+
 static void
 sigterm_handler(int sig)
 {
@@ -491,6 +554,9 @@ static void ffmpeg_cleanup(int ret)
 
     for (i = 0; i < nb_filtergraphs; i++) {
         FilterGraph *fg = filtergraphs[i];
+#if HAVE_THREADS
+        filtergraph_thread_stop(fg);
+#endif
         avfilter_graph_free(&fg->graph);
         for (j = 0; j < fg->nb_inputs; j++) {
             while (av_fifo_size(fg->inputs[j]->frame_queue)) {
@@ -550,6 +616,10 @@ static void ffmpeg_cleanup(int ret)
         if (!ost)
             continue;
 
+#if HAVE_THREADS
+        free_encoder_thread(ost);
+#endif
+
         for (j = 0; j < ost->nb_bitstream_filters; j++)
             av_bsf_free(&ost->bsf_ctx[j]);
         av_freep(&ost->bsf_ctx);
@@ -601,6 +671,9 @@ static void ffmpeg_cleanup(int ret)
         av_freep(&ist->hwaccel_device);
         av_freep(&ist->dts_buffer);
 
+#if HAVE_THREADS
+        free_decoder_thread(ist);
+#endif
         avcodec_free_context(&ist->dec_ctx);
 
         av_freep(&input_streams[i]);
@@ -613,6 +686,9 @@ static void ffmpeg_cleanup(int ret)
                    av_err2str(AVERROR(errno)));
     }
     av_freep(&vstats_filename);
+    /* only closed by the last report when the transcoding completed */
+    if (!batch_job_running)
+        avio_closep(&benchmark_report_avio);
 
     av_freep(&input_streams);
     av_freep(&input_files);
@@ -677,6 +753,35 @@ static void update_benchmark(const char *fmt, ...)
     }
 }
 
+static int64_t get_thread_cpu_usec(void)
+{
+#if HAVE_CLOCK_GETTIME && defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+
+    if (!clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts))
+        return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+#endif
+    return 0;
+}
+
+void benchmark_stage_start(BenchmarkStage *s)
+{
+    if (!do_benchmark_report)
+        return;
+    s->start_real_usec = av_gettime_relative();
+    s->start_cpu_usec  = get_thread_cpu_usec();
+}
+
+void benchmark_stage_stop(BenchmarkStage *s)
+{
+    if (!do_benchmark_report)
+        return;
+    atomic_fetch_add_explicit(&s->real_usec, av_gettime_relative() - s->start_real_usec,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&s->cpu_usec, get_thread_cpu_usec() - s->start_cpu_usec,
+                              memory_order_relaxed);
+}
+
 static void close_all_output_streams(OutputStream *ost, OSTFinished this_stream, OSTFinished others)
 {
     int i;
@@ -812,7 +917,9 @@ static void write_packet(OutputFile *of, AVPacket *pkt, OutputStream *ost, int u
               );
     }
 
+    benchmark_stage_start(&ost->bench_mux);
     ret = av_interleaved_write_frame(s, pkt);
+    benchmark_stage_stop(&ost->bench_mux);
     if (ret < 0) {
         print_error("av_interleaved_write_frame()", ret);
         main_return_code = 1;
@@ -907,6 +1014,245 @@ static int check_recording_time(OutputStream *ost)
     return 1;
 }
 
+static int encode_send_frame(OutputStream *ost, const AVFrame *frame)
+{
+    int ret;
+
+    benchmark_stage_start(&ost->bench_encode);
+    ret = avcodec_send_frame(ost->enc_ctx, frame);
+    benchmark_stage_stop(&ost->bench_encode);
+    return ret;
+}
+
+static int encode_receive_packet(OutputStream *ost, AVPacket *pkt)
+{
+    int ret;
+
+    benchmark_stage_start(&ost->bench_encode);
+    ret = avcodec_receive_packet(ost->enc_ctx, pkt);
+    benchmark_stage_stop(&ost->bench_encode);
+    return ret;
+}
+
+#if HAVE_THREADS
+static void free_enc_frame(void *msg)
+{
+    av_frame_free((AVFrame **)msg);
+}
+
+static void *encoder_thread(void *arg)
+{
+    OutputStream *ost   = arg;
+    AVCodecContext *enc = ost->enc_ctx;
+    AVFrame *frame = NULL;
+    AVPacket pkt;
+    int ret, frame_pending;
+
+    while (1) {
+        ret = av_thread_message_queue_recv(ost->enc_frame_queue, &frame, 0);
+        if (ret < 0)
+            break;
+
+        /* enc is owned by this thread, reap_filters() leaves the SAR on the frame */
+        if (frame && enc->codec_type == AVMEDIA_TYPE_VIDEO && !ost->frame_aspect_ratio.num)
+            enc->sample_aspect_ratio = frame->sample_aspect_ratio;
+
+        ret = encode_send_frame(ost, frame);
+        if (ret < 0 && ret != AVERROR(EAGAIN))
+            break;
+        frame_pending = ret == AVERROR(EAGAIN);
+
+        while (1) {
+            av_init_packet(&pkt);
+            pkt.data = NULL;
+            pkt.size = 0;
+
+            ret = encode_receive_packet(ost, &pkt);
+            if (ret == AVERROR(EAGAIN)) {
+                if (!frame_pending)
+                    break;
+                ret = encode_send_frame(ost, frame);
+                if (ret < 0 && ret != AVERROR(EAGAIN))
+                    break;
+                frame_pending = ret == AVERROR(EAGAIN);
+                continue;
+            }
+            if (ret < 0)
+                break;
+
+            if (enc->codec_type == AVMEDIA_TYPE_VIDEO && frame &&
+                pkt.pts == AV_NOPTS_VALUE && !(enc->codec->capabilities & AV_CODEC_CAP_DELAY))
+                pkt.pts = frame->pts;
+
+            pthread_mutex_lock(&ost->enc_lock);
+            if (av_fifo_space(ost->enc_packet_queue) < sizeof(pkt))
+                ret = av_fifo_grow(ost->enc_packet_queue,
+                                   av_fifo_size(ost->enc_packet_queue) + sizeof(pkt));
+            if (ret >= 0)
+                av_fifo_generic_write(ost->enc_packet_queue, &pkt, sizeof(pkt), NULL);
+            pthread_cond_signal(&ost->enc_cond);
+            pthread_mutex_unlock(&ost->enc_lock);
+            if (ret < 0) {
+                av_packet_unref(&pkt);
+                break;
+            }
+        }
+        if (!frame)
+            break;
+        av_frame_free(&frame);
+        if (ret < 0 && ret != AVERROR(EAGAIN))
+            break;
+    }
+    av_frame_free(&frame);
+
+    /* AVERROR_EOF once a NULL frame flushed the encoder */
+    pthread_mutex_lock(&ost->enc_lock);
+    ost->enc_thread_ret = ret;
+    pthread_cond_signal(&ost->enc_cond);
+    pthread_mutex_unlock(&ost->enc_lock);
+    av_thread_message_queue_set_err_send(ost->enc_frame_queue, ost->enc_thread_ret);
+
+    return NULL;
+}
+
+static int init_encoder_thread(OutputStream *ost)
+{
+    int ret;
+
+    if (ost->enc_queue_size <= 0 ||
+        (ost->enc_ctx->codec_type != AVMEDIA_TYPE_VIDEO &&
+         ost->enc_ctx->codec_type != AVMEDIA_TYPE_AUDIO))
+        return 0;
+    /* stats_out is read after every packet */
+    if (ost->enc_ctx->flags & (AV_CODEC_FLAG_PASS1 | AV_CODEC_FLAG_PASS2)) {
+        av_log(NULL, AV_LOG_WARNING, "Two-pass encoding of output stream %d:%d "
+               "is done in the main thread, ignoring enc_queue_size\n",
+               ost->file_index, ost->index);
+        return 0;
+    }
+
+    ret = av_thread_message_queue_alloc(&ost->enc_frame_queue,
+                                        ost->enc_queue_size, sizeof(AVFrame *));
+    if (ret < 0)
+        return ret;
+    av_thread_message_queue_set_free_func(ost->enc_frame_queue, free_enc_frame);
+
+    ost->enc_packet_queue = av_fifo_alloc(8 * sizeof(AVPacket));
+    if (!ost->enc_packet_queue) {
+        av_thread_message_queue_free(&ost->enc_frame_queue);
+        return AVERROR(ENOMEM);
+    }
+    pthread_mutex_init(&ost->enc_lock, NULL);
+    pthread_cond_init(&ost->enc_cond, NULL);
+    ost->enc_thread_ret = 0;
+
+    if ((ret = pthread_create(&ost->enc_thread, NULL, encoder_thread, ost))) {
+        av_log(NULL, AV_LOG_ERROR, "pthread_create failed: %s. Try to increase `ulimit -v` or decrease `ulimit -s`.\n", strerror(ret));
+        pthread_cond_destroy(&ost->enc_cond);
+        pthread_mutex_destroy(&ost->enc_lock);
+        av_fifo_freep(&ost->enc_packet_queue);
+        av_thread_message_queue_free(&ost->enc_frame_queue);
+        return AVERROR(ret);
+    }
+    ost->enc_thread_started = 1;
+
+    return 0;
+}
+
+static void free_encoder_thread(OutputStream *ost)
+{
+    AVPacket pkt;
+
+    if (!ost->enc_thread_started)
+        return;
+
+    /* drop the queued frames and stop the thread at its next recv() */
+    av_thread_message_queue_set_err_recv(ost->enc_frame_queue, AVERROR_EXIT);
+    av_thread_message_flush(ost->enc_frame_queue);
+    pthread_join(ost->enc_thread, NULL);
+    ost->enc_thread_started = 0;
+
+    while (av_fifo_size(ost->enc_packet_queue)) {
+        av_fifo_generic_read(ost->enc_packet_queue, &pkt, sizeof(pkt), NULL);
+        av_packet_unref(&pkt);
+    }
+    av_fifo_freep(&ost->enc_packet_queue);
+    av_thread_message_queue_free(&ost->enc_frame_queue);
+    pthread_cond_destroy(&ost->enc_cond);
+    pthread_mutex_destroy(&ost->enc_lock);
+}
+
+/**
+ * Mux the packets returned by the encoder thread so far.
+ *
+ * @param flush wait until the encoder is flushed and all its packets are muxed
+ */
+static void reap_encoder_thread(OutputFile *of, OutputStream *ost, int flush)
+{
+    AVCodecContext *enc = ost->enc_ctx;
+    const char *desc = enc->codec_type == AVMEDIA_TYPE_VIDEO ? "video" : "audio";
+    AVPacket pkt;
+    int ret, got_packet, pkt_size;
+
+    while (1) {
+        got_packet = 0;
+        pthread_mutex_lock(&ost->enc_lock);
+        while (flush && !ost->enc_thread_ret && !av_fifo_size(ost->enc_packet_queue))
+            pthread_cond_wait(&ost->enc_cond, &ost->enc_lock);
+        if (av_fifo_size(ost->enc_packet_queue)) {
+            av_fifo_generic_read(ost->enc_packet_queue, &pkt, sizeof(pkt), NULL);
+            got_packet = 1;
+        }
+        ret = ost->enc_thread_ret;
+        pthread_mutex_unlock(&ost->enc_lock);
+
+        if (!got_packet) {
+            if (ret < 0 && ret != AVERROR_EOF) {
+                av_log(NULL, AV_LOG_FATAL, "%s encoding failed: %s\n",
+                       desc, av_err2str(ret));
+                exit_program(1);
+            }
+            return;
+        }
+
+        if (flush && (ost->finished & MUXER_FINISHED)) {
+            av_packet_unref(&pkt);
+            continue;
+        }
+        av_packet_rescale_ts(&pkt, enc->time_base, ost->mux_timebase);
+        if (debug_ts) {
+            av_log(NULL, AV_LOG_INFO, "encoder -> type:%s "
+                   "pkt_pts:%s pkt_pts_time:%s pkt_dts:%s pkt_dts_time:%s\n", desc,
+                   av_ts2str(pkt.pts), av_ts2timestr(pkt.pts, &ost->mux_timebase),
+                   av_ts2str(pkt.dts), av_ts2timestr(pkt.dts, &ost->mux_timebase));
+        }
+        pkt_size = pkt.size;
+        output_packet(of, &pkt, ost, 0);
+        if (enc->codec_type == AVMEDIA_TYPE_VIDEO && vstats_filename)
+            do_video_stats(ost, pkt_size);
+    }
+}
+
+static void send_encoder_thread(OutputStream *ost, AVFrame *frame)
+{
+    AVFrame *clone = NULL;
+    int ret;
+
+    if (frame && !(clone = av_frame_clone(frame))) {
+        av_log(NULL, AV_LOG_FATAL, "Error cloning a frame for the encoder thread\n");
+        exit_program(1);
+    }
+    ret = av_thread_message_queue_send(ost->enc_frame_queue, &clone, 0);
+    if (ret < 0) {
+        av_frame_free(&clone);
+        av_log(NULL, AV_LOG_FATAL, "%s encoding failed: %s\n",
+               ost->enc_ctx->codec_type == AVMEDIA_TYPE_VIDEO ? "video" : "audio",
+               av_err2str(ret));
+        exit_program(1);
+    }
+}
+#endif
+
 static void do_audio_out(OutputFile *of, OutputStream *ost,
                          AVFrame *frame)
 {
@@ -936,12 +1282,21 @@ static void do_audio_out(OutputFile *of, OutputStream *ost,
                enc->time_base.num, enc->time_base.den);
     }
 
-    ret = avcodec_send_frame(enc, frame);
+#if HAVE_THREADS
+    if (ost->enc_thread_started) {
+        send_encoder_thread(ost, frame);
+        reap_encoder_thread(of, ost, 0);
+        update_benchmark("encode_audio %d.%d", ost->file_index, ost->index);
+        return;
+    }
+#endif
+
+    ret = encode_send_frame(ost, frame);
     if (ret < 0)
         goto error;
 
     while (1) {
-        ret = avcodec_receive_packet(enc, &pkt);
+        ret = encode_receive_packet(ost, &pkt);
         if (ret == AVERROR(EAGAIN))
             break;
         if (ret < 0)
@@ -1023,8 +1378,10 @@ static void do_subtitle_out(OutputFile *of,
 
         ost->frames_encoded++;
 
+        benchmark_stage_start(&ost->bench_encode);
         subtitle_out_size = avcodec_encode_subtitle(enc, subtitle_out,
                                                     subtitle_out_max_size, sub);
+        benchmark_stage_stop(&ost->bench_encode);
         if (i == 1)
             sub->num_rects = save_num_rects;
         if (subtitle_out_size < 0) {
@@ -1064,6 +1421,7 @@ static void do_video_out(OutputFile *of,
     double delta, delta0;
     double duration = 0;
     int frame_size = 0;
+    int frame_pending;
     InputStream *ist = NULL;
     AVFilterContext *filter = ost->filter->filter;
 
@@ -1175,6 +1533,7 @@ static void do_video_out(OutputFile *of,
 
     if (nb0_frames == 0 && ost->last_dropped) {
         nb_frames_drop++;
+        ost->frames_dropped++;
         av_log(NULL, AV_LOG_VERBOSE,
                "*** dropping frame %d from stream %d at ts %"PRId64"\n",
                ost->frame_number, ost->st->index, ost->last_frame->pts);
@@ -1183,9 +1542,11 @@ static void do_video_out(OutputFile *of,
         if (nb_frames > dts_error_threshold * 30) {
             av_log(NULL, AV_LOG_ERROR, "%d frame duplication too large, skipping\n", nb_frames - 1);
             nb_frames_drop++;
+            ost->frames_dropped++;
             return;
         }
         nb_frames_dup += nb_frames - (nb0_frames && ost->last_dropped) - (nb_frames > nb0_frames);
+        ost->frames_duplicated += nb_frames - (nb0_frames && ost->last_dropped) - (nb_frames > nb0_frames);
         av_log(NULL, AV_LOG_VERBOSE, "*** %d dup!\n", nb_frames - 1);
         if (nb_frames_dup > dup_warning) {
             av_log(NULL, AV_LOG_WARNING, "More than %d frames duplicated\n", dup_warning);
@@ -1284,47 +1645,65 @@ static void do_video_out(OutputFile *of,
 
         ost->frames_encoded++;
 
-        ret = avcodec_send_frame(enc, in_picture);
-        if (ret < 0)
-            goto error;
-        // Make sure Closed Captions will not be duplicated
-        av_frame_remove_side_data(in_picture, AV_FRAME_DATA_A53_CC);
-
-        while (1) {
-            ret = avcodec_receive_packet(enc, &pkt);
+#if HAVE_THREADS
+        if (ost->enc_thread_started) {
+            send_encoder_thread(ost, in_picture);
+            reap_encoder_thread(of, ost, 0);
             update_benchmark("encode_video %d.%d", ost->file_index, ost->index);
-            if (ret == AVERROR(EAGAIN))
-                break;
-            if (ret < 0)
+        } else
+#endif
+        {
+            ret = encode_send_frame(ost, in_picture);
+            if (ret < 0 && ret != AVERROR(EAGAIN))
                 goto error;
+            frame_pending = ret == AVERROR(EAGAIN);
+
+            while (1) {
+                ret = encode_receive_packet(ost, &pkt);
+                update_benchmark("encode_video %d.%d", ost->file_index, ost->index);
+                if (ret == AVERROR(EAGAIN)) {
+                    if (!frame_pending)
+                        break;
+                    /* the encoder was full, retry now that output was drained */
+                    ret = encode_send_frame(ost, in_picture);
+                    if (ret < 0 && ret != AVERROR(EAGAIN))
+                        goto error;
+                    frame_pending = ret == AVERROR(EAGAIN);
+                    continue;
+                }
+                if (ret < 0)
+                    goto error;
 
-            if (debug_ts) {
-                av_log(NULL, AV_LOG_INFO, "encoder -> type:video "
-                       "pkt_pts:%s pkt_pts_time:%s pkt_dts:%s pkt_dts_time:%s\n",
-                       av_ts2str(pkt.pts), av_ts2timestr(pkt.pts, &enc->time_base),
-                       av_ts2str(pkt.dts), av_ts2timestr(pkt.dts, &enc->time_base));
-            }
+                if (debug_ts) {
+                    av_log(NULL, AV_LOG_INFO, "encoder -> type:video "
+                           "pkt_pts:%s pkt_pts_time:%s pkt_dts:%s pkt_dts_time:%s\n",
+                           av_ts2str(pkt.pts), av_ts2timestr(pkt.pts, &enc->time_base),
+                           av_ts2str(pkt.dts), av_ts2timestr(pkt.dts, &enc->time_base));
+                }
 
-            if (pkt.pts == AV_NOPTS_VALUE && !(enc->codec->capabilities & AV_CODEC_CAP_DELAY))
-                pkt.pts = ost->sync_opts;
+                if (pkt.pts == AV_NOPTS_VALUE && !(enc->codec->capabilities & AV_CODEC_CAP_DELAY))
+                    pkt.pts = ost->sync_opts;
 
-            av_packet_rescale_ts(&pkt, enc->time_base, ost->mux_timebase);
+                av_packet_rescale_ts(&pkt, enc->time_base, ost->mux_timebase);
 
-            if (debug_ts) {
-                av_log(NULL, AV_LOG_INFO, "encoder -> type:video "
-                    "pkt_pts:%s pkt_pts_time:%s pkt_dts:%s pkt_dts_time:%s\n",
-                    av_ts2str(pkt.pts), av_ts2timestr(pkt.pts, &ost->mux_timebase),
-                    av_ts2str(pkt.dts), av_ts2timestr(pkt.dts, &ost->mux_timebase));
-            }
+                if (debug_ts) {
+                    av_log(NULL, AV_LOG_INFO, "encoder -> type:video "
+                        "pkt_pts:%s pkt_pts_time:%s pkt_dts:%s pkt_dts_time:%s\n",
+                        av_ts2str(pkt.pts), av_ts2timestr(pkt.pts, &ost->mux_timebase),
+                        av_ts2str(pkt.dts), av_ts2timestr(pkt.dts, &ost->mux_timebase));
+                }
 
-            frame_size = pkt.size;
-            output_packet(of, &pkt, ost, 0);
+                frame_size = pkt.size;
+                output_packet(of, &pkt, ost, 0);
 
-            /* if two pass, output log */
-            if (ost->logfile && enc->stats_out) {
-                fprintf(ost->logfile, "%s", enc->stats_out);
+                /* if two pass, output log */
+                if (ost->logfile && enc->stats_out) {
+                    fprintf(ost->logfile, "%s", enc->stats_out);
+                }
             }
         }
+        // Make sure Closed Captions will not be duplicated
+        av_frame_remove_side_data(in_picture, AV_FRAME_DATA_A53_CC);
         ost->sync_opts++;
         /*
          * For video, number of frames in == number of packets out.
@@ -1433,6 +1812,11 @@ static int reap_filters(int flush)
         AVCodecContext *enc = ost->enc_ctx;
         int ret = 0;
 
+#if HAVE_THREADS
+        if (ost->enc_thread_started)
+            reap_encoder_thread(of, ost, 0);
+#endif
+
         if (!ost->filter || !ost->filter->graph->graph)
             continue;
         filter = ost->filter->filter;
@@ -1454,6 +1838,11 @@ static int reap_filters(int flush)
 
         while (1) {
             double float_pts = AV_NOPTS_VALUE; // this is identical to filtered_frame.pts but with higher precision
+#if HAVE_THREADS
+            if (ost->filter->graph->thread_started)
+                ret = ofilter_thread_get_frame(ost->filter, filtered_frame);
+            else
+#endif
             ret = av_buffersink_get_frame_flags(filter, filtered_frame,
                                                AV_BUFFERSINK_FLAG_NO_REQUEST);
             if (ret < 0) {
@@ -1491,7 +1880,11 @@ static int reap_filters(int flush)
 
             switch (av_buffersink_get_type(filter)) {
             case AVMEDIA_TYPE_VIDEO:
-                if (!ost->frame_aspect_ratio.num)
+                if (!ost->frame_aspect_ratio.num
+#if HAVE_THREADS
+                    && !ost->enc_thread_started
+#endif
+                    )
                     enc->sample_aspect_ratio = filtered_frame->sample_aspect_ratio;
 
                 if (debug_ts) {
@@ -1641,6 +2034,38 @@ static void print_final_stats(int64_t total_size)
     }
 }
 
+#if HAVE_THREADS
+/* fill level of the decoder and encoder queues */
+static void print_queue_report(AVBPrint *buf, AVBPrint *buf_script)
+{
+    const char *sep = " queue=";
+    int i;
+
+    for (i = 0; i < nb_input_streams; i++) {
+        InputStream *ist = input_streams[i];
+        int nb;
+        if (!ist->dec_thread_started)
+            continue;
+        nb = av_thread_message_queue_nb_elems(ist->dec_packet_queue);
+        av_bprintf(buf, "%sd%d:%d=%d/%d", sep, ist->file_index, ist->st->index,
+                   nb, ist->dec_queue_size);
+        av_bprintf(buf_script, "dec_queue_%d_%d=%d\n", ist->file_index, ist->st->index, nb);
+        sep = ",";
+    }
+    for (i = 0; i < nb_output_streams; i++) {
+        OutputStream *ost = output_streams[i];
+        int nb;
+        if (!ost->enc_thread_started)
+            continue;
+        nb = av_thread_message_queue_nb_elems(ost->enc_frame_queue);
+        av_bprintf(buf, "%se%d:%d=%d/%d", sep, ost->file_index, ost->index,
+                   nb, ost->enc_queue_size);
+        av_bprintf(buf_script, "enc_queue_%d_%d=%d\n", ost->file_index, ost->index, nb);
+        sep = ",";
+    }
+}
+#endif
+
 static void print_report(int is_last_report, int64_t timer_start, int64_t cur_time)
 {
     AVBPrint buf, buf_script;
@@ -1652,8 +2077,6 @@ static void print_report(int is_last_report, int64_t timer_start, int64_t cur_ti
     double bitrate;
     double speed;
     int64_t pts = INT64_MIN + 1;
-    static int64_t last_time = -1;
-    static int qp_histogram[52];
     int hours, mins, secs, us;
     const char *hours_sign;
     int ret;
@@ -1663,13 +2086,13 @@ static void print_report(int is_last_report, int64_t timer_start, int64_t cur_ti
         return;
 
     if (!is_last_report) {
-        if (last_time == -1) {
-            last_time = cur_time;
+        if (report_last_time == -1) {
+            report_last_time = cur_time;
             return;
         }
-        if ((cur_time - last_time) < 500000)
+        if ((cur_time - report_last_time) < 500000)
             return;
-        last_time = cur_time;
+        report_last_time = cur_time;
     }
 
     t = (cur_time-timer_start) / 1000000.0;
@@ -1753,8 +2176,10 @@ static void print_report(int is_last_report, int64_t timer_start, int64_t cur_ti
         if (av_stream_get_end_pts(ost->st) != AV_NOPTS_VALUE)
             pts = FFMAX(pts, av_rescale_q(av_stream_get_end_pts(ost->st),
                                           ost->st->time_base, AV_TIME_BASE_Q));
-        if (is_last_report)
+        if (is_last_report) {
             nb_frames_drop += ost->last_dropped;
+            ost->frames_dropped += ost->last_dropped;
+        }
     }
 
     secs = FFABS(pts) / AV_TIME_BASE;
@@ -1811,6 +2236,10 @@ static void print_report(int is_last_report, int64_t timer_start, int64_t cur_ti
         av_bprintf(&buf_script, "speed=%4.3gx\n", speed);
     }
 
+#if HAVE_THREADS
+    print_queue_report(&buf, &buf_script);
+#endif
+
     if (print_stats || is_last_report) {
         const char end = is_last_report ? '\n' : '\r';
         if (print_stats==1 && AV_LOG_INFO > av_log_get_level()) {
@@ -1829,7 +2258,8 @@ static void print_report(int is_last_report, int64_t timer_start, int64_t cur_ti
                    FFMIN(buf_script.len, buf_script.size - 1));
         avio_flush(progress_avio);
         av_bprint_finalize(&buf_script, NULL);
-        if (is_last_report) {
+        /* the progress of all the jobs of a batch goes to the same url */
+        if (is_last_report && !batch_job_running) {
             if ((ret = avio_closep(&progress_avio)) < 0)
                 av_log(NULL, AV_LOG_ERROR,
                        "Error closing progress log, loss of information possible: %s\n", av_err2str(ret));
@@ -1840,6 +2270,165 @@ static void print_report(int is_last_report, int64_t timer_start, int64_t cur_ti
         print_final_stats(total_size);
 }
 
+static void print_benchmark_stage(AVBPrint *buf, const char *name,
+                                  BenchmarkStage *s)
+{
+    av_bprintf(buf, ",\"%s\":{\"real_us\":%"PRId64",\"cpu_us\":%"PRId64"}",
+               name, (int64_t)atomic_load_explicit(&s->real_usec, memory_order_relaxed),
+               (int64_t)atomic_load_explicit(&s->cpu_usec, memory_order_relaxed));
+}
+
+/**
+ * Write one line of JSON with the time spent in each stage of the pipeline
+ * to benchmark_report_avio, every benchmark_report_period seconds and for
+ * the last report.
+ */
+static void print_benchmark_report(int is_last_report, int64_t timer_start, int64_t cur_time)
+{
+    AVFilterGraphPoolStats pool_stats;
+    AVBPrint buf;
+    int i, j, ret;
+
+    if (!benchmark_report_avio)
+        return;
+
+    if (!is_last_report) {
+        if (benchmark_report_period <= 0)
+            return;
+        if (benchmark_report_last_time == -1)
+            benchmark_report_last_time = timer_start;
+        if (cur_time - benchmark_report_last_time < benchmark_report_period * 1000000)
+            return;
+        benchmark_report_last_time = cur_time;
+    }
+
+    av_bprint_init(&buf, 0, AV_BPRINT_SIZE_UNLIMITED);
+    av_bprintf(&buf, "{\"time\":%.6f,\"final\":%s,\"maxrss\":%"PRId64,
+               (cur_time - timer_start) / 1000000.0,
+               is_last_report ? "true" : "false", getmaxrss());
+    av_bprintf(&buf, ",\"frames_dropped\":%d,\"frames_duplicated\":%d",
+               nb_frames_drop, nb_frames_dup);
+
+    av_bprintf(&buf, ",\"inputs\":[");
+    for (i = 0; i < nb_input_files; i++) {
+        InputFile *f = input_files[i];
+        const char *sep = "";
+
+        av_bprintf(&buf, "%s{\"file\":%d", i ? "," : "", i);
+        print_benchmark_stage(&buf, "demux", &f->bench_demux);
+#if HAVE_THREADS
+        if (f->in_thread_queue) {
+            int64_t bytes;
+            pthread_mutex_lock(&f->in_thread_lock);
+            bytes = f->queued_bytes;
+            pthread_mutex_unlock(&f->in_thread_lock);
+            av_bprintf(&buf, ",\"queue\":{\"packets\":%d,\"bytes\":%"PRId64"}",
+                       av_thread_message_queue_nb_elems(f->in_thread_queue), bytes);
+        }
+#endif
+        av_bprintf(&buf, ",\"streams\":[");
+        for (j = 0; j < f->nb_streams; j++) {
+            InputStream *ist = input_streams[f->ist_index + j];
+            const char *type = av_get_media_type_string(ist->dec_ctx->codec_type);
+            if (ist->discard)
+                continue;
+            av_bprintf(&buf, "%s{\"index\":%d,\"type\":\"%s\",\"codec\":\"%s\"",
+                       sep, ist->st->index, type ? type : "unknown",
+                       ist->decoding_needed && ist->dec ? ist->dec->name : "copy");
+            av_bprintf(&buf, ",\"packets\":%"PRIu64",\"frames\":%"PRIu64,
+                       ist->nb_packets, ist->frames_decoded);
+            print_benchmark_stage(&buf, "decode", &ist->bench_decode);
+#if HAVE_THREADS
+            if (ist->dec_thread_started)
+                av_bprintf(&buf, ",\"queue\":%d",
+                           av_thread_message_queue_nb_elems(ist->dec_packet_queue));
+#endif
+            av_bprintf(&buf, "}");
+            sep = ",";
+        }
+        av_bprintf(&buf, "]}");
+    }
+
+    av_bprintf(&buf, "],\"filtergraphs\":[");
+    for (i = 0; i < nb_filtergraphs; i++) {
+        FilterGraph *fg = filtergraphs[i];
+
+        av_bprintf(&buf, "%s{\"index\":%d", i ? "," : "", i);
+        print_benchmark_stage(&buf, "filter", &fg->bench_filter);
+        if (fg->graph && avfilter_graph_get_pool_stats(fg->graph, &pool_stats) >= 0)
+            av_bprintf(&buf, ",\"pools\":{\"count\":%d,\"gets\":%"PRId64
+                       ",\"hits\":%"PRId64",\"misses\":%"PRId64",\"bytes\":%"PRId64"}"
+                       ",\"copies\":{\"count\":%"PRId64",\"bytes\":%"PRId64"}",
+                       pool_stats.nb_pools, pool_stats.nb_gets, pool_stats.nb_hits,
+                       pool_stats.nb_misses, pool_stats.bytes_held,
+                       pool_stats.nb_copies, pool_stats.bytes_copied);
+        if (fg->graph && filter_profile) {
+            av_bprintf(&buf, ",\"filters\":[");
+            for (j = 0; j < fg->graph->nb_filters; j++) {
+                AVFilterContext *filter = fg->graph->filters[j];
+                AVFilterProfile profile;
+
+                avfilter_get_profile(filter, &profile);
+                av_bprintf(&buf, "%s{\"name\":\"", j ? "," : "");
+                av_bprint_escape(&buf, filter->name, "\"", AV_ESCAPE_MODE_BACKSLASH, 0);
+                av_bprintf(&buf, "\",\"filter\":\"%s\",\"activations\":%"PRId64
+                           ",\"real_us\":%"PRId64",\"cpu_us\":%"PRId64
+                           ",\"frames_in\":%"PRId64",\"frames_out\":%"PRId64
+                           ",\"bytes\":%"PRId64",\"max_queued\":%d}",
+                           filter->filter->name, profile.nb_activations,
+                           profile.real_time, profile.cpu_time,
+                           profile.frames_in, profile.frames_out,
+                           profile.bytes_alloc, profile.max_queued);
+            }
+            av_bprintf(&buf, "]");
+        }
+#if HAVE_THREADS
+        if (fg->thread_started)
+            av_bprintf(&buf, ",\"queue\":%d", filtergraph_thread_queue_size(fg));
+#endif
+        av_bprintf(&buf, "}");
+    }
+
+    av_bprintf(&buf, "],\"outputs\":[");
+    for (i = 0; i < nb_output_files; i++) {
+        OutputFile *of = output_files[i];
+
+        av_bprintf(&buf, "%s{\"file\":%d,\"streams\":[", i ? "," : "", i);
+        for (j = 0; j < of->ctx->nb_streams; j++) {
+            OutputStream *ost = output_streams[of->ost_index + j];
+            const char *type = av_get_media_type_string(ost->enc_ctx->codec_type);
+            av_bprintf(&buf, "%s{\"index\":%d,\"type\":\"%s\",\"codec\":\"%s\"",
+                       j ? "," : "", ost->index, type ? type : "unknown",
+                       ost->encoding_needed && ost->enc ? ost->enc->name : "copy");
+            av_bprintf(&buf, ",\"frames\":%"PRIu64",\"packets\":%"PRIu64
+                       ",\"frames_dropped\":%"PRIu64",\"frames_duplicated\":%"PRIu64,
+                       ost->frames_encoded, ost->packets_written,
+                       ost->frames_dropped, ost->frames_duplicated);
+            print_benchmark_stage(&buf, "encode", &ost->bench_encode);
+            print_benchmark_stage(&buf, "mux", &ost->bench_mux);
+#if HAVE_THREADS
+            if (ost->enc_thread_started)
+                av_bprintf(&buf, ",\"queue\":%d",
+                           av_thread_message_queue_nb_elems(ost->enc_frame_queue));
+#endif
+            av_bprintf(&buf, "}");
+        }
+        av_bprintf(&buf, "]}");
+    }
+    av_bprintf(&buf, "]}\n");
+
+    if (av_bprint_is_complete(&buf))
+        avio_write(benchmark_report_avio, buf.str, buf.len);
+    avio_flush(benchmark_report_avio);
+    av_bprint_finalize(&buf, NULL);
+
+    if (is_last_report && !batch_job_running) {
+        if ((ret = avio_closep(&benchmark_report_avio)) < 0)
+            av_log(NULL, AV_LOG_ERROR,
+                   "Error closing benchmark report, loss of information possible: %s\n", av_err2str(ret));
+    }
+}
+
 static void ifilter_parameters_from_codecpar(InputFilter *ifilter, AVCodecParameters *par)
 {
     // We never got any input. Set a fake format, which will
@@ -1903,6 +2492,28 @@ static void flush_encoders(void)
             }
         }
 
+#if HAVE_THREADS
+        if (ost->enc_thread_started) {
+            AVPacket pkt;
+
+            update_benchmark(NULL);
+            send_encoder_thread(ost, NULL);
+            reap_encoder_thread(of, ost, 1);
+            free_encoder_thread(ost);
+            update_benchmark("flush_%s %d.%d",
+                             enc->codec_type == AVMEDIA_TYPE_VIDEO ? "video" : "audio",
+                             ost->file_index, ost->index);
+
+            if (enc->codec_type == AVMEDIA_TYPE_AUDIO && enc->frame_size <= 1)
+                continue;
+            av_init_packet(&pkt);
+            pkt.data = NULL;
+            pkt.size = 0;
+            output_packet(of, &pkt, ost, 1);
+            continue;
+        }
+#endif
+
         if (enc->codec_type == AVMEDIA_TYPE_AUDIO && enc->frame_size <= 1)
             continue;
 
@@ -1931,8 +2542,8 @@ static void flush_encoders(void)
 
             update_benchmark(NULL);
 
-            while ((ret = avcodec_receive_packet(enc, &pkt)) == AVERROR(EAGAIN)) {
-                ret = avcodec_send_frame(enc, NULL);
+            while ((ret = encode_receive_packet(ost, &pkt)) == AVERROR(EAGAIN)) {
+                ret = encode_send_frame(ost, NULL);
                 if (ret < 0) {
                     av_log(NULL, AV_LOG_FATAL, "%s encoding failed: %s\n",
                            desc,
@@ -2180,6 +2791,12 @@ static int ifilter_send_frame(InputFilter *ifilter, AVFrame *frame)
             }
         }
 
+#if HAVE_THREADS
+        if (fg->thread_started && (ret = sync_filtergraph_thread(fg)) < 0) {
+            av_log(NULL, AV_LOG_ERROR, "Error while filtering: %s\n", av_err2str(ret));
+            return ret;
+        }
+#endif
         ret = reap_filters(1);
         if (ret < 0 && ret != AVERROR_EOF) {
             av_log(NULL, AV_LOG_ERROR, "Error while filtering: %s\n", av_err2str(ret));
@@ -2193,7 +2810,17 @@ static int ifilter_send_frame(InputFilter *ifilter, AVFrame *frame)
         }
     }
 
-    ret = av_buffersrc_add_frame_flags(ifilter->filter, frame, AV_BUFFERSRC_FLAG_PUSH);
+#if HAVE_THREADS
+    if (fg->thread_started) {
+        ret = ifilter_send_threaded(ifilter, frame, AV_NOPTS_VALUE);
+        av_frame_unref(frame);
+    } else
+#endif
+    {
+        benchmark_stage_start(&fg->bench_filter);
+        ret = av_buffersrc_add_frame_flags(ifilter->filter, frame, AV_BUFFERSRC_FLAG_PUSH);
+        benchmark_stage_stop(&fg->bench_filter);
+    }
     if (ret < 0) {
         if (ret != AVERROR_EOF)
             av_log(NULL, AV_LOG_ERROR, "Error while filtering: %s\n", av_err2str(ret));
@@ -2210,7 +2837,16 @@ static int ifilter_send_eof(InputFilter *ifilter, int64_t pts)
     ifilter->eof = 1;
 
     if (ifilter->filter) {
-        ret = av_buffersrc_close(ifilter->filter, pts, AV_BUFFERSRC_FLAG_PUSH);
+#if HAVE_THREADS
+        if (ifilter->graph->thread_started)
+            ret = ifilter_send_threaded(ifilter, NULL, pts);
+        else
+#endif
+        {
+            benchmark_stage_start(&ifilter->graph->bench_filter);
+            ret = av_buffersrc_close(ifilter->filter, pts, AV_BUFFERSRC_FLAG_PUSH);
+            benchmark_stage_stop(&ifilter->graph->bench_filter);
+        }
         if (ret < 0)
             return ret;
     } else {
@@ -2226,25 +2862,305 @@ static int ifilter_send_eof(InputFilter *ifilter, int64_t pts)
     return 0;
 }
 
+static void get_decoder_state(DecoderState *s, const AVCodecContext *avctx)
+{
+    s->has_b_frames           = avctx->has_b_frames;
+    s->sample_rate            = avctx->sample_rate;
+    s->framerate              = avctx->framerate;
+    s->ticks_per_frame        = avctx->ticks_per_frame;
+    s->bits_per_raw_sample    = avctx->bits_per_raw_sample;
+    s->chroma_sample_location = avctx->chroma_sample_location;
+    s->width                  = avctx->width;
+    s->height                 = avctx->height;
+    s->pix_fmt                = avctx->pix_fmt;
+}
+
+/* the part of decode_video() that needs the decoder context */
+static int retrieve_decoded_video(InputStream *ist, AVFrame *frame)
+{
+    AVCodecContext *avctx = ist->dec_ctx;
+
+    if (avctx->width   != frame->width ||
+        avctx->height  != frame->height ||
+        avctx->pix_fmt != frame->format) {
+        av_log(NULL, AV_LOG_DEBUG, "Frame parameters mismatch context %d,%d,%d != %d,%d,%d\n",
+            frame->width,
+            frame->height,
+            frame->format,
+            avctx->width,
+            avctx->height,
+            avctx->pix_fmt);
+    }
+
+    if (ist->hwaccel_retrieve_data && frame->format == ist->hwaccel_pix_fmt)
+        return ist->hwaccel_retrieve_data(avctx, frame);
+    return 0;
+}
+
+#if HAVE_THREADS
+typedef struct DecoderPacket {
+    AVPacket pkt;
+    int64_t  dts;       /* ist->dts if the packet has a dts, in AV_TIME_BASE */
+    int      flush;     /* avcodec_flush_buffers() instead of decoding pkt */
+} DecoderPacket;
+
+typedef struct DecodedFrame {
+    AVFrame *frame;
+    int      ret;       /* decoding error or AVERROR_EOF if frame is NULL */
+    int64_t  pkt_pts;   /* pts of the packet, for the first frame decoded from it */
+    int64_t  dts;       /* ist->dts when the frame was decoded, in AV_TIME_BASE */
+    int      first;     /* the first frame decoded from its packet */
+    int      retrieve_ret;
+    DecoderState state;
+} DecodedFrame;
+
+static int queue_decoded_frame(InputStream *ist, AVFrame *frame, int ret, int retrieve_ret,
+                               int64_t pkt_pts, int64_t dts, int first)
+{
+    DecodedFrame df = { frame, ret, pkt_pts, dts, first, retrieve_ret };
+    int err = 0;
+
+    get_decoder_state(&df.state, ist->dec_ctx);
+
+    pthread_mutex_lock(&ist->dec_lock);
+    if (av_fifo_space(ist->dec_frame_queue) < sizeof(df))
+        err = av_fifo_grow(ist->dec_frame_queue, av_fifo_size(ist->dec_frame_queue));
+    if (err >= 0) {
+        av_fifo_generic_write(ist->dec_frame_queue, &df, sizeof(df), NULL);
+        pthread_cond_signal(&ist->dec_cond);
+    }
+    pthread_mutex_unlock(&ist->dec_lock);
+
+    return err;
+}
+
+static void free_dec_packet(void *msg)
+{
+    av_packet_unref(&((DecoderPacket *)msg)->pkt);
+}
+
+static void *decoder_thread(void *arg)
+{
+    InputStream *ist = arg;
+    AVCodecContext *avctx = ist->dec_ctx;
+    AVFrame *frame = NULL;
+    DecoderPacket dp;
+    int64_t pkt_pts, dts = AV_NOPTS_VALUE;
+    int ret, retrieve_ret, first;
+
+    while (av_thread_message_queue_recv(ist->dec_packet_queue, &dp, 0) >= 0) {
+        if (dp.flush) {
+            avcodec_flush_buffers(avctx);
+            continue;
+        }
+
+        /* the frames get the timestamps they would get from process_input_packet()
+         * and decode_audio() in the main thread, the packet pts for the first one
+         * and the stream dts advanced by the duration of each */
+        pkt_pts = dp.pkt.pts;
+        first   = 1;
+        if (dp.dts != AV_NOPTS_VALUE)
+            dts = dp.dts;
+
+        benchmark_stage_start(&ist->bench_decode);
+        ret = avcodec_send_packet(avctx, &dp.pkt);
+        benchmark_stage_stop(&ist->bench_decode);
+        av_packet_unref(&dp.pkt);
+        // as in decode(), the decoded frames are always received until EAGAIN
+        if (ret < 0 && ret != AVERROR_EOF) {
+            if (queue_decoded_frame(ist, NULL, ret, 0, pkt_pts, dts, first) < 0)
+                break;
+            continue;
+        }
+
+        while (1) {
+            if (!frame && !(frame = av_frame_alloc())) {
+                queue_decoded_frame(ist, NULL, AVERROR(ENOMEM), 0, pkt_pts, dts, first);
+                goto end;
+            }
+            benchmark_stage_start(&ist->bench_decode);
+            ret = avcodec_receive_frame(avctx, frame);
+            benchmark_stage_stop(&ist->bench_decode);
+            if (ret == AVERROR(EAGAIN))
+                break;
+            retrieve_ret = 0;
+            if (ret >= 0 && avctx->codec_type == AVMEDIA_TYPE_VIDEO)
+                retrieve_ret = retrieve_decoded_video(ist, frame);
+            if (queue_decoded_frame(ist, ret < 0 ? NULL : frame, ret, retrieve_ret,
+                                    pkt_pts, dts, first) < 0)
+                goto end;
+            if (ret < 0)
+                break;
+            if (avctx->codec_type == AVMEDIA_TYPE_AUDIO && avctx->sample_rate > 0 &&
+                dts != AV_NOPTS_VALUE)
+                dts += ((int64_t)AV_TIME_BASE * frame->nb_samples) / avctx->sample_rate;
+            pkt_pts = AV_NOPTS_VALUE;
+            first   = 0;
+            frame = NULL;
+        }
+    }
+end:
+    av_frame_free(&frame);
+
+    return NULL;
+}
+
+static int init_decoder_thread(InputStream *ist)
+{
+    int ret;
+
+    if (ist->dec_queue_size <= 0 ||
+        (ist->dec_ctx->codec_type != AVMEDIA_TYPE_VIDEO &&
+         ist->dec_ctx->codec_type != AVMEDIA_TYPE_AUDIO))
+        return 0;
+
+    ret = av_thread_message_queue_alloc(&ist->dec_packet_queue,
+                                        ist->dec_queue_size, sizeof(DecoderPacket));
+    if (ret < 0)
+        return ret;
+    av_thread_message_queue_set_free_func(ist->dec_packet_queue, free_dec_packet);
+
+    ist->dec_frame_queue = av_fifo_alloc(8 * sizeof(DecodedFrame));
+    if (!ist->dec_frame_queue) {
+        av_thread_message_queue_free(&ist->dec_packet_queue);
+        return AVERROR(ENOMEM);
+    }
+    pthread_mutex_init(&ist->dec_lock, NULL);
+    pthread_cond_init(&ist->dec_cond, NULL);
+    ist->dec_flushing = 0;
+
+    if ((ret = pthread_create(&ist->dec_thread, NULL, decoder_thread, ist))) {
+        av_log(NULL, AV_LOG_ERROR, "pthread_create failed: %s. Try to increase `ulimit -v` or decrease `ulimit -s`.\n", strerror(ret));
+        pthread_cond_destroy(&ist->dec_cond);
+        pthread_mutex_destroy(&ist->dec_lock);
+        av_fifo_freep(&ist->dec_frame_queue);
+        av_thread_message_queue_free(&ist->dec_packet_queue);
+        return AVERROR(ret);
+    }
+    ist->dec_thread_started = 1;
+
+    return 0;
+}
+
+static void free_decoder_thread(InputStream *ist)
+{
+    DecodedFrame df;
+
+    if (!ist->dec_thread_started)
+        return;
+
+    /* drop the queued packets and stop the thread at its next recv() */
+    av_thread_message_queue_set_err_recv(ist->dec_packet_queue, AVERROR_EXIT);
+    av_thread_message_flush(ist->dec_packet_queue);
+    pthread_join(ist->dec_thread, NULL);
+    ist->dec_thread_started = 0;
+
+    while (av_fifo_size(ist->dec_frame_queue)) {
+        av_fifo_generic_read(ist->dec_frame_queue, &df, sizeof(df), NULL);
+        av_frame_free(&df.frame);
+    }
+    av_fifo_freep(&ist->dec_frame_queue);
+    av_thread_message_queue_free(&ist->dec_packet_queue);
+    pthread_cond_destroy(&ist->dec_cond);
+    pthread_mutex_destroy(&ist->dec_lock);
+}
+
+/* avcodec_flush_buffers() in the thread, once it drained the decoder */
+static int flush_decoder_thread(InputStream *ist)
+{
+    DecoderPacket dp = { .flush = 1 };
+
+    av_init_packet(&dp.pkt);
+    dp.pkt.data = NULL;
+    dp.pkt.size = 0;
+    return av_thread_message_queue_send(ist->dec_packet_queue, &dp, 0);
+}
+
+/* decode() for a stream decoded by its thread */
+static int decode_threaded(InputStream *ist, AVFrame *frame, int *got_frame, AVPacket *pkt)
+{
+    DecodedFrame df = { NULL, AVERROR(EAGAIN) };
+    DecoderPacket dp;
+    int ret;
+
+    if (pkt && !ist->dec_flushing) {
+        if (!pkt->data && !pkt->size) {
+            av_init_packet(&dp.pkt);
+            dp.pkt.data = NULL;
+            dp.pkt.size = 0;
+            ist->dec_flushing = 1;
+        } else if ((ret = av_packet_ref(&dp.pkt, pkt)) < 0) {
+            return ret;
+        }
+        dp.flush = 0;
+        dp.dts = pkt->dts != AV_NOPTS_VALUE || !ist->dec_thread_saw_dts ?
+                 ist->dts : AV_NOPTS_VALUE;
+        ist->dec_thread_saw_dts = 1;
+        ret = av_thread_message_queue_send(ist->dec_packet_queue, &dp, 0);
+        if (ret < 0) {
+            av_packet_unref(&dp.pkt);
+            return ret;
+        }
+    }
+
+    /* the frames are returned as they are decoded, only wait for the
+     * decoder to be drained */
+    pthread_mutex_lock(&ist->dec_lock);
+    while (ist->dec_flushing && !av_fifo_size(ist->dec_frame_queue))
+        pthread_cond_wait(&ist->dec_cond, &ist->dec_lock);
+    if (av_fifo_size(ist->dec_frame_queue))
+        av_fifo_generic_read(ist->dec_frame_queue, &df, sizeof(df), NULL);
+    pthread_mutex_unlock(&ist->dec_lock);
+
+    ist->dec_frame_pkt_pts      = df.pkt_pts;
+    ist->dec_frame_dts          = df.dts;
+    ist->dec_frame_first        = df.first;
+    ist->dec_frame_retrieve_ret = df.retrieve_ret;
+    if (df.frame || df.ret != AVERROR(EAGAIN))
+        ist->dec_state = df.state;
+    if (df.ret == AVERROR_EOF)
+        ist->dec_flushing = 0;
+    if (df.ret < 0)
+        return df.ret == AVERROR(EAGAIN) ? 0 : df.ret;
+
+    av_frame_move_ref(frame, df.frame);
+    av_frame_free(&df.frame);
+    *got_frame = 1;
+
+    return 0;
+}
+#endif
+
 // This does not quite work like avcodec_decode_audio4/avcodec_decode_video2.
 // There is the following difference: if you got a frame, you must call
 // it again with pkt=NULL. pkt==NULL is treated differently from pkt->size==0
 // (pkt==NULL means get more output, pkt->size==0 is a flush/drain packet)
 static int decode(AVCodecContext *avctx, AVFrame *frame, int *got_frame, AVPacket *pkt)
 {
+    InputStream *ist = avctx->opaque;
     int ret;
 
     *got_frame = 0;
 
+#if HAVE_THREADS
+    if (ist->dec_thread_started)
+        return decode_threaded(ist, frame, got_frame, pkt);
+#endif
+
+    benchmark_stage_start(&ist->bench_decode);
     if (pkt) {
         ret = avcodec_send_packet(avctx, pkt);
         // In particular, we don't expect AVERROR(EAGAIN), because we read all
         // decoded frames with avcodec_receive_frame() until done.
-        if (ret < 0 && ret != AVERROR_EOF)
+        if (ret < 0 && ret != AVERROR_EOF) {
+            benchmark_stage_stop(&ist->bench_decode);
             return ret;
+        }
     }
 
     ret = avcodec_receive_frame(avctx, frame);
+    benchmark_stage_stop(&ist->bench_decode);
+    get_decoder_state(&ist->dec_state, avctx);
     if (ret < 0 && ret != AVERROR(EAGAIN))
         return ret;
     if (ret >= 0)
@@ -2286,6 +3202,7 @@ static int decode_audio(InputStream *ist, AVPacket *pkt, int *got_output,
     AVCodecContext *avctx = ist->dec_ctx;
     int ret, err = 0;
     AVRational decoded_frame_tb;
+    int64_t pkt_pts, dts;
 
     if (!ist->decoded_frame && !(ist->decoded_frame = av_frame_alloc()))
         return AVERROR(ENOMEM);
@@ -2299,8 +3216,8 @@ static int decode_audio(InputStream *ist, AVPacket *pkt, int *got_output,
     if (ret < 0)
         *decode_failed = 1;
 
-    if (ret >= 0 && avctx->sample_rate <= 0) {
-        av_log(avctx, AV_LOG_ERROR, "Sample rate %d invalid\n", avctx->sample_rate);
+    if (ret >= 0 && ist->dec_state.sample_rate <= 0) {
+        av_log(avctx, AV_LOG_ERROR, "Sample rate %d invalid\n", ist->dec_state.sample_rate);
         ret = AVERROR_INVALIDDATA;
     }
 
@@ -2316,23 +3233,32 @@ static int decode_audio(InputStream *ist, AVPacket *pkt, int *got_output,
     /* increment next_dts to use for the case where the input stream does not
        have timestamps or there are multiple frames in the packet */
     ist->next_pts += ((int64_t)AV_TIME_BASE * decoded_frame->nb_samples) /
-                     avctx->sample_rate;
+                     ist->dec_state.sample_rate;
     ist->next_dts += ((int64_t)AV_TIME_BASE * decoded_frame->nb_samples) /
-                     avctx->sample_rate;
+                     ist->dec_state.sample_rate;
+
+    pkt_pts = pkt ? pkt->pts : AV_NOPTS_VALUE;
+    dts     = ist->dts;
+#if HAVE_THREADS
+    if (ist->dec_thread_started) {
+        pkt_pts = ist->dec_frame_pkt_pts;
+        dts     = ist->dec_frame_dts;
+    }
+#endif
 
     if (decoded_frame->pts != AV_NOPTS_VALUE) {
         decoded_frame_tb   = ist->st->time_base;
-    } else if (pkt && pkt->pts != AV_NOPTS_VALUE) {
-        decoded_frame->pts = pkt->pts;
+    } else if (pkt_pts != AV_NOPTS_VALUE) {
+        decoded_frame->pts = pkt_pts;
         decoded_frame_tb   = ist->st->time_base;
     }else {
-        decoded_frame->pts = ist->dts;
+        decoded_frame->pts = dts;
         decoded_frame_tb   = AV_TIME_BASE_Q;
     }
     if (decoded_frame->pts != AV_NOPTS_VALUE)
         decoded_frame->pts = av_rescale_delta(decoded_frame_tb, decoded_frame->pts,
-                                              (AVRational){1, avctx->sample_rate}, decoded_frame->nb_samples, &ist->filter_in_rescale_delta_last,
-                                              (AVRational){1, avctx->sample_rate});
+                                              (AVRational){1, ist->dec_state.sample_rate}, decoded_frame->nb_samples, &ist->filter_in_rescale_delta_last,
+                                              (AVRational){1, ist->dec_state.sample_rate});
     ist->nb_samples = decoded_frame->nb_samples;
     err = send_frame_to_filters(ist, decoded_frame);
 
@@ -2386,35 +3312,21 @@ static int decode_video(InputStream *ist, AVPacket *pkt, int *got_output, int64_
 
     // The following line may be required in some cases where there is no parser
     // or the parser does not has_b_frames correctly
-    if (ist->st->codecpar->video_delay < ist->dec_ctx->has_b_frames) {
+    if (ist->st->codecpar->video_delay < ist->dec_state.has_b_frames) {
         if (ist->dec_ctx->codec_id == AV_CODEC_ID_H264) {
-            ist->st->codecpar->video_delay = ist->dec_ctx->has_b_frames;
+            ist->st->codecpar->video_delay = ist->dec_state.has_b_frames;
         } else
             av_log(ist->dec_ctx, AV_LOG_WARNING,
                    "video_delay is larger in decoder than demuxer %d > %d.\n"
                    "If you want to help, upload a sample "
                    "of this file to ftp://upload.ffmpeg.org/incoming/ "
                    "and contact the ffmpeg-devel mailing list. (ffmpeg-devel@ffmpeg.org)\n",
-                   ist->dec_ctx->has_b_frames,
+                   ist->dec_state.has_b_frames,
                    ist->st->codecpar->video_delay);
     }
 
     if (ret != AVERROR_EOF)
-        check_decode_result(ist, got_output, ret);
-
-    if (*got_output && ret >= 0) {
-        if (ist->dec_ctx->width  != decoded_frame->width ||
-            ist->dec_ctx->height != decoded_frame->height ||
-            ist->dec_ctx->pix_fmt != decoded_frame->format) {
-            av_log(NULL, AV_LOG_DEBUG, "Frame parameters mismatch context %d,%d,%d != %d,%d,%d\n",
-                decoded_frame->width,
-                decoded_frame->height,
-                decoded_frame->format,
-                ist->dec_ctx->width,
-                ist->dec_ctx->height,
-                ist->dec_ctx->pix_fmt);
-        }
-    }
+        check_decode_result(ist, got_output, ret);
 
     if (!*got_output || ret < 0)
         return ret;
@@ -2424,11 +3336,15 @@ static int decode_video(InputStream *ist, AVPacket *pkt, int *got_output, int64_
 
     ist->frames_decoded++;
 
-    if (ist->hwaccel_retrieve_data && decoded_frame->format == ist->hwaccel_pix_fmt) {
-        err = ist->hwaccel_retrieve_data(ist->dec_ctx, decoded_frame);
-        if (err < 0)
-            goto fail;
-    }
+#if HAVE_THREADS
+    /* already done by the thread that owns the decoder context */
+    if (ist->dec_thread_started)
+        err = ist->dec_frame_retrieve_ret;
+    else
+#endif
+    err = retrieve_decoded_video(ist, decoded_frame);
+    if (err < 0)
+        goto fail;
     ist->hwaccel_retrieved_pix_fmt = decoded_frame->format;
 
     best_effort_timestamp= decoded_frame->best_effort_timestamp;
@@ -2479,8 +3395,11 @@ static int transcode_subtitles(InputStream *ist, AVPacket *pkt, int *got_output,
 {
     AVSubtitle subtitle;
     int free_sub = 1;
-    int i, ret = avcodec_decode_subtitle2(ist->dec_ctx,
-                                          &subtitle, got_output, pkt);
+    int i, ret;
+
+    benchmark_stage_start(&ist->bench_decode);
+    ret = avcodec_decode_subtitle2(ist->dec_ctx, &subtitle, got_output, pkt);
+    benchmark_stage_stop(&ist->bench_decode);
 
     check_decode_result(NULL, got_output, ret);
 
@@ -2575,7 +3494,7 @@ static int process_input_packet(InputStream *ist, const AVPacket *pkt, int no_eo
 
     AVPacket avpkt;
     if (!ist->saw_first_ts) {
-        ist->dts = ist->st->avg_frame_rate.num ? - ist->dec_ctx->has_b_frames * AV_TIME_BASE / av_q2d(ist->st->avg_frame_rate) : 0;
+        ist->dts = ist->st->avg_frame_rate.num ? - ist->dec_state.has_b_frames * AV_TIME_BASE / av_q2d(ist->st->avg_frame_rate) : 0;
         ist->pts = 0;
         if (pkt && pkt->pts != AV_NOPTS_VALUE && !ist->decoding_needed) {
             ist->dts += av_rescale_q(pkt->pts, ist->st->time_base, AV_TIME_BASE_Q);
@@ -2608,7 +3527,7 @@ static int process_input_packet(InputStream *ist, const AVPacket *pkt, int no_eo
     while (ist->decoding_needed) {
         int64_t duration_dts = 0;
         int64_t duration_pts = 0;
-        int got_output = 0;
+        int got_output = 0, nb_dts;
         int decode_failed = 0;
 
         ist->pts = ist->next_pts;
@@ -2622,18 +3541,25 @@ static int process_input_packet(InputStream *ist, const AVPacket *pkt, int no_eo
         case AVMEDIA_TYPE_VIDEO:
             ret = decode_video    (ist, repeating ? NULL : &avpkt, &got_output, &duration_pts, !pkt,
                                    &decode_failed);
-            if (!repeating || !pkt || got_output) {
+            nb_dts = !repeating || !pkt || got_output;
+#if HAVE_THREADS
+            /* the decoder thread returns frames late, count a duration for
+             * each packet sent and each further frame one of them gave */
+            if (ist->dec_thread_started)
+                nb_dts = (!repeating || !pkt) + (got_output && pkt && !ist->dec_frame_first);
+#endif
+            if (nb_dts) {
                 if (pkt && pkt->duration) {
                     duration_dts = av_rescale_q(pkt->duration, ist->st->time_base, AV_TIME_BASE_Q);
-                } else if(ist->dec_ctx->framerate.num != 0 && ist->dec_ctx->framerate.den != 0) {
-                    int ticks= av_stream_get_parser(ist->st) ? av_stream_get_parser(ist->st)->repeat_pict+1 : ist->dec_ctx->ticks_per_frame;
+                } else if(ist->dec_state.framerate.num != 0 && ist->dec_state.framerate.den != 0) {
+                    int ticks= av_stream_get_parser(ist->st) ? av_stream_get_parser(ist->st)->repeat_pict+1 : ist->dec_state.ticks_per_frame;
                     duration_dts = ((int64_t)AV_TIME_BASE *
-                                    ist->dec_ctx->framerate.den * ticks) /
-                                    ist->dec_ctx->framerate.num / ist->dec_ctx->ticks_per_frame;
+                                    ist->dec_state.framerate.den * ticks) /
+                                    ist->dec_state.framerate.num / ist->dec_state.ticks_per_frame;
                 }
 
                 if(ist->dts != AV_NOPTS_VALUE && duration_dts) {
-                    ist->next_dts += duration_dts;
+                    ist->next_dts += nb_dts * duration_dts;
                 }else
                     ist->next_dts = AV_NOPTS_VALUE;
             }
@@ -2895,6 +3821,8 @@ static int init_input_stream(int ist_index, char *error, int error_len)
     int ret;
     InputStream *ist = input_streams[ist_index];
 
+    get_decoder_state(&ist->dec_state, ist->dec_ctx);
+
     if (ist->decoding_needed) {
         AVCodec *codec = ist->dec;
         if (!codec) {
@@ -2947,6 +3875,16 @@ static int init_input_stream(int ist_index, char *error, int error_len)
             return ret;
         }
         assert_avoptions(ist->decoder_opts);
+        get_decoder_state(&ist->dec_state, ist->dec_ctx);
+
+#if HAVE_THREADS
+        ret = init_decoder_thread(ist);
+        if (ret < 0) {
+            snprintf(error, error_len, "Error starting the decoder thread "
+                     "for input stream #%d:%d", ist->file_index, ist->st->index);
+            return ret;
+        }
+#endif
     }
 
     ist->next_pts = AV_NOPTS_VALUE;
@@ -3296,7 +4234,7 @@ static int init_output_stream_encode(OutputStream *ost)
 {
     InputStream *ist = get_input_stream(ost);
     AVCodecContext *enc_ctx = ost->enc_ctx;
-    AVCodecContext *dec_ctx = NULL;
+    const DecoderState *dec_state = NULL;
     AVFormatContext *oc = output_files[ost->file_index]->ctx;
     int j, ret;
 
@@ -3310,9 +4248,9 @@ static int init_output_stream_encode(OutputStream *ost)
     if (ist) {
         ost->st->disposition          = ist->st->disposition;
 
-        dec_ctx = ist->dec_ctx;
+        dec_state = &ist->dec_state;
 
-        enc_ctx->chroma_sample_location = dec_ctx->chroma_sample_location;
+        enc_ctx->chroma_sample_location = dec_state->chroma_sample_location;
     } else {
         for (j = 0; j < oc->nb_streams; j++) {
             AVStream *st = oc->streams[j];
@@ -3356,8 +4294,8 @@ static int init_output_stream_encode(OutputStream *ost)
     switch (enc_ctx->codec_type) {
     case AVMEDIA_TYPE_AUDIO:
         enc_ctx->sample_fmt     = av_buffersink_get_format(ost->filter->filter);
-        if (dec_ctx)
-            enc_ctx->bits_per_raw_sample = FFMIN(dec_ctx->bits_per_raw_sample,
+        if (dec_state)
+            enc_ctx->bits_per_raw_sample = FFMIN(dec_state->bits_per_raw_sample,
                                                  av_get_bytes_per_sample(enc_ctx->sample_fmt) << 3);
         enc_ctx->sample_rate    = av_buffersink_get_sample_rate(ost->filter->filter);
         enc_ctx->channel_layout = av_buffersink_get_channel_layout(ost->filter->filter);
@@ -3389,18 +4327,18 @@ static int init_output_stream_encode(OutputStream *ost)
             av_buffersink_get_sample_aspect_ratio(ost->filter->filter);
 
         enc_ctx->pix_fmt = av_buffersink_get_format(ost->filter->filter);
-        if (dec_ctx)
-            enc_ctx->bits_per_raw_sample = FFMIN(dec_ctx->bits_per_raw_sample,
+        if (dec_state)
+            enc_ctx->bits_per_raw_sample = FFMIN(dec_state->bits_per_raw_sample,
                                                  av_pix_fmt_desc_get(enc_ctx->pix_fmt)->comp[0].depth);
 
         enc_ctx->framerate = ost->frame_rate;
 
         ost->st->avg_frame_rate = ost->frame_rate;
 
-        if (!dec_ctx ||
-            enc_ctx->width   != dec_ctx->width  ||
-            enc_ctx->height  != dec_ctx->height ||
-            enc_ctx->pix_fmt != dec_ctx->pix_fmt) {
+        if (!dec_state ||
+            enc_ctx->width   != dec_state->width  ||
+            enc_ctx->height  != dec_state->height ||
+            enc_ctx->pix_fmt != dec_state->pix_fmt) {
             enc_ctx->bits_per_raw_sample = frame_bits_per_raw_sample;
         }
 
@@ -3636,6 +4574,17 @@ static int init_output_stream(OutputStream *ost, char *error, int error_len)
     if (ret < 0)
         return ret;
 
+#if HAVE_THREADS
+    if (ost->encoding_needed) {
+        ret = init_encoder_thread(ost);
+        if (ret < 0) {
+            snprintf(error, error_len, "Error starting the encoder thread "
+                     "for output stream #%d:%d", ost->file_index, ost->index);
+            return ret;
+        }
+    }
+#endif
+
     ost->initialized = 1;
 
     ret = check_init_output_file(output_files[ost->file_index], ost->file_index);
@@ -3947,6 +4896,16 @@ static int check_keyboard_interaction(int64_t cur_time)
                    target, time, command, arg);
             for (i = 0; i < nb_filtergraphs; i++) {
                 FilterGraph *fg = filtergraphs[i];
+#if HAVE_THREADS
+                int restart = fg->thread_started;
+
+                /* the graph is only touched by its thread while it runs */
+                if (fg->thread_started) {
+                    if (sync_filtergraph_thread(fg) < 0)
+                        continue;
+                    filtergraph_thread_stop(fg);
+                }
+#endif
                 if (fg->graph) {
                     if (time < 0) {
                         ret = avfilter_graph_send_command(fg->graph, target, command, arg, buf, sizeof(buf),
@@ -3961,6 +4920,10 @@ static int check_keyboard_interaction(int64_t cur_time)
                             fprintf(stderr, "Queuing command failed with error %s\n", av_err2str(ret));
                     }
                 }
+#if HAVE_THREADS
+                if (restart && (ret = filtergraph_thread_start(fg)) < 0)
+                    return ret;
+#endif
             }
         } else {
             av_log(NULL, AV_LOG_ERROR,
@@ -4020,15 +4983,42 @@ static int check_keyboard_interaction(int64_t cur_time)
 }
 
 #if HAVE_THREADS
+static int wait_input_queue_bytes(InputFile *f, int size)
+{
+    int ret = 0, warned = 0;
+
+    pthread_mutex_lock(&f->in_thread_lock);
+    /* a packet larger than the limit is still queued when the queue is empty */
+    while (!f->in_thread_abort && f->thread_queue_bytes && f->queued_bytes &&
+           f->queued_bytes + size > f->thread_queue_bytes) {
+        if (f->non_blocking && !warned) {
+            av_log(f->ctx, AV_LOG_WARNING,
+                   "Thread message queue blocking; consider raising the "
+                   "thread_queue_bytes option (current value: %"PRId64")\n",
+                   f->thread_queue_bytes);
+            warned = 1;
+        }
+        pthread_cond_wait(&f->in_thread_cond, &f->in_thread_lock);
+    }
+    if (f->in_thread_abort)
+        ret = AVERROR_EOF;
+    else
+        f->queued_bytes += size;
+    pthread_mutex_unlock(&f->in_thread_lock);
+    return ret;
+}
+
 static void *input_thread(void *arg)
 {
     InputFile *f = arg;
     unsigned flags = f->non_blocking ? AV_THREAD_MESSAGE_NONBLOCK : 0;
-    int ret = 0;
+    int ret = 0, queued;
 
     while (1) {
         AVPacket pkt;
+        benchmark_stage_start(&f->bench_demux);
         ret = av_read_frame(f->ctx, &pkt);
+        benchmark_stage_stop(&f->bench_demux);
 
         if (ret == AVERROR(EAGAIN)) {
             av_usleep(10000);
@@ -4038,7 +5028,10 @@ static void *input_thread(void *arg)
             av_thread_message_queue_set_err_recv(f->in_thread_queue, ret);
             break;
         }
-        ret = av_thread_message_queue_send(f->in_thread_queue, &pkt, flags);
+        ret = wait_input_queue_bytes(f, pkt.size);
+        queued = ret >= 0;
+        if (queued)
+            ret = av_thread_message_queue_send(f->in_thread_queue, &pkt, flags);
         if (flags && ret == AVERROR(EAGAIN)) {
             flags = 0;
             ret = av_thread_message_queue_send(f->in_thread_queue, &pkt, flags);
@@ -4052,6 +5045,11 @@ static void *input_thread(void *arg)
                 av_log(f->ctx, AV_LOG_ERROR,
                        "Unable to send packet to main thread: %s\n",
                        av_err2str(ret));
+            if (queued) {
+                pthread_mutex_lock(&f->in_thread_lock);
+                f->queued_bytes -= pkt.size;
+                pthread_mutex_unlock(&f->in_thread_lock);
+            }
             av_packet_unref(&pkt);
             av_thread_message_queue_set_err_recv(f->in_thread_queue, ret);
             break;
@@ -4069,12 +5067,18 @@ static void free_input_thread(int i)
     if (!f || !f->in_thread_queue)
         return;
     av_thread_message_queue_set_err_send(f->in_thread_queue, AVERROR_EOF);
+    pthread_mutex_lock(&f->in_thread_lock);
+    f->in_thread_abort = 1;
+    pthread_cond_signal(&f->in_thread_cond);
+    pthread_mutex_unlock(&f->in_thread_lock);
     while (av_thread_message_queue_recv(f->in_thread_queue, &pkt, 0) >= 0)
         av_packet_unref(&pkt);
 
     pthread_join(f->thread, NULL);
     f->joined = 1;
     av_thread_message_queue_free(&f->in_thread_queue);
+    pthread_mutex_destroy(&f->in_thread_lock);
+    pthread_cond_destroy(&f->in_thread_cond);
 }
 
 static void free_input_threads(void)
@@ -4090,7 +5094,7 @@ static int init_input_thread(int i)
     int ret;
     InputFile *f = input_files[i];
 
-    if (nb_input_files == 1)
+    if (nb_input_files == 1 && !f->demux_thread)
         return 0;
 
     if (f->ctx->pb ? !f->ctx->pb->seekable :
@@ -4100,10 +5104,16 @@ static int init_input_thread(int i)
                                         f->thread_queue_size, sizeof(AVPacket));
     if (ret < 0)
         return ret;
+    f->queued_bytes    = 0;
+    f->in_thread_abort = 0;
+    pthread_mutex_init(&f->in_thread_lock, NULL);
+    pthread_cond_init(&f->in_thread_cond, NULL);
 
     if ((ret = pthread_create(&f->thread, NULL, input_thread, f))) {
         av_log(NULL, AV_LOG_ERROR, "pthread_create failed: %s. Try to increase `ulimit -v` or decrease `ulimit -s`.\n", strerror(ret));
         av_thread_message_queue_free(&f->in_thread_queue);
+        pthread_mutex_destroy(&f->in_thread_lock);
+        pthread_cond_destroy(&f->in_thread_cond);
         return AVERROR(ret);
     }
 
@@ -4124,14 +5134,24 @@ static int init_input_threads(void)
 
 static int get_input_packet_mt(InputFile *f, AVPacket *pkt)
 {
-    return av_thread_message_queue_recv(f->in_thread_queue, pkt,
-                                        f->non_blocking ?
-                                        AV_THREAD_MESSAGE_NONBLOCK : 0);
+    int ret = av_thread_message_queue_recv(f->in_thread_queue, pkt,
+                                           f->non_blocking ?
+                                           AV_THREAD_MESSAGE_NONBLOCK : 0);
+
+    if (ret >= 0) {
+        pthread_mutex_lock(&f->in_thread_lock);
+        f->queued_bytes -= pkt->size;
+        pthread_cond_signal(&f->in_thread_cond);
+        pthread_mutex_unlock(&f->in_thread_lock);
+    }
+    return ret;
 }
 #endif
 
 static int get_input_packet(InputFile *f, AVPacket *pkt)
 {
+    int ret;
+
     if (f->rate_emu) {
         int i;
         for (i = 0; i < f->nb_streams; i++) {
@@ -4144,10 +5164,13 @@ static int get_input_packet(InputFile *f, AVPacket *pkt)
     }
 
 #if HAVE_THREADS
-    if (nb_input_files > 1)
+    if (f->in_thread_queue)
         return get_input_packet_mt(f, pkt);
 #endif
-    return av_read_frame(f->ctx, pkt);
+    benchmark_stage_start(&f->bench_demux);
+    ret = av_read_frame(f->ctx, pkt);
+    benchmark_stage_stop(&f->bench_demux);
+    return ret;
 }
 
 static int got_eagain(void)
@@ -4202,6 +5225,10 @@ static int seek_to_start(InputFile *ifile, AVFormatContext *is)
     for (i = 0; i < ifile->nb_streams; i++) {
         ist   = input_streams[ifile->ist_index + i];
         avctx = ist->dec_ctx;
+#if HAVE_THREADS
+        /* the first packet after the seek sets the dts again */
+        ist->dec_thread_saw_dts = 0;
+#endif
 
         /* duration is the length of the last frame in a stream
          * when audio stream is present we don't care about
@@ -4216,7 +5243,7 @@ static int seek_to_start(InputFile *ifile, AVFormatContext *is)
 
         if (has_audio) {
             if (avctx->codec_type == AVMEDIA_TYPE_AUDIO && ist->nb_samples) {
-                AVRational sample_rate = {1, avctx->sample_rate};
+                AVRational sample_rate = {1, ist->dec_state.sample_rate};
 
                 duration = av_rescale_q(ist->nb_samples, sample_rate, ist->st->time_base);
             } else {
@@ -4279,6 +5306,12 @@ static int process_input(int file_index)
                 ret = process_input_packet(ist, NULL, 1);
                 if (ret>0)
                     return 0;
+#if HAVE_THREADS
+                if (ist->dec_thread_started) {
+                    if ((ret = flush_decoder_thread(ist)) < 0)
+                        return ret;
+                } else
+#endif
                 avcodec_flush_buffers(avctx);
             }
         }
@@ -4536,9 +5569,27 @@ static int transcode_from_filter(FilterGraph *graph, InputStream **best_ist)
     int nb_requests, nb_requests_max = 0;
     InputFilter *ifilter;
     InputStream *ist;
+#if HAVE_THREADS
+    int idle = 0;
+#endif
 
     *best_ist = NULL;
-    ret = avfilter_graph_request_oldest(graph->graph);
+#if HAVE_THREADS
+    ret = filtergraph_thread_start(graph);
+    if (ret < 0)
+        return ret;
+    if (graph->thread_started)
+        ret = filtergraph_thread_wait(graph, 1);
+    else
+#endif
+    {
+        benchmark_stage_start(&graph->bench_filter);
+        ret = avfilter_graph_request_oldest(graph->graph);
+        benchmark_stage_stop(&graph->bench_filter);
+    }
+#if HAVE_THREADS
+retry:
+#endif
     if (ret >= 0)
         return reap_filters(0);
 
@@ -4557,13 +5608,23 @@ static int transcode_from_filter(FilterGraph *graph, InputStream **best_ist)
         if (input_files[ist->file_index]->eagain ||
             input_files[ist->file_index]->eof_reached)
             continue;
-        nb_requests = av_buffersrc_get_nb_failed_requests(ifilter->filter);
+        nb_requests = ifilter_get_nb_failed_requests(ifilter);
         if (nb_requests > nb_requests_max) {
             nb_requests_max = nb_requests;
             *best_ist = ist;
         }
     }
 
+#if HAVE_THREADS
+    /* the thread may still be working on its queue, only give up on the
+     * graph once it has run out of work */
+    if (!*best_ist && graph->thread_started && !idle) {
+        ret = filtergraph_thread_wait(graph, 0);
+        idle = 1;
+        goto retry;
+    }
+#endif
+
     if (!*best_ist)
         for (i = 0; i < graph->nb_outputs; i++)
             graph->outputs[i]->ost->unavailable = 1;
@@ -4697,6 +5758,7 @@ static int transcode(void)
 
         /* dump report by using the output first video and audio streams */
         print_report(0, timer_start, cur_time);
+        print_benchmark_report(0, timer_start, cur_time);
     }
 #if HAVE_THREADS
     free_input_threads();
@@ -4732,6 +5794,20 @@ static int transcode(void)
 
     /* dump report by using the first video and audio streams */
     print_report(1, timer_start, av_gettime_relative());
+    print_benchmark_report(1, timer_start, av_gettime_relative());
+
+    if (filter_profile) {
+        for (i = 0; i < nb_filtergraphs; i++) {
+            char *dump;
+
+            if (!filtergraphs[i]->graph)
+                continue;
+            dump = avfilter_graph_dump_profile(filtergraphs[i]->graph, NULL);
+            if (dump)
+                av_log(NULL, AV_LOG_INFO, "Filtergraph %d profile:\n%s", i, dump);
+            av_free(dump);
+        }
+    }
 
     /* close each encoder */
     for (i = 0; i < nb_output_streams; i++) {
@@ -4751,6 +5827,9 @@ static int transcode(void)
     for (i = 0; i < nb_input_streams; i++) {
         ist = input_streams[i];
         if (ist->decoding_needed) {
+#if HAVE_THREADS
+            free_decoder_thread(ist);
+#endif
             avcodec_close(ist->dec_ctx);
             if (ist->hwaccel_uninit)
                 ist->hwaccel_uninit(ist->dec_ctx);
@@ -4758,7 +5837,9 @@ static int transcode(void)
     }
 
     av_buffer_unref(&hw_device_ctx);
-    hw_device_free_all();
+    /* the devices are shared by all the jobs of a batch */
+    if (!batch_job_running)
+        hw_device_free_all();
 
     /* finished ! */
     ret = 0;
@@ -4840,49 +5921,22 @@ static void log_callback_null(void *ptr, int level, const char *fmt, va_list vl)
 {
 }
 
-int main(int argc, char **argv)
+/* run the transcoding set up by ffmpeg_parse_options() */
+static int run_job(void)
 {
-    int i, ret;
+    int i;
     BenchmarkTimeStamps ti;
 
-    init_dynload();
-
-    register_exit(ffmpeg_cleanup);
-
-    setvbuf(stderr,NULL,_IONBF,0); /* win32 runtime needs this */
-
-    av_log_set_flags(AV_LOG_SKIP_REPEATED);
-    parse_loglevel(argc, argv, options);
-
-    if(argc>1 && !strcmp(argv[1], "-d")){
-        run_as_daemon=1;
-        av_log_set_callback(log_callback_null);
-        argc--;
-        argv++;
-    }
-
-#if CONFIG_AVDEVICE
-    avdevice_register_all();
-#endif
-    avformat_network_init();
-
-    show_banner(argc, argv, options);
-
-    /* parse options and open all input/output files */
-    ret = ffmpeg_parse_options(argc, argv);
-    if (ret < 0)
-        exit_program(1);
-
     if (nb_output_files <= 0 && nb_input_files == 0) {
         show_usage();
         av_log(NULL, AV_LOG_WARNING, "Use -h to get full help or, even better, run 'man %s'\n", program_name);
-        exit_program(1);
+        return 1;
     }
 
     /* file converter / grab */
     if (nb_output_files <= 0) {
         av_log(NULL, AV_LOG_FATAL, "At least one output file must be specified\n");
-        exit_program(1);
+        return 1;
     }
 
     for (i = 0; i < nb_output_files; i++) {
@@ -4892,7 +5946,7 @@ int main(int argc, char **argv)
 
     current_time = ti = get_benchmark_time_stamps();
     if (transcode() < 0)
-        exit_program(1);
+        return 1;
     if (do_benchmark) {
         int64_t utime, stime, rtime;
         current_time = get_benchmark_time_stamps();
@@ -4906,8 +5960,442 @@ int main(int argc, char **argv)
     av_log(NULL, AV_LOG_DEBUG, "%"PRIu64" frames successfully decoded, %"PRIu64" decoding errors\n",
            decode_error_stat[0], decode_error_stat[1]);
     if ((decode_error_stat[0] + decode_error_stat[1]) * max_error_rate < decode_error_stat[1])
-        exit_program(69);
+        return 69;
+
+    return received_nb_signals ? 255 : main_return_code;
+}
+
+static void batch_job_exit(int ret)
+{
+    ffmpeg_cleanup(ret);
+    batch_job_ret = ret;
+    longjmp(batch_job_env, 1);
+}
+
+/* reset the state left by ffmpeg_cleanup() for the next job of a batch */
+static void reset_job_state(void)
+{
+    nb_input_streams  = nb_input_files  = 0;
+    nb_output_streams = nb_output_files = 0;
+    nb_filtergraphs   = 0;
+    nb_frames_dup  = 0;
+    nb_frames_drop = 0;
+    dup_warning    = 1000;
+    decode_error_stat[0] = decode_error_stat[1] = 0;
+    want_sdp         = 1;
+    main_return_code = 0;
+    vstats_file      = NULL;
+    report_last_time = -1;
+    memset(qp_histogram, 0, sizeof(qp_histogram));
+    benchmark_report_last_time = -1;
+    atomic_store(&transcode_init_done, 0);
+    ffmpeg_exited = 0;
+}
+
+typedef struct BatchDefaults {
+    HWDevice *filter_hw_device;
+    int log_level;
+    int threads;    ///< codec and filter threads of each job, 0 for the defaults
+} BatchDefaults;
+
+/**
+ * Share the threads of a batch job between its decoders, encoders and
+ * filtergraphs, each of them getting at least one. The thread counts given
+ * by the job itself are kept.
+ */
+static void set_batch_job_threads(int threads)
+{
+    int nb_stages = nb_filtergraphs;
+    int i;
+
+    for (i = 0; i < nb_input_streams; i++)
+        nb_stages += !!input_streams[i]->decoding_needed;
+    for (i = 0; i < nb_output_streams; i++)
+        nb_stages += !!output_streams[i]->encoding_needed;
+    if (!nb_stages)
+        return;
+    threads = FFMAX(threads / nb_stages, 1);
+
+    for (i = 0; i < nb_input_streams; i++)
+        if (input_streams[i]->decoding_needed)
+            av_dict_set_int(&input_streams[i]->decoder_opts, "threads", threads,
+                            AV_DICT_DONT_OVERWRITE);
+    for (i = 0; i < nb_output_streams; i++)
+        if (output_streams[i]->encoding_needed)
+            av_dict_set_int(&output_streams[i]->encoder_opts, "threads", threads,
+                            AV_DICT_DONT_OVERWRITE);
+    if (!filter_nbthreads)
+        filter_nbthreads = threads;
+    if (!filter_complex_nbthreads)
+        filter_complex_nbthreads = threads;
+}
+
+/**
+ * Run a job of a batch in this process, the global options of the command
+ * line being its defaults.
+ *
+ * @return the exit code of the job or a negative AVERROR if the defaults
+ *         could not be restored
+ */
+static int run_batch_job(int argc, char **argv, const BatchDefaults *defaults)
+{
+    int ret;
+
+    if ((ret = restore_global_options()) < 0)
+        return ret;
+    /* the jobs may be read from stdin */
+    stdin_interaction = 0;
+    filter_hw_device = defaults->filter_hw_device;
+    av_log_set_level(defaults->log_level);
+    avformat_network_init();
+
+    register_exit(batch_job_exit);
+    if (!setjmp(batch_job_env)) {
+        ret = ffmpeg_parse_options(argc, argv) < 0;
+        if (!ret) {
+            if (defaults->threads > 0)
+                set_batch_job_threads(defaults->threads);
+            ret = run_job();
+        }
+        ffmpeg_cleanup(ret);
+    } else {
+        ret = batch_job_ret;
+    }
+    register_exit(ffmpeg_cleanup);
+    reset_job_state();
+    return ret;
+}
+
+static void report_batch_job(AVIOContext *results, int job, int ret, int64_t start)
+{
+    double time = (av_gettime_relative() - start) / 1000000.0;
+
+    av_log(NULL, ret ? AV_LOG_ERROR : AV_LOG_INFO,
+           "Job %d finished with code %d in %0.3fs\n", job, ret, time);
+    if (results) {
+        avio_printf(results, "{\"job\":%d,\"ret\":%d,\"time\":%0.6f}\n", job, ret, time);
+        avio_flush(results);
+    }
+}
+
+#if HAVE_FORK
+/* longest job line handed to a worker, in bytes */
+#define BATCH_MAX_JOB_SIZE 65536
+
+typedef struct BatchWorkerSummary {
+    int nb_jobs;
+    int nb_failed;
+} BatchWorkerSummary;
+
+/**
+ * Run the jobs received on job_fd until the parent closes it, then send the
+ * summary of the jobs run on summary_fd. Each message on job_fd holds the
+ * index of a job followed by its line.
+ */
+static void av_noreturn batch_worker(int job_fd, int summary_fd, AVIOContext *results,
+                                     const BatchDefaults *defaults)
+{
+    BatchDefaults worker_defaults = *defaults;
+    BatchWorkerSummary summary = { 0 };
+    char *msg = av_malloc(BATCH_MAX_JOB_SIZE + 1);
+    char **argv;
+    int argc, i, job, ret;
+    ssize_t size;
+
+    if (!msg) {
+        ret = AVERROR(ENOMEM);
+    } else if ((ret = init_batch_hw_devices()) < 0) {
+        av_log(NULL, AV_LOG_FATAL, "Failed to create the hardware devices of "
+               "a batch worker: %s\n", av_err2str(ret));
+    }
+    worker_defaults.filter_hw_device = filter_hw_device;
+
+    while (ret >= 0 && !received_sigterm) {
+        int64_t start;
+
+        size = recv(job_fd, msg, BATCH_MAX_JOB_SIZE, 0);
+        if (size < 0 && errno == EINTR)
+            continue;
+        if (size < (ssize_t)sizeof(job))
+            break;
+        start = av_gettime_relative();
+        memcpy(&job, msg, sizeof(job));
+        msg[size] = 0;
+
+        argc = parse_batch_job(msg + sizeof(job), &argv);
+        ret = argc > 0 ? run_batch_job(argc, argv, &worker_defaults) : 1;
+        for (i = 0; i < argc; i++)
+            av_freep(&argv[i]);
+        av_freep(&argv);
+        if (ret < 0)
+            break;
+
+        report_batch_job(results, job, ret, start);
+        summary.nb_jobs++;
+        summary.nb_failed += !!ret;
+    }
+    while (write(summary_fd, &summary, sizeof(summary)) < 0 && errno == EINTR);
+
+    av_free(msg);
+    close(summary_fd);
+    close(job_fd);
+    batch_job_running = 0;
+    filter_hw_device = NULL;
+    hw_device_free_all();
+    uninit_global_options();
+    avio_closep(&results);
+    exit_program(ret < 0);
+}
+
+/**
+ * Run the jobs read from jobs in batch_jobs worker processes, the idle
+ * workers taking the next job from a queue shared by all of them.
+ */
+static int run_batch_workers(AVIOContext *jobs, AVIOContext *results,
+                             const BatchDefaults *defaults,
+                             int *nb_jobs, int *nb_failed)
+{
+    BatchWorkerSummary summary;
+    int job_fds[2], summary_fds[2];
+    int nb_workers = 0, nb_done = 0;
+    pid_t *workers;
+    char **argv, *line, *msg;
+    int argc = 0, i, ret = 0, status;
+    size_t size;
+
+    if (!(workers = av_calloc(batch_jobs, sizeof(*workers))))
+        return AVERROR(ENOMEM);
+    if (!(msg = av_malloc(BATCH_MAX_JOB_SIZE))) {
+        av_free(workers);
+        return AVERROR(ENOMEM);
+    }
+    /* one message per job, so that a job is received by a single worker */
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, job_fds) < 0) {
+        ret = AVERROR(errno);
+        goto end;
+    }
+    if (pipe(summary_fds) < 0) {
+        ret = AVERROR(errno);
+        close(job_fds[0]);
+        close(job_fds[1]);
+        goto end;
+    }
+
+    /* not to be written again by the workers */
+    fflush(stdout);
+    for (i = 0; i < batch_jobs; i++) {
+        pid_t pid = fork();
+
+        if (!pid) {
+            av_free(workers);
+            av_free(msg);
+            close(job_fds[0]);
+            close(summary_fds[0]);
+            avio_closep(&jobs);
+            batch_worker(job_fds[1], summary_fds[1], results, defaults);
+        }
+        if (pid < 0) {
+            ret = AVERROR(errno);
+            av_log(NULL, AV_LOG_ERROR, "Failed to start a batch worker: %s\n",
+                   av_err2str(ret));
+            break;
+        }
+        workers[nb_workers++] = pid;
+    }
+    close(job_fds[1]);
+    close(summary_fds[1]);
+
+    while (nb_workers && !received_sigterm &&
+           (argc = read_batch_job(jobs, &argv, &line)) > 0) {
+        for (i = 0; i < argc; i++)
+            av_freep(&argv[i]);
+        av_freep(&argv);
+
+        size = strlen(line);
+        if (size + sizeof(*nb_jobs) > BATCH_MAX_JOB_SIZE) {
+            av_log(NULL, AV_LOG_ERROR, "Job %d is longer than %d bytes\n",
+                   *nb_jobs, BATCH_MAX_JOB_SIZE - (int)sizeof(*nb_jobs));
+            report_batch_job(results, (*nb_jobs)++, 1, av_gettime_relative());
+            (*nb_failed)++;
+            nb_done++;
+            av_free(line);
+            continue;
+        }
+        memcpy(msg, nb_jobs, sizeof(*nb_jobs));
+        memcpy(msg + sizeof(*nb_jobs), line, size);
+        av_free(line);
+        while ((ret = send(job_fds[0], msg, sizeof(*nb_jobs) + size, MSG_NOSIGNAL)) < 0 &&
+               errno == EINTR && !received_sigterm);
+        if (ret < 0) {
+            ret = AVERROR(errno);
+            av_log(NULL, AV_LOG_ERROR, "Failed to queue job %d: %s\n",
+                   *nb_jobs, av_err2str(ret));
+            break;
+        }
+        (*nb_jobs)++;
+    }
+    if (argc < 0)
+        ret = argc;
+    /* the workers stop once they have run the queued jobs */
+    close(job_fds[0]);
+
+    for (;;) {
+        ssize_t n = read(summary_fds[0], &summary, sizeof(summary));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n != sizeof(summary))
+            break;
+        nb_done    += summary.nb_jobs;
+        *nb_failed += summary.nb_failed;
+    }
+    close(summary_fds[0]);
+
+    for (i = 0; i < nb_workers; i++) {
+        while (waitpid(workers[i], &status, 0) < 0 && errno == EINTR);
+        if (!WIFEXITED(status) || WEXITSTATUS(status))
+            av_log(NULL, AV_LOG_ERROR, "Batch worker %d failed\n", (int)workers[i]);
+    }
+    /* the jobs queued to workers which died before reporting them */
+    if (*nb_jobs > nb_done) {
+        av_log(NULL, AV_LOG_ERROR, "%d jobs did not finish\n", *nb_jobs - nb_done);
+        *nb_failed += *nb_jobs - nb_done;
+    }
+    if (!nb_workers && ret >= 0)
+        ret = AVERROR(EAGAIN);
+end:
+    av_free(msg);
+    av_free(workers);
+    return ret < 0 ? ret : 0;
+}
+#endif
+
+/**
+ * Run the jobs read from batch_url, the global options of the command line
+ * being the defaults of every job. With -batch_jobs 1 the jobs run one after
+ * another in this process, the hardware devices being kept from one job to
+ * the next, else they run at once in worker processes.
+ */
+static int run_batch(void)
+{
+    AVIOContext *jobs = NULL, *results = NULL;
+    BatchDefaults defaults = {
+        .filter_hw_device = filter_hw_device,
+        .log_level        = av_log_get_level(),
+        .threads          = batch_threads > 0 ? FFMAX(batch_threads / FFMAX(batch_jobs, 1), 1) : 0,
+    };
+    int nb_jobs = 0, nb_failed = 0;
+    char **argv;
+    int argc = 0, i, ret;
+
+    if (nb_input_files || nb_output_files || nb_filtergraphs) {
+        av_log(NULL, AV_LOG_FATAL, "Input and output files and complex filtergraphs "
+               "must be given in the jobs of -batch\n");
+        return 1;
+    }
+#if !HAVE_FORK
+    if (batch_jobs > 1) {
+        av_log(NULL, AV_LOG_FATAL, "-batch_jobs is not supported on this platform\n");
+        return 1;
+    }
+#endif
+
+    ret = avio_open2(&jobs, strcmp(batch_url, "-") ? batch_url : "pipe:",
+                     AVIO_FLAG_READ, &int_cb, NULL);
+    if (ret < 0) {
+        av_log(NULL, AV_LOG_FATAL, "Failed to open batch URL \"%s\": %s\n",
+               batch_url, av_err2str(ret));
+        return 1;
+    }
+    if (batch_results_url) {
+        ret = avio_open2(&results, strcmp(batch_results_url, "-") ? batch_results_url : "pipe:",
+                         AVIO_FLAG_WRITE, &int_cb, NULL);
+        if (ret < 0) {
+            av_log(NULL, AV_LOG_FATAL, "Failed to open batch results URL \"%s\": %s\n",
+                   batch_results_url, av_err2str(ret));
+            goto end;
+        }
+    }
+    if ((ret = save_global_options()) < 0)
+        goto end;
+
+    batch_job_running = 1;
+#if HAVE_FORK
+    if (batch_jobs > 1) {
+        ret = run_batch_workers(jobs, results, &defaults, &nb_jobs, &nb_failed);
+    } else
+#endif
+    while (!received_sigterm && (argc = read_batch_job(jobs, &argv, NULL)) > 0) {
+        int64_t start = av_gettime_relative();
+
+        ret = run_batch_job(argc, argv, &defaults);
+        for (i = 0; i < argc; i++)
+            av_freep(&argv[i]);
+        av_freep(&argv);
+        if (ret < 0)
+            break;
+
+        report_batch_job(results, nb_jobs++, ret, start);
+        nb_failed += !!ret;
+    }
+    batch_job_running = 0;
+    if (argc < 0)
+        ret = argc;
+    if (ret < 0)
+        av_log(NULL, AV_LOG_FATAL, "Error running the jobs: %s\n", av_err2str(ret));
+    av_log(NULL, AV_LOG_INFO, "%d jobs run, %d failed\n", nb_jobs, nb_failed);
+
+    filter_hw_device = NULL;
+    hw_device_free_all();
+end:
+    uninit_global_options();
+    avio_closep(&results);
+    avio_closep(&jobs);
+    return ret < 0 || nb_failed;
+}
+
+int main(int argc, char **argv)
+{
+    int ret;
+
+    init_dynload();
+
+    register_exit(ffmpeg_cleanup);
+
+    setvbuf(stderr,NULL,_IONBF,0); /* win32 runtime needs this */
+
+    av_log_set_flags(AV_LOG_SKIP_REPEATED);
+    parse_loglevel(argc, argv, options);
+
+    if(argc>1 && !strcmp(argv[1], "-d")){
+        run_as_daemon=1;
+        av_log_set_callback(log_callback_null);
+        argc--;
+        argv++;
+    }
+
+#if CONFIG_AVDEVICE
+    avdevice_register_all();
+#endif
+    avformat_network_init();
+
+    show_banner(argc, argv, options);
+
+    /* the hardware devices of the command line are created by each worker of
+     * a batch, after it is forked */
+    if (locate_option(argc, argv, options, "batch") &&
+        (ret = locate_option(argc, argv, options, "batch_jobs")) && ret + 1 < argc &&
+        strtol(argv[ret + 1], NULL, 0) > 1)
+        batch_defer_hw_devices = 1;
+
+    /* parse options and open all input/output files */
+    ret = ffmpeg_parse_options(argc, argv);
+    if (ret < 0)
+        exit_program(1);
+    batch_defer_hw_devices = 0;
+
+    if (batch_url)
+        exit_program(run_batch());
 
-    exit_program(received_nb_signals ? 255 : main_return_code);
+    exit_program(run_job());
     return main_return_code;
 }
@@ -21,6 +21,7 @@
 
 #include "config.h"
 
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <signal.h>
@@ -75,6 +76,7 @@ typedef struct HWDevice {
     const char *name;
     enum AVHWDeviceType type;
     AVBufferRef *device_ref;
+    char *spec;     /* -init_hw_device argument of a named device */
 } HWDevice;
 
 /* select an input stream for an output stream */
@@ -120,6 +122,8 @@ typedef struct OptionsContext {
     int rate_emu;
     int accurate_seek;
     int thread_queue_size;
+    int64_t thread_queue_bytes;
+    int demux_thread;
 
     SpecifierOpt *ts_scale;
     int        nb_ts_scale;
@@ -206,6 +210,8 @@ typedef struct OptionsContext {
     int        nb_filter_scripts;
     SpecifierOpt *reinit_filters;
     int        nb_reinit_filters;
+    SpecifierOpt *dec_queue_size;
+    int        nb_dec_queue_size;
     SpecifierOpt *fix_sub_duration;
     int        nb_fix_sub_duration;
     SpecifierOpt *canvas_sizes;
@@ -216,6 +222,8 @@ typedef struct OptionsContext {
     int        nb_passlogfiles;
     SpecifierOpt *max_muxing_queue_size;
     int        nb_max_muxing_queue_size;
+    SpecifierOpt *enc_queue_size;
+    int        nb_enc_queue_size;
     SpecifierOpt *guess_layout_max;
     int        nb_guess_layout_max;
     SpecifierOpt *apad;
@@ -254,6 +262,11 @@ typedef struct InputFilter {
     AVBufferRef *hw_frames_ctx;
 
     int eof;
+
+#if HAVE_THREADS
+    /* buffersrc failed requests when the filtering thread last needed input */
+    int nb_failed_requests;
+#endif
 } InputFilter;
 
 typedef struct OutputFilter {
@@ -277,8 +290,23 @@ typedef struct OutputFilter {
     int *formats;
     uint64_t *channel_layouts;
     int *sample_rates;
+
+#if HAVE_THREADS
+    /* frames filtered by the filtering thread, not yet encoded */
+    AVFifoBuffer *frame_queue;
+    int eof;
+#endif
 } OutputFilter;
 
+/* time spent in one stage of the pipeline, for -benchmark_report */
+typedef struct BenchmarkStage {
+    /* added to by the thread running the stage, read by the report */
+    atomic_int_fast64_t real_usec;
+    atomic_int_fast64_t cpu_usec;   /* CPU time of the thread running the stage */
+    int64_t start_real_usec;    /* set by benchmark_stage_start() */
+    int64_t start_cpu_usec;
+} BenchmarkStage;
+
 typedef struct FilterGraph {
     int            index;
     const char    *graph_desc;
@@ -290,8 +318,37 @@ typedef struct FilterGraph {
     int          nb_inputs;
     OutputFilter **outputs;
     int         nb_outputs;
+
+#if HAVE_THREADS
+    /* filtering thread, see filter_queue_size */
+    pthread_t thread;
+    int thread_started;
+    pthread_mutex_t lock;           /* protects the fields below and the output queues */
+    pthread_cond_t cond;
+    AVFifoBuffer *queue;            /* FilterGraphMsg from the decoders */
+    int request;                    /* the graph must be requested for output */
+    int running;                    /* the thread is processing a message or a request */
+    int eof;                        /* all outputs are finished */
+    int abort;
+    int thread_ret;
+#endif
+
+    BenchmarkStage bench_filter;
 } FilterGraph;
 
+/* the decoder context fields read by the main thread, copied by the thread
+ * that decodes the stream along with each frame */
+typedef struct DecoderState {
+    int has_b_frames;
+    int sample_rate;
+    AVRational framerate;
+    int ticks_per_frame;
+    int bits_per_raw_sample;
+    enum AVChromaLocation chroma_sample_location;
+    int width, height;
+    enum AVPixelFormat pix_fmt;
+} DecoderState;
+
 typedef struct InputStream {
     int file_index;
     AVStream *st;
@@ -360,6 +417,26 @@ typedef struct InputStream {
 
     int reinit_filters;
 
+    /* packets queued to the decoder thread, 0 to decode in the main thread */
+    int dec_queue_size;
+    DecoderState dec_state;                 /* as of the last decoded frame */
+#if HAVE_THREADS
+    pthread_t dec_thread;
+    int dec_thread_started;
+    AVThreadMessageQueue *dec_packet_queue; /* packets to decode, an empty packet flushes */
+    AVFifoBuffer *dec_frame_queue;          /* DecodedFrame, in decoding order */
+    pthread_mutex_t dec_lock;               /* protects dec_frame_queue */
+    pthread_cond_t dec_cond;
+    int dec_flushing;                       /* the empty packet was sent */
+    /* timestamps of the last frame returned by the thread, computed as
+     * decode_audio() does for the packet the frame was decoded from */
+    int64_t dec_frame_pkt_pts;
+    int64_t dec_frame_dts;
+    int dec_frame_first;                    /* the first frame of its packet */
+    int dec_frame_retrieve_ret;             /* hwaccel_retrieve_data() error */
+    int dec_thread_saw_dts;                 /* a packet was sent to the thread */
+#endif
+
     /* hwaccel options */
     enum HWAccelID hwaccel_id;
     enum AVHWDeviceType hwaccel_device_type;
@@ -383,6 +460,7 @@ typedef struct InputStream {
     // number of frames/samples retrieved from the decoder
     uint64_t frames_decoded;
     uint64_t samples_decoded;
+    BenchmarkStage bench_decode;
 
     int64_t *dts_buffer;
     int nb_dts_buffer;
@@ -418,7 +496,17 @@ typedef struct InputFile {
     int non_blocking;           /* reading packets from the thread should not block */
     int joined;                 /* the thread has been joined */
     int thread_queue_size;      /* maximum number of queued packets */
+    int64_t thread_queue_bytes; /* maximum size of the queued packets, 0 for no limit */
+    int demux_thread;           /* read in a thread even if this is the only input */
+    /* size of the queued packets, the thread waits on in_thread_cond for it
+     * to drop below thread_queue_bytes if set */
+    int64_t queued_bytes;
+    int in_thread_abort;
+    pthread_mutex_t in_thread_lock;
+    pthread_cond_t  in_thread_cond;
 #endif
+
+    BenchmarkStage bench_demux;
 } InputFile;
 
 enum forced_keyframes_const {
@@ -535,6 +623,11 @@ typedef struct OutputStream {
     // number of frames/samples sent to the encoder
     uint64_t frames_encoded;
     uint64_t samples_encoded;
+    // number of frames dropped/duplicated by the video sync
+    uint64_t frames_dropped;
+    uint64_t frames_duplicated;
+    BenchmarkStage bench_encode;
+    BenchmarkStage bench_mux;
 
     /* packet quality factor */
     int quality;
@@ -544,6 +637,18 @@ typedef struct OutputStream {
     /* the packets are buffered here until the muxer is ready to be initialized */
     AVFifoBuffer *muxing_queue;
 
+    /* frames queued to the encoder thread, 0 to encode in the main thread */
+    int enc_queue_size;
+#if HAVE_THREADS
+    pthread_t enc_thread;
+    int enc_thread_started;
+    AVThreadMessageQueue *enc_frame_queue;  /* frames to encode, NULL flushes */
+    AVFifoBuffer *enc_packet_queue;         /* encoded packets, in order */
+    pthread_mutex_t enc_lock;               /* protects enc_packet_queue and enc_thread_ret */
+    pthread_cond_t enc_cond;
+    int enc_thread_ret;                     /* error, or AVERROR_EOF once flushed */
+#endif
+
     /* packet picture type */
     int pict_type;
 
@@ -590,6 +695,8 @@ extern int video_sync_method;
 extern float frame_drop_threshold;
 extern int do_benchmark;
 extern int do_benchmark_all;
+extern int do_benchmark_report;
+extern float benchmark_report_period;
 extern int do_deinterlace;
 extern int do_hex_dump;
 extern int do_pkt_dump;
@@ -604,12 +711,22 @@ extern int qp_hist;
 extern int stdin_interaction;
 extern int frame_bits_per_raw_sample;
 extern AVIOContext *progress_avio;
+extern AVIOContext *benchmark_report_avio;
 extern float max_error_rate;
 extern char *videotoolbox_pixfmt;
 
 extern int filter_nbthreads;
 extern int filter_complex_nbthreads;
+extern int filter_frame_threads;
+extern int filter_prealloc_frames;
+extern int filter_profile;
+extern int filter_queue_size;
 extern int vstats_version;
+extern char *batch_url;
+extern char *batch_results_url;
+extern int batch_threads;
+extern int batch_jobs;
+extern int batch_defer_hw_devices;
 
 extern const AVIOInterruptCB int_cb;
 
@@ -649,9 +766,29 @@ int init_complex_filtergraph(FilterGraph *fg);
 void sub2video_update(InputStream *ist, AVSubtitle *sub);
 
 int ifilter_parameters_from_frame(InputFilter *ifilter, const AVFrame *frame);
+int ifilter_get_nb_failed_requests(InputFilter *ifilter);
+
+void benchmark_stage_start(BenchmarkStage *s);
+void benchmark_stage_stop(BenchmarkStage *s);
+
+#if HAVE_THREADS
+int filtergraph_thread_start(FilterGraph *fg);
+void filtergraph_thread_stop(FilterGraph *fg);
+int filtergraph_thread_wait(FilterGraph *fg, int input);
+int ifilter_thread_send(InputFilter *ifilter, AVFrame *frame, int64_t eof_pts);
+int ofilter_thread_get_frame(OutputFilter *ofilter, AVFrame *frame);
+int filtergraph_thread_queue_size(FilterGraph *fg);
+#endif
 
 int ffmpeg_parse_options(int argc, char **argv);
 
+int save_global_options(void);
+int restore_global_options(void);
+void uninit_global_options(void);
+int init_batch_hw_devices(void);
+int parse_batch_job(const char *line, char ***argv);
+int read_batch_job(AVIOContext *s, char ***argv, char **line);
+
 int videotoolbox_init(AVCodecContext *s);
 int qsv_init(AVCodecContext *s);
 int cuvid_init(AVCodecContext *s);
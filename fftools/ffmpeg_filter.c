@@ -1009,6 +1009,9 @@ int configure_filtergraph(FilterGraph *fg)
     const char *graph_desc = simple ? fg->outputs[0]->ost->avfilter :
                                       fg->graph_desc;
 
+#if HAVE_THREADS
+    filtergraph_thread_stop(fg);
+#endif
     cleanup_filtergraph(fg);
     if (!(fg->graph = avfilter_graph_alloc()))
         return AVERROR(ENOMEM);
@@ -1052,6 +1055,10 @@ int configure_filtergraph(FilterGraph *fg)
     } else {
         fg->graph->nb_threads = filter_complex_nbthreads;
     }
+    if (filter_frame_threads)
+        fg->graph->thread_type |= AVFILTER_THREAD_FRAME;
+    fg->graph->prealloc_frames = filter_prealloc_frames;
+    fg->graph->profile         = filter_profile;
 
     if ((ret = avfilter_graph_parse2(fg->graph, graph_desc, &inputs, &outputs)) < 0)
         goto fail;
@@ -1218,3 +1225,353 @@ int filtergraph_is_simple(FilterGraph *fg)
 {
     return !fg->graph_desc;
 }
+
+int ifilter_get_nb_failed_requests(InputFilter *ifilter)
+{
+#if HAVE_THREADS
+    FilterGraph *fg = ifilter->graph;
+
+    if (fg->thread_started) {
+        int ret;
+        pthread_mutex_lock(&fg->lock);
+        ret = ifilter->nb_failed_requests;
+        pthread_mutex_unlock(&fg->lock);
+        return ret;
+    }
+#endif
+    return av_buffersrc_get_nb_failed_requests(ifilter->filter);
+}
+
+#if HAVE_THREADS
+typedef struct FilterGraphMsg {
+    int      input;     /* index in FilterGraph.inputs */
+    AVFrame *frame;     /* NULL for EOF */
+    int64_t  eof_pts;
+} FilterGraphMsg;
+
+static int filtergraph_outputs_full(FilterGraph *fg)
+{
+    int i;
+    for (i = 0; i < fg->nb_outputs; i++)
+        if (av_fifo_size(fg->outputs[i]->frame_queue) >=
+            filter_queue_size * sizeof(AVFrame *))
+            return 1;
+    return 0;
+}
+
+/* move the frames available in the buffersinks to the output queues */
+static int filtergraph_thread_pull(FilterGraph *fg)
+{
+    AVFrame *frame = NULL;
+    int i, ret = 0;
+
+    for (i = 0; i < fg->nb_outputs; i++) {
+        OutputFilter *ofilter = fg->outputs[i];
+
+        while (1) {
+            if (!frame && !(frame = av_frame_alloc()))
+                return AVERROR(ENOMEM);
+            ret = av_buffersink_get_frame_flags(ofilter->filter, frame,
+                                                AV_BUFFERSINK_FLAG_NO_REQUEST);
+            if (ret < 0) {
+                if (ret == AVERROR_EOF) {
+                    pthread_mutex_lock(&fg->lock);
+                    ofilter->eof = 1;
+                    pthread_mutex_unlock(&fg->lock);
+                } else if (ret != AVERROR(EAGAIN)) {
+                    av_log(NULL, AV_LOG_WARNING,
+                           "Error in av_buffersink_get_frame_flags(): %s\n", av_err2str(ret));
+                }
+                ret = 0;
+                break;
+            }
+
+            pthread_mutex_lock(&fg->lock);
+            if (av_fifo_space(ofilter->frame_queue) < sizeof(frame))
+                ret = av_fifo_grow(ofilter->frame_queue, av_fifo_size(ofilter->frame_queue));
+            if (ret >= 0) {
+                av_fifo_generic_write(ofilter->frame_queue, &frame, sizeof(frame), NULL);
+                frame = NULL;
+                pthread_cond_signal(&fg->cond);
+            }
+            pthread_mutex_unlock(&fg->lock);
+            if (ret < 0)
+                break;
+        }
+    }
+    av_frame_free(&frame);
+
+    return ret;
+}
+
+static void *filtergraph_thread(void *arg)
+{
+    FilterGraph *fg = arg;
+    FilterGraphMsg msg;
+    int i, ret = 0;
+
+    pthread_mutex_lock(&fg->lock);
+    while (!fg->abort) {
+        int have_msg = 0;
+
+        if (filtergraph_outputs_full(fg) ||
+            (!av_fifo_size(fg->queue) && !fg->request)) {
+            pthread_cond_wait(&fg->cond, &fg->lock);
+            continue;
+        }
+        if (av_fifo_size(fg->queue)) {
+            av_fifo_generic_read(fg->queue, &msg, sizeof(msg), NULL);
+            have_msg = 1;
+        }
+        fg->request = 0;
+        fg->running = 1;
+        pthread_cond_signal(&fg->cond);
+        pthread_mutex_unlock(&fg->lock);
+
+        benchmark_stage_start(&fg->bench_filter);
+        if (have_msg) {
+            InputFilter *ifilter = fg->inputs[msg.input];
+
+            if (msg.frame) {
+                ret = av_buffersrc_add_frame_flags(ifilter->filter, msg.frame,
+                                                   AV_BUFFERSRC_FLAG_PUSH);
+                av_frame_free(&msg.frame);
+            } else {
+                ret = av_buffersrc_close(ifilter->filter, msg.eof_pts,
+                                         AV_BUFFERSRC_FLAG_PUSH);
+            }
+            /* fatal, as it is for ifilter_send_frame() in the main thread */
+            if (ret < 0 && ret != AVERROR_EOF)
+                av_log(NULL, AV_LOG_ERROR, "Error while filtering: %s\n", av_err2str(ret));
+            else
+                ret = 0;
+        }
+
+        /* same as transcode_from_filter() in the main thread */
+        if (ret >= 0) {
+            ret = avfilter_graph_request_oldest(fg->graph);
+            if (ret >= 0 || ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+                int err = filtergraph_thread_pull(fg);
+                if (err < 0)
+                    ret = err;
+            }
+        }
+        benchmark_stage_stop(&fg->bench_filter);
+
+        pthread_mutex_lock(&fg->lock);
+        fg->running = 0;
+        /* adding a frame resets the count, so refresh it after every run */
+        for (i = 0; i < fg->nb_inputs; i++)
+            fg->inputs[i]->nb_failed_requests =
+                av_buffersrc_get_nb_failed_requests(fg->inputs[i]->filter);
+        if (ret >= 0) {
+            fg->request = 1;
+        } else if (ret == AVERROR_EOF) {
+            fg->eof = 1;
+        } else if (ret != AVERROR(EAGAIN)) {
+            fg->thread_ret = ret;
+            pthread_cond_signal(&fg->cond);
+            break;
+        }
+        pthread_cond_signal(&fg->cond);
+    }
+    pthread_mutex_unlock(&fg->lock);
+
+    return NULL;
+}
+
+int filtergraph_thread_start(FilterGraph *fg)
+{
+    int i, ret;
+
+    if (filter_queue_size <= 0 || fg->thread_started || !fg->graph)
+        return 0;
+    /* the encoders set the buffersink frame size when they are initialized */
+    for (i = 0; i < fg->nb_outputs; i++)
+        if (!fg->outputs[i]->ost->initialized)
+            return 0;
+
+    fg->queue = av_fifo_alloc(filter_queue_size * sizeof(FilterGraphMsg));
+    if (!fg->queue)
+        goto fail;
+    for (i = 0; i < fg->nb_outputs; i++) {
+        fg->outputs[i]->frame_queue = av_fifo_alloc(filter_queue_size * sizeof(AVFrame *));
+        if (!fg->outputs[i]->frame_queue)
+            goto fail;
+        fg->outputs[i]->eof = 0;
+    }
+    for (i = 0; i < fg->nb_inputs; i++)
+        fg->inputs[i]->nb_failed_requests = 0;
+    fg->request    = 1;
+    fg->running    = 0;
+    fg->eof        = 0;
+    fg->abort      = 0;
+    fg->thread_ret = 0;
+    pthread_mutex_init(&fg->lock, NULL);
+    pthread_cond_init(&fg->cond, NULL);
+
+    if ((ret = pthread_create(&fg->thread, NULL, filtergraph_thread, fg))) {
+        av_log(NULL, AV_LOG_ERROR, "pthread_create failed: %s. Try to increase `ulimit -v` or decrease `ulimit -s`.\n", strerror(ret));
+        pthread_cond_destroy(&fg->cond);
+        pthread_mutex_destroy(&fg->lock);
+        ret = AVERROR(ret);
+        goto fail_free;
+    }
+    fg->thread_started = 1;
+
+    return 0;
+fail:
+    ret = AVERROR(ENOMEM);
+fail_free:
+    av_fifo_freep(&fg->queue);
+    for (i = 0; i < fg->nb_outputs; i++)
+        av_fifo_freep(&fg->outputs[i]->frame_queue);
+    return ret;
+}
+
+void filtergraph_thread_stop(FilterGraph *fg)
+{
+    int i;
+
+    if (!fg->thread_started)
+        return;
+
+    pthread_mutex_lock(&fg->lock);
+    fg->abort = 1;
+    pthread_cond_signal(&fg->cond);
+    pthread_mutex_unlock(&fg->lock);
+    pthread_join(fg->thread, NULL);
+    fg->thread_started = 0;
+
+    while (av_fifo_size(fg->queue)) {
+        FilterGraphMsg msg;
+        av_fifo_generic_read(fg->queue, &msg, sizeof(msg), NULL);
+        av_frame_free(&msg.frame);
+    }
+    av_fifo_freep(&fg->queue);
+    for (i = 0; i < fg->nb_outputs; i++) {
+        OutputFilter *ofilter = fg->outputs[i];
+        while (av_fifo_size(ofilter->frame_queue)) {
+            AVFrame *frame;
+            av_fifo_generic_read(ofilter->frame_queue, &frame, sizeof(frame), NULL);
+            av_frame_free(&frame);
+        }
+        av_fifo_freep(&ofilter->frame_queue);
+    }
+    pthread_cond_destroy(&fg->cond);
+    pthread_mutex_destroy(&fg->lock);
+}
+
+/**
+ * Wait for the filtering thread of fg.
+ *
+ * @param input wait for room in the input queue instead of the thread
+ *              running out of work
+ * @return 0 if filtered frames are available, AVERROR(EAGAIN) once the
+ *         thread can take input, AVERROR_EOF if all the outputs are
+ *         finished, another negative error code if filtering failed
+ */
+int filtergraph_thread_wait(FilterGraph *fg, int input)
+{
+    int i, ret;
+
+    pthread_mutex_lock(&fg->lock);
+    while (1) {
+        int idle = !av_fifo_size(fg->queue) && !fg->request && !fg->running;
+
+        ret = fg->thread_ret;
+        if (ret < 0)
+            break;
+        for (i = 0; i < fg->nb_outputs; i++)
+            if (av_fifo_size(fg->outputs[i]->frame_queue))
+                break;
+        if (i < fg->nb_outputs)
+            break;
+        if (idle && fg->eof) {
+            ret = AVERROR_EOF;
+            break;
+        }
+        if (idle || (input && av_fifo_space(fg->queue) >= sizeof(FilterGraphMsg))) {
+            ret = AVERROR(EAGAIN);
+            break;
+        }
+        pthread_cond_wait(&fg->cond, &fg->lock);
+    }
+    pthread_mutex_unlock(&fg->lock);
+
+    return ret;
+}
+
+/**
+ * Queue a reference to frame, or EOF if frame is NULL, to the filtering
+ * thread.
+ *
+ * @return 0 on success, AVERROR(EAGAIN) if the queue is full
+ */
+int ifilter_thread_send(InputFilter *ifilter, AVFrame *frame, int64_t eof_pts)
+{
+    FilterGraph *fg = ifilter->graph;
+    FilterGraphMsg msg = { 0 };
+    int ret = 0;
+
+    for (msg.input = 0; fg->inputs[msg.input] != ifilter; msg.input++);
+    msg.eof_pts = eof_pts;
+    if (frame && !(msg.frame = av_frame_clone(frame)))
+        return AVERROR(ENOMEM);
+
+    pthread_mutex_lock(&fg->lock);
+    if (fg->thread_ret < 0) {
+        ret = fg->thread_ret;
+    } else if (av_fifo_space(fg->queue) < sizeof(msg)) {
+        ret = AVERROR(EAGAIN);
+    } else {
+        av_fifo_generic_write(fg->queue, &msg, sizeof(msg), NULL);
+        pthread_cond_signal(&fg->cond);
+    }
+    pthread_mutex_unlock(&fg->lock);
+
+    if (ret < 0)
+        av_frame_free(&msg.frame);
+    return ret;
+}
+
+/**
+ * Get a frame filtered by the thread, the counterpart of
+ * av_buffersink_get_frame_flags() with AV_BUFFERSINK_FLAG_NO_REQUEST.
+ */
+int ofilter_thread_get_frame(OutputFilter *ofilter, AVFrame *frame)
+{
+    FilterGraph *fg = ofilter->graph;
+    AVFrame *tmp;
+    int ret = 0;
+
+    pthread_mutex_lock(&fg->lock);
+    if (av_fifo_size(ofilter->frame_queue)) {
+        av_fifo_generic_read(ofilter->frame_queue, &tmp, sizeof(tmp), NULL);
+        av_frame_move_ref(frame, tmp);
+        av_frame_free(&tmp);
+        /* there is room again, try to get more output */
+        fg->request = 1;
+        pthread_cond_signal(&fg->cond);
+    } else {
+        ret = ofilter->eof ? AVERROR_EOF : AVERROR(EAGAIN);
+    }
+    pthread_mutex_unlock(&fg->lock);
+
+    return ret;
+}
+
+/**
+ * Number of frames and EOFs queued for the thread.
+ */
+int filtergraph_thread_queue_size(FilterGraph *fg)
+{
+    int nb;
+
+    pthread_mutex_lock(&fg->lock);
+    nb = av_fifo_size(fg->queue) / sizeof(FilterGraphMsg);
+    pthread_mutex_unlock(&fg->lock);
+
+    return nb;
+}
+#endif
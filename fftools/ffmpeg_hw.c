@@ -129,7 +129,15 @@ int hw_device_init_from_string(const char *arg, HWDevice **dev_out)
             err = AVERROR(ENOMEM);
             goto fail;
         }
-        if (hw_device_get_by_name(name)) {
+        dev = hw_device_get_by_name(name);
+        if (dev) {
+            /* the same device given again, e.g. by every job of a batch */
+            if (dev->spec && !strcmp(dev->spec, arg)) {
+                if (dev_out)
+                    *dev_out = dev;
+                err = 0;
+                goto done;
+            }
             errmsg = "named device already exists";
             goto invalid;
         }
@@ -202,6 +210,8 @@ int hw_device_init_from_string(const char *arg, HWDevice **dev_out)
     dev->name = name;
     dev->type = type;
     dev->device_ref = device_ref;
+    if (arg[strcspn(arg, ":=@")] == '=')
+        dev->spec = av_strdup(arg);
 
     if (dev_out)
         *dev_out = dev;
@@ -274,6 +284,7 @@ void hw_device_free_all(void)
     int i;
     for (i = 0; i < nb_hw_devices; i++) {
         av_freep(&hw_devices[i]->name);
+        av_freep(&hw_devices[i]->spec);
         av_buffer_unref(&hw_devices[i]->device_ref);
         av_freep(&hw_devices[i]);
     }
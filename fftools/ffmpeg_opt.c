@@ -33,6 +33,7 @@
 #include "libavutil/avstring.h"
 #include "libavutil/avutil.h"
 #include "libavutil/channel_layout.h"
+#include "libavutil/cpu.h"
 #include "libavutil/intreadwrite.h"
 #include "libavutil/fifo.h"
 #include "libavutil/mathematics.h"
@@ -94,6 +95,8 @@ float frame_drop_threshold = 0;
 int do_deinterlace    = 0;
 int do_benchmark      = 0;
 int do_benchmark_all  = 0;
+int do_benchmark_report = 0;
+float benchmark_report_period = 1;
 int do_hex_dump       = 0;
 int do_pkt_dump       = 0;
 int copy_ts           = 0;
@@ -109,7 +112,21 @@ int frame_bits_per_raw_sample = 0;
 float max_error_rate  = 2.0/3;
 int filter_nbthreads = 0;
 int filter_complex_nbthreads = 0;
+int filter_frame_threads = 0;
+int filter_prealloc_frames = 0;
+int filter_profile = 0;
+int filter_queue_size = 0;
 int vstats_version = 2;
+char *batch_url;
+char *batch_results_url;
+int batch_threads = 0;
+int batch_jobs = 1;
+int batch_defer_hw_devices = 0;
+
+/* hardware devices of the command line created by each worker of a batch */
+static char **batch_hw_devices;
+static int nb_batch_hw_devices;
+static char *batch_filter_hw_device;
 
 
 static int intra_only         = 0;
@@ -505,6 +522,15 @@ static int opt_init_hw_device(void *optctx, const char *opt, const char *arg)
             printf("%s\n", av_hwdevice_get_type_name(type));
         printf("\n");
         exit_program(0);
+    } else if (batch_defer_hw_devices) {
+        char *spec = av_strdup(arg);
+        int ret;
+
+        if (!spec)
+            return AVERROR(ENOMEM);
+        if ((ret = av_dynarray_add_nofree(&batch_hw_devices, &nb_batch_hw_devices, spec)) < 0)
+            av_free(spec);
+        return ret;
     } else {
         return hw_device_init_from_string(arg, NULL);
     }
@@ -512,10 +538,14 @@ static int opt_init_hw_device(void *optctx, const char *opt, const char *arg)
 
 static int opt_filter_hw_device(void *optctx, const char *opt, const char *arg)
 {
-    if (filter_hw_device) {
+    if (filter_hw_device || batch_filter_hw_device) {
         av_log(NULL, AV_LOG_ERROR, "Only one filter device can be used.\n");
         return AVERROR(EINVAL);
     }
+    if (batch_defer_hw_devices) {
+        batch_filter_hw_device = av_strdup(arg);
+        return batch_filter_hw_device ? 0 : AVERROR(ENOMEM);
+    }
     filter_hw_device = hw_device_get_by_name(arg);
     if (!filter_hw_device) {
         av_log(NULL, AV_LOG_ERROR, "Invalid filter device %s.\n", arg);
@@ -758,6 +788,8 @@ static void add_input_streams(OptionsContext *o, AVFormatContext *ic)
         ist->reinit_filters = -1;
         MATCH_PER_STREAM_OPT(reinit_filters, i, ist->reinit_filters, ic, st);
 
+        MATCH_PER_STREAM_OPT(dec_queue_size, i, ist->dec_queue_size, ic, st);
+
         MATCH_PER_STREAM_OPT(discard, str, discard_str, ic, st);
         ist->user_set_discard = AVDISCARD_NONE;
 
@@ -1211,7 +1243,12 @@ static int open_input_file(OptionsContext *o, const char *filename)
     f->duration = 0;
     f->time_base = (AVRational){ 1, 1 };
 #if HAVE_THREADS
-    f->thread_queue_size = o->thread_queue_size > 0 ? o->thread_queue_size : 8;
+    /* with a size limit the packet count only bounds the queue allocation,
+     * so that low bitrate inputs are still read far enough ahead */
+    f->thread_queue_size = o->thread_queue_size > 0 ? o->thread_queue_size :
+                           o->thread_queue_bytes > 0 ? 4096 : 8;
+    f->thread_queue_bytes = FFMAX(o->thread_queue_bytes, 0);
+    f->demux_thread = o->demux_thread;
 #endif
 
     /* check if all codec options have been used */
@@ -1543,6 +1580,8 @@ static OutputStream *new_output_stream(OptionsContext *o, AVFormatContext *oc, e
     MATCH_PER_STREAM_OPT(max_muxing_queue_size, i, ost->max_muxing_queue_size, oc, st);
     ost->max_muxing_queue_size *= sizeof(AVPacket);
 
+    MATCH_PER_STREAM_OPT(enc_queue_size, i, ost->enc_queue_size, oc, st);
+
     if (oc->oformat->flags & AVFMT_GLOBALHEADER)
         ost->enc_ctx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 
@@ -3285,6 +3324,246 @@ static int open_files(OptionGroupList *l, const char *inout,
     return 0;
 }
 
+typedef union GlobalOptionValue {
+    int      i;
+    int64_t  i64;
+    float    f;
+    double   dbl;
+    char    *str;
+} GlobalOptionValue;
+
+/* values of the options stored in global variables, see save_global_options() */
+static GlobalOptionValue *global_option_values;
+
+/* the state set by the global options handled by a function */
+static struct {
+    int video_sync_method;
+    int abort_on_flags;
+    char *vstats_filename;
+    AVBufferRef *hw_device_ctx;
+    AVIOContext *progress_avio;
+    AVIOContext *benchmark_report_avio;
+    int do_benchmark_report;
+    int cpu_flags;
+} global_option_state;
+
+static int is_global_option_var(const OptionDef *po)
+{
+    return !(po->flags & (OPT_OFFSET | OPT_SPEC)) &&
+           po->flags & (OPT_BOOL | OPT_INT | OPT_INT64 | OPT_FLOAT |
+                        OPT_DOUBLE | OPT_TIME | OPT_STRING);
+}
+
+/**
+ * Save the values of the global options, so that they can be restored
+ * before each job of a batch.
+ */
+int save_global_options(void)
+{
+    const OptionDef *po;
+    GlobalOptionValue *v;
+
+    for (po = options; po->name; po++);
+    global_option_values = av_mallocz_array(po - options, sizeof(*global_option_values));
+    if (!global_option_values)
+        return AVERROR(ENOMEM);
+
+    for (po = options, v = global_option_values; po->name; po++, v++) {
+        if (!is_global_option_var(po))
+            continue;
+        if (po->flags & OPT_STRING) {
+            char *str = *(char **)po->u.dst_ptr;
+            if (str && !(v->str = av_strdup(str)))
+                return AVERROR(ENOMEM);
+        } else if (po->flags & (OPT_BOOL | OPT_INT)) {
+            v->i   = *(int *)po->u.dst_ptr;
+        } else if (po->flags & (OPT_INT64 | OPT_TIME)) {
+            v->i64 = *(int64_t *)po->u.dst_ptr;
+        } else if (po->flags & OPT_FLOAT) {
+            v->f   = *(float *)po->u.dst_ptr;
+        } else {
+            v->dbl = *(double *)po->u.dst_ptr;
+        }
+    }
+
+    global_option_state.video_sync_method     = video_sync_method;
+    global_option_state.abort_on_flags        = abort_on_flags;
+    global_option_state.progress_avio         = progress_avio;
+    global_option_state.benchmark_report_avio = benchmark_report_avio;
+    global_option_state.do_benchmark_report   = do_benchmark_report;
+    global_option_state.cpu_flags             = av_get_cpu_flags();
+    if (vstats_filename &&
+        !(global_option_state.vstats_filename = av_strdup(vstats_filename)))
+        return AVERROR(ENOMEM);
+    if (hw_device_ctx &&
+        !(global_option_state.hw_device_ctx = av_buffer_ref(hw_device_ctx)))
+        return AVERROR(ENOMEM);
+    return 0;
+}
+
+/**
+ * Restore the global options saved by save_global_options(), undoing the
+ * options of the previous job.
+ */
+int restore_global_options(void)
+{
+    const OptionDef *po;
+    GlobalOptionValue *v;
+
+    for (po = options, v = global_option_values; po->name; po++, v++) {
+        if (!is_global_option_var(po))
+            continue;
+        if (po->flags & OPT_STRING) {
+            char **dst = po->u.dst_ptr;
+            av_freep(dst);
+            if (v->str && !(*dst = av_strdup(v->str)))
+                return AVERROR(ENOMEM);
+        } else if (po->flags & (OPT_BOOL | OPT_INT)) {
+            *(int *)po->u.dst_ptr     = v->i;
+        } else if (po->flags & (OPT_INT64 | OPT_TIME)) {
+            *(int64_t *)po->u.dst_ptr = v->i64;
+        } else if (po->flags & OPT_FLOAT) {
+            *(float *)po->u.dst_ptr   = v->f;
+        } else {
+            *(double *)po->u.dst_ptr  = v->dbl;
+        }
+    }
+    input_stream_potentially_available = 0;
+    av_freep(&sdp_filename);
+
+    video_sync_method = global_option_state.video_sync_method;
+    abort_on_flags    = global_option_state.abort_on_flags;
+    av_force_cpu_flags(global_option_state.cpu_flags);
+    /* the urls given by the previous job are closed, those of the batch kept */
+    if (progress_avio != global_option_state.progress_avio)
+        avio_closep(&progress_avio);
+    progress_avio = global_option_state.progress_avio;
+    if (benchmark_report_avio != global_option_state.benchmark_report_avio)
+        avio_closep(&benchmark_report_avio);
+    benchmark_report_avio = global_option_state.benchmark_report_avio;
+    do_benchmark_report   = global_option_state.do_benchmark_report;
+    av_freep(&vstats_filename);
+    if (global_option_state.vstats_filename &&
+        !(vstats_filename = av_strdup(global_option_state.vstats_filename)))
+        return AVERROR(ENOMEM);
+    av_buffer_unref(&hw_device_ctx);
+    if (global_option_state.hw_device_ctx &&
+        !(hw_device_ctx = av_buffer_ref(global_option_state.hw_device_ctx)))
+        return AVERROR(ENOMEM);
+    return 0;
+}
+
+void uninit_global_options(void)
+{
+    const OptionDef *po;
+    GlobalOptionValue *v;
+
+    if (!global_option_values)
+        return;
+    for (po = options, v = global_option_values; po->name; po++, v++)
+        if (is_global_option_var(po) && po->flags & OPT_STRING)
+            av_freep(&v->str);
+    av_freep(&global_option_values);
+
+    if (progress_avio != global_option_state.progress_avio)
+        avio_closep(&progress_avio);
+    if (benchmark_report_avio != global_option_state.benchmark_report_avio)
+        avio_closep(&benchmark_report_avio);
+    avio_closep(&global_option_state.progress_avio);
+    avio_closep(&global_option_state.benchmark_report_avio);
+    progress_avio = benchmark_report_avio = NULL;
+    av_freep(&global_option_state.vstats_filename);
+    av_buffer_unref(&global_option_state.hw_device_ctx);
+
+    while (nb_batch_hw_devices > 0)
+        av_freep(&batch_hw_devices[--nb_batch_hw_devices]);
+    av_freep(&batch_hw_devices);
+    av_freep(&batch_filter_hw_device);
+}
+
+/**
+ * Create the hardware devices of the command line left to the workers of a
+ * batch, see batch_defer_hw_devices.
+ */
+int init_batch_hw_devices(void)
+{
+    int i, ret;
+
+    for (i = 0; i < nb_batch_hw_devices; i++)
+        if ((ret = hw_device_init_from_string(batch_hw_devices[i], NULL)) < 0)
+            return ret;
+    if (batch_filter_hw_device) {
+        filter_hw_device = hw_device_get_by_name(batch_filter_hw_device);
+        if (!filter_hw_device) {
+            av_log(NULL, AV_LOG_ERROR, "Invalid filter device %s.\n",
+                   batch_filter_hw_device);
+            return AVERROR(EINVAL);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Split a job of a batch into its arguments. Empty lines and lines starting
+ * with '#' hold no job, arguments are separated by spaces and may be quoted
+ * or escaped as in av_get_token().
+ *
+ * @return the number of arguments in argv, argv[0] being the program name,
+ *         0 if the line holds no job or a negative AVERROR
+ */
+int parse_batch_job(const char *line, char ***argv)
+{
+    const char *p = line + strspn(line, " \t\r");
+    char *tok;
+    int argc = 0, ret = 0;
+
+    *argv = NULL;
+    if (!*p || *p == '#')
+        return 0;
+
+    ret = av_dynarray_add_nofree(argv, &argc, av_strdup(program_name));
+    while (ret >= 0 && *(p += strspn(p, " \t\r"))) {
+        tok = av_get_token(&p, " \t\r");
+        if (!tok || (ret = av_dynarray_add_nofree(argv, &argc, tok)) < 0) {
+            av_free(tok);
+            ret = AVERROR(ENOMEM);
+        }
+    }
+    if (ret >= 0 && (ret = av_dynarray_add_nofree(argv, &argc, NULL)) >= 0)
+        return argc - 1;
+
+    while (argc--)
+        av_freep(&(*argv)[argc]);
+    av_freep(argv);
+    return ret;
+}
+
+/**
+ * Read the next job of a batch, one command line per line, see
+ * parse_batch_job().
+ *
+ * @param line if not NULL, set to the line of the job, to be freed by the
+ *             caller
+ * @return the number of arguments in argv, 0 at the end of the jobs or a
+ *         negative AVERROR
+ */
+int read_batch_job(AVIOContext *s, char ***argv, char **line)
+{
+    char *buf;
+    int argc = 0;
+
+    *argv = NULL;
+    while (!argc && !avio_feof(s)) {
+        buf = (char *)get_line(s);
+        argc = parse_batch_job(buf, argv);
+        if (argc > 0 && line)
+            *line = buf;
+        else
+            av_free(buf);
+    }
+    return argc;
+}
+
 int ffmpeg_parse_options(int argc, char **argv)
 {
     OptionParseContext octx;
@@ -3360,6 +3639,27 @@ static int opt_progress(void *optctx, const char *opt, const char *arg)
     return 0;
 }
 
+static int opt_benchmark_report(void *optctx, const char *opt, const char *arg)
+{
+    AVIOContext *avio = NULL;
+    int ret;
+
+    if (!strcmp(arg, "-"))
+        arg = "pipe:";
+    ret = avio_open2(&avio, arg, AVIO_FLAG_WRITE, &int_cb, NULL);
+    if (ret < 0) {
+        av_log(NULL, AV_LOG_ERROR, "Failed to open benchmark report URL \"%s\": %s\n",
+               arg, av_err2str(ret));
+        return ret;
+    }
+    /* the report of a batch is kept when a job gives its own */
+    if (benchmark_report_avio != global_option_state.benchmark_report_avio)
+        avio_closep(&benchmark_report_avio);
+    benchmark_report_avio = avio;
+    do_benchmark_report = 1;
+    return 0;
+}
+
 #define OFFSET(x) offsetof(OptionsContext, x)
 const OptionDef options[] = {
     /* main options */
@@ -3436,6 +3736,10 @@ const OptionDef options[] = {
         "add timings for benchmarking" },
     { "benchmark_all",  OPT_BOOL | OPT_EXPERT,                       { &do_benchmark_all },
       "add timings for each task" },
+    { "benchmark_report", HAS_ARG | OPT_EXPERT,                      { .func_arg = opt_benchmark_report },
+      "write the time spent in each stage as JSON", "url" },
+    { "benchmark_report_period", HAS_ARG | OPT_FLOAT | OPT_EXPERT,   { &benchmark_report_period },
+      "set the period of the benchmark reports, 0 for the final one only", "seconds" },
     { "progress",       HAS_ARG | OPT_EXPERT,                        { .func_arg = opt_progress },
       "write program-readable progress information", "url" },
     { "stdin",          OPT_BOOL | OPT_EXPERT,                       { &stdin_interaction },
@@ -3513,6 +3817,22 @@ const OptionDef options[] = {
         "create a complex filtergraph", "graph_description" },
     { "filter_complex_threads", HAS_ARG | OPT_INT,                   { &filter_complex_nbthreads },
         "number of threads for -filter_complex" },
+    { "filter_frame_threads", OPT_BOOL | OPT_EXPERT,                 { &filter_frame_threads },
+        "run independent filters of a filtergraph concurrently" },
+    { "filter_prealloc_frames", HAS_ARG | OPT_INT | OPT_EXPERT,      { &filter_prealloc_frames },
+        "number of frame buffers allocated up front for each link of a filtergraph", "frames" },
+    { "filter_profile", OPT_BOOL | OPT_EXPERT,                       { &filter_profile },
+        "print the time spent in each filter at the end" },
+    { "filter_queue_size", HAS_ARG | OPT_INT | OPT_EXPERT,           { &filter_queue_size },
+        "run each filtergraph in a separate thread fed by a queue of this many frames", "frames" },
+    { "batch",          HAS_ARG | OPT_STRING | OPT_EXPERT,           { &batch_url },
+        "run the jobs read from url, one command line per line", "url" },
+    { "batch_results",  HAS_ARG | OPT_STRING | OPT_EXPERT,           { &batch_results_url },
+        "write the result of each job of a batch to url", "url" },
+    { "batch_jobs",     HAS_ARG | OPT_INT | OPT_EXPERT,              { &batch_jobs },
+        "set the number of jobs of a batch run at once", "number" },
+    { "batch_threads",  HAS_ARG | OPT_INT | OPT_EXPERT,              { &batch_threads },
+        "set the number of codec and filter threads shared by the jobs of a batch", "number" },
     { "lavfi",          HAS_ARG | OPT_EXPERT,                        { .func_arg = opt_filter_complex },
         "create a complex filtergraph", "graph_description" },
     { "filter_complex_script", HAS_ARG | OPT_EXPERT,                 { .func_arg = opt_filter_complex_script },
@@ -3537,9 +3857,16 @@ const OptionDef options[] = {
     { "disposition",    OPT_STRING | HAS_ARG | OPT_SPEC |
                         OPT_OUTPUT,                                  { .off = OFFSET(disposition) },
         "disposition", "" },
+    { "dec_queue_size", HAS_ARG | OPT_INT | OPT_SPEC | OPT_EXPERT | OPT_INPUT, { .off = OFFSET(dec_queue_size) },
+        "decode in a separate thread fed by a queue of this many packets", "packets" },
     { "thread_queue_size", HAS_ARG | OPT_INT | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
                                                                      { .off = OFFSET(thread_queue_size) },
         "set the maximum number of queued packets from the demuxer" },
+    { "thread_queue_bytes", HAS_ARG | OPT_INT64 | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
+                                                                     { .off = OFFSET(thread_queue_bytes) },
+        "set the maximum size of the queued packets from the demuxer", "bytes" },
+    { "demux_thread",   OPT_BOOL | OPT_OFFSET | OPT_EXPERT | OPT_INPUT, { .off = OFFSET(demux_thread) },
+        "read the input in a separate thread even if it is the only input" },
     { "find_stream_info", OPT_BOOL | OPT_PERFILE | OPT_INPUT | OPT_EXPERT, { &find_stream_info },
         "read and decode the streams to fill missing information with heuristics" },
 
@@ -3726,6 +4053,8 @@ const OptionDef options[] = {
 
     { "max_muxing_queue_size", HAS_ARG | OPT_INT | OPT_SPEC | OPT_EXPERT | OPT_OUTPUT, { .off = OFFSET(max_muxing_queue_size) },
         "maximum number of packets that can be buffered while waiting for all streams to initialize", "packets" },
+    { "enc_queue_size", HAS_ARG | OPT_INT | OPT_SPEC | OPT_EXPERT | OPT_OUTPUT, { .off = OFFSET(enc_queue_size) },
+        "encode in a separate thread fed by a queue of this many frames", "frames" },
 
     /* data codec support */
     { "dcodec", HAS_ARG | OPT_DATA | OPT_PERFILE | OPT_EXPERT | OPT_INPUT | OPT_OUTPUT, { .func_arg = opt_data_codec },
@@ -19,6 +19,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include "libavutil/bprint.h"
+#include "libavutil/hwcontext_vpe_internal.h"
+#include "libavutil/time.h"
+
 #include "internal.h"
 #include "vpe_dec_common.h"
 
@@ -75,8 +79,9 @@ error:
 /**
  * Notify the external decoder to release frame buffer
  */
-static void vpe_decode_picture_consume(VpeDecCtx *dec_ctx, VpiFrame *vpi_frame)
+static void vpe_decode_picture_consume(void *opaque, VpiFrame *vpi_frame)
 {
+    VpeDecCtx *dec_ctx = opaque;
     VpiCtrlCmdParam cmd_param;
 
     // make decoder release DPB
@@ -89,8 +94,6 @@ int ff_vpe_decode_init(AVCodecContext *avctx, VpiPlugin type)
 {
     AVHWFramesContext *hwframe_ctx;
     AVVpeFramesContext *vpeframe_ctx;
-    AVHWDeviceContext *hwdevice_ctx;
-    AVVpeDeviceContext *vpedev_ctx;
     VpeDecCtx *dec_ctx = (VpeDecCtx *)avctx->priv_data;
     VpiCtrlCmdParam cmd_param;
     int ret;
@@ -104,16 +107,15 @@ int ff_vpe_decode_init(AVCodecContext *avctx, VpiPlugin type)
 
     hwframe_ctx  = (AVHWFramesContext *)avctx->hw_frames_ctx->data;
     vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
-    hwdevice_ctx = (AVHWDeviceContext *)avctx->hw_device_ctx->data;
-    vpedev_ctx   = (AVVpeDeviceContext *)hwdevice_ctx->hwctx;
 
-    // Create the VPE context
-    ret = vpi_create(&dec_ctx->ctx, &dec_ctx->vpi, vpedev_ctx->device, type);
+    // Create the VPE context on the device the frames were placed on
+    ret = vpi_create(&dec_ctx->ctx, &dec_ctx->vpi, vpeframe_ctx->device, type);
     if (ret) {
         av_log(avctx, AV_LOG_ERROR, "vpi create failure error=%s(%d)\n",
                vpi_error_str(ret), ret);
         return AVERROR_EXTERNAL;
     }
+    avpriv_vpe_device_session_add(hwframe_ctx, 1);
 
     // get the decoder init option struct
     cmd_param.cmd = VPI_CMD_DEC_INIT_OPTION;
@@ -156,96 +158,67 @@ int ff_vpe_decode_init(AVCodecContext *avctx, VpiPlugin type)
  */
 static void vpe_clear_unused_frames(VpeDecCtx *dec_ctx)
 {
-    VpeDecFrame *cur_frame = dec_ctx->frame_list;
-
-    while (cur_frame) {
-        if (cur_frame->used
-            && !cur_frame->vpi_frame->locked) {
-            vpe_decode_picture_consume(dec_ctx, cur_frame->vpi_frame);
-            cur_frame->used = 0;
-            av_frame_unref(cur_frame->av_frame);
-        }
-        cur_frame = cur_frame->next;
-    }
+    avpriv_vpe_frame_pool_release_unlocked(&dec_ctx->frame_pool,
+                                           vpe_decode_picture_consume, dec_ctx);
 }
 
 /**
- * alloc frame from hwcontext for external codec
+ * get frame from the frame pool
  */
-static int vpe_alloc_frame(AVCodecContext *avctx, VpeDecFrame *dec_frame)
+static int vpe_get_frame(AVCodecContext *avctx, VpiFrame **vpi_frame)
 {
+    VpeDecCtx *dec_ctx = (VpeDecCtx *)avctx->priv_data;
+    VpeFramePoolEntry *entry;
     int ret;
 
-    ret = ff_get_buffer(avctx, dec_frame->av_frame, AV_GET_BUFFER_FLAG_REF);
+    vpe_clear_unused_frames(dec_ctx);
+
+    ret = avpriv_vpe_frame_pool_get(&dec_ctx->frame_pool, &entry);
+    if (ret < 0)
+        return ret;
+
+    ret = ff_get_buffer(avctx, entry->frame, AV_GET_BUFFER_FLAG_REF);
     if (ret < 0) {
         av_log(avctx, AV_LOG_ERROR, "return ret %d\n", ret);
+        avpriv_vpe_frame_pool_release(&dec_ctx->frame_pool, entry);
         return ret;
     }
+    avpriv_vpe_frame_pool_publish(&dec_ctx->frame_pool, entry);
 
-    dec_frame->vpi_frame = (VpiFrame*)dec_frame->av_frame->data[0];
-    dec_frame->used      = 1;
+    *vpi_frame = entry->vpi_frame;
 
     return 0;
 }
 
 /**
- * get frame from the linked list
+ * List the low_res pictures of the decoded frames as "index:wxh", in the
+ * frame metadata, the index to give to av_vpe_frame_ref_output()
  */
-static int vpe_get_frame(AVCodecContext *avctx, VpiFrame **vpi_frame)
+static void vpe_export_low_res(AVCodecContext *avctx, AVFrame *frame)
 {
     VpeDecCtx *dec_ctx = (VpeDecCtx *)avctx->priv_data;
-    VpeDecFrame *dec_frame, **last;
-    int ret;
+    AVHWFramesContext *hwframe_ctx;
+    AVVpeFramesContext *vpeframe_ctx;
+    VpiPicInfo *pic_info;
+    AVBPrint bp;
+    int i;
 
-    vpe_clear_unused_frames(dec_ctx);
+    if (!dec_ctx->low_res_list) {
+        hwframe_ctx  = (AVHWFramesContext *)avctx->hw_frames_ctx->data;
+        vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
 
-    dec_frame = dec_ctx->frame_list;
-    last      = &dec_ctx->frame_list;
-    while (dec_frame) {
-        if (!dec_frame->used) {
-            ret = vpe_alloc_frame(avctx, dec_frame);
-            if (ret < 0)
-                return ret;
-            *vpi_frame = dec_frame->vpi_frame;
-            return 0;
+        av_bprint_init(&bp, 0, AV_BPRINT_SIZE_AUTOMATIC);
+        for (i = 1; i < PIC_INDEX_MAX_NUMBER; i++) {
+            pic_info = &vpeframe_ctx->frame->pic_info[i];
+            if (pic_info->enabled && !pic_info->flag)
+                av_bprintf(&bp, "%s%d:%dx%d", bp.len ? " " : "", i,
+                           pic_info->width, pic_info->height);
         }
-
-        last      = &dec_frame->next;
-        dec_frame = dec_frame->next;
+        if (av_bprint_finalize(&bp, &dec_ctx->low_res_list) < 0)
+            return;
     }
-
-    dec_frame = av_mallocz(sizeof(*dec_frame));
-    if (!dec_frame)
-        return AVERROR(ENOMEM);
-    dec_frame->av_frame = av_frame_alloc();
-    if (!dec_frame->av_frame) {
-        av_freep(&dec_frame);
-        return AVERROR(ENOMEM);
-    }
-    *last = dec_frame;
-
-    ret = vpe_alloc_frame(avctx, dec_frame);
-    if (ret < 0)
-        return ret;
-
-    *vpi_frame = dec_frame->vpi_frame;
-
-    return 0;
-}
-
-/**
- * find frame from the linked list
- */
-static VpeDecFrame *vpe_find_frame(VpeDecCtx *dec_ctx, VpiFrame *vpi_frame)
-{
-    VpeDecFrame *cur_frame = dec_ctx->frame_list;
-
-    while (cur_frame) {
-        if (vpi_frame == cur_frame->vpi_frame)
-            return cur_frame;
-        cur_frame = cur_frame->next;
-    }
-    return NULL;
+    av_dict_set(&frame->metadata, "lavc.vpe_dec.low_res",
+                dec_ctx->low_res_list, 0);
 }
 
 /**
@@ -254,18 +227,17 @@ static VpeDecFrame *vpe_find_frame(VpeDecCtx *dec_ctx, VpiFrame *vpi_frame)
 static int vpe_output_frame(AVCodecContext *avctx, VpiFrame *vpi_frame,
                             AVFrame *out_frame)
 {
-    VpeDecCtx *dec_ctx     = (VpeDecCtx *)avctx->priv_data;
-    VpeDecFrame *dec_frame = NULL;
-    AVFrame *src_frame     = NULL;
+    VpeDecCtx *dec_ctx       = (VpeDecCtx *)avctx->priv_data;
+    VpeFramePoolEntry *entry = NULL;
+    int64_t latency;
     int ret;
 
-    dec_frame = vpe_find_frame(dec_ctx, vpi_frame);
-    if (dec_frame == NULL) {
+    entry = avpriv_vpe_frame_pool_find(&dec_ctx->frame_pool, vpi_frame);
+    if (entry == NULL) {
         av_log(avctx, AV_LOG_ERROR, "Can't find matched frame from pool\n");
         return AVERROR_BUG;
     }
-    src_frame = dec_frame->av_frame;
-    ret = av_frame_ref(out_frame, src_frame);
+    ret = av_frame_ref(out_frame, entry->frame);
     if (ret < 0)
         return ret;
 
@@ -277,6 +249,23 @@ static int vpe_output_frame(AVCodecContext *avctx, VpiFrame *vpi_frame,
     out_frame->pkt_dts               = vpi_frame->pkt_dts;
     out_frame->best_effort_timestamp = out_frame->pts;
 
+    latency = avpriv_vpe_stats_complete(&dec_ctx->stats, out_frame->pts);
+    avpriv_vpe_stats_export(&dec_ctx->stats, &out_frame->metadata,
+                            "lavc.vpe_dec", latency);
+    if (dec_ctx->pp_setting)
+        vpe_export_low_res(avctx, out_frame);
+
+    if (dec_ctx->low_res_output) {
+        AVFrame *full_frame = av_frame_alloc();
+
+        if (!full_frame)
+            return AVERROR(ENOMEM);
+        av_frame_move_ref(full_frame, out_frame);
+        ret = av_vpe_frame_ref_output(out_frame, full_frame,
+                                      dec_ctx->low_res_output);
+        av_frame_free(&full_frame);
+    }
+
     return ret;
 }
 
@@ -307,6 +296,8 @@ static int vpe_dec_receive(AVCodecContext *avctx, AVFrame *frame)
 
 /**
  * release avpkt buf which is released by external decoder
+ *
+ * Returns 1 if a buffer was released, 0 if the decoder holds all of them.
  */
 static int vpe_release_stream_mem(VpeDecCtx *dec_ctx)
 {
@@ -338,34 +329,185 @@ static int vpe_release_stream_mem(VpeDecCtx *dec_ctx)
         /* unref the input avpkt buffer */
         av_buffer_unref(&ref);
         vpe_packet->buf_ref = NULL;
+        return 1;
     }
 
     return 0;
 }
 
-int ff_vpe_decode_receive_frame(AVCodecContext *avctx, AVFrame *frame)
+/**
+ * Queue one packet in the current batch
+ *
+ * Returns 1 when the batch reached one of its limits and must be submitted.
+ */
+static int vpe_dec_batch_add(VpeDecCtx *dec_ctx, AVPacket *avpkt)
+{
+    if (!dec_ctx->batch_nb_packets)
+        dec_ctx->batch_start = av_gettime_relative();
+    dec_ctx->batch_size += avpkt->size;
+    av_packet_move_ref(&dec_ctx->batch_pkts[dec_ctx->batch_nb_packets++], avpkt);
+
+    if (dec_ctx->batch_nb_packets >= dec_ctx->max_batch_packets)
+        return 1;
+    if (dec_ctx->max_batch_bytes &&
+        dec_ctx->batch_size >= dec_ctx->max_batch_bytes)
+        return 1;
+    return 0;
+}
+
+static int vpe_dec_batch_expired(VpeDecCtx *dec_ctx)
+{
+    return dec_ctx->batch_nb_packets && dec_ctx->max_batch_latency &&
+           av_gettime_relative() - dec_ctx->batch_start >=
+           dec_ctx->max_batch_latency;
+}
+
+static void vpe_dec_batch_end(VpeDecCtx *dec_ctx)
+{
+    int n = dec_ctx->batch_nb_packets;
+    int bucket;
+
+    dec_ctx->batch_submit = 0;
+    if (!n)
+        return;
+
+    // batch size buckets: 1, 2, 3-4, 5-8, 9-16, more
+    bucket = FFMIN(av_log2(n - 1) + (n > 1),
+                   FF_ARRAY_ELEMS(dec_ctx->batch_hist) - 1);
+    dec_ctx->batch_hist[bucket]++;
+    dec_ctx->nb_batches++;
+    dec_ctx->nb_batched_packets += n;
+    dec_ctx->max_batch           = FFMAX(dec_ctx->max_batch, n);
+
+    dec_ctx->batch_nb_packets = 0;
+    dec_ctx->batch_next       = 0;
+    dec_ctx->batch_size       = 0;
+}
+
+/**
+ * submit one packet to the external decoder
+ */
+static int vpe_dec_put_packet(AVCodecContext *avctx, AVPacket *avpkt)
 {
     VpeDecCtx *dec_ctx     = (VpeDecCtx *)avctx->priv_data;
-    AVPacket avpkt         = { 0 };
     AVBufferRef *ref       = NULL;
     VpiFrame *in_vpi_frame = NULL;
     VpiCtrlCmdParam cmd_param;
     VpeDecPacket *vpe_packet;
-    int strm_buf_count, frame_buf_req;
+    int frame_buf_req;
     int ret, i;
 
-    ret = vpe_release_stream_mem(dec_ctx);
-    if (ret < 0) {
-        return ret;
+    dec_ctx->buffered_pkt->data     = avpkt->data;
+    dec_ctx->buffered_pkt->size     = avpkt->size;
+    dec_ctx->buffered_pkt->pts      = avpkt->pts;
+    dec_ctx->buffered_pkt->pkt_dts  = avpkt->dts;
+    dec_ctx->buffered_pkt->duration = avpkt->duration;
+    ref                             = av_buffer_ref(avpkt->buf);
+    if (!ref)
+        return AVERROR(ENOMEM);
+    /* ref the avpkt buffer
+       feed the packet buffer related info to external decoder */
+    dec_ctx->buffered_pkt->opaque  = (void *)ref;
+
+    for (i = 0; i < MAX_WAIT_DEPTH; i++) {
+        if (dec_ctx->packet_buf_wait_list[i].state == 0) {
+            vpe_packet = &dec_ctx->packet_buf_wait_list[i];
+            break;
+        }
+    }
+    if (i == MAX_WAIT_DEPTH) {
+        av_buffer_unref(&ref);
+        return AVERROR_BUFFER_TOO_SMALL;
     }
+    vpe_packet->state   = 1;
+    vpe_packet->buf_ref = ref;
+
+    cmd_param.cmd  = VPI_CMD_DEC_GET_FRAME_BUFFER_REQUEST;
+    cmd_param.data = NULL;
+    ret = dec_ctx->vpi->control(dec_ctx->ctx,
+                    (void*)&cmd_param, (void *)&frame_buf_req);
+    if (ret)
+        return AVERROR_EXTERNAL;
+    if (frame_buf_req) {
+        /* get frame buffer from pool */
+        ret = vpe_get_frame(avctx, &in_vpi_frame);
+        if (ret < 0) {
+            return ret;
+        }
+
+        cmd_param.cmd  = VPI_CMD_DEC_SET_FRAME_BUFFER;
+        cmd_param.data = (void *)in_vpi_frame;
+        ret = dec_ctx->vpi->control(dec_ctx->ctx,
+                                    (void *)&cmd_param, NULL);
+        if (ret)
+            return AVERROR_EXTERNAL;
+    }
+
+    /* try to flush packet data */
+    if (dec_ctx->buffered_pkt->size > 0) {
+        ret = dec_ctx->vpi->decode_put_packet(dec_ctx->ctx,
+                (void *)dec_ctx->buffered_pkt);
+        if (ret <= 0)
+            return AVERROR_EXTERNAL;
+        dec_ctx->buffered_pkt->size -= ret;
+        if (dec_ctx->buffered_pkt->size != 0) {
+            return AVERROR_EXTERNAL;
+        }
+        avpriv_vpe_stats_submit(&dec_ctx->stats,
+                                dec_ctx->buffered_pkt->pts);
+    }
+
+    return 0;
+}
+
+/**
+ * queue the packets sent to the decoder until the batch is full, then feed
+ * them to the external decoder back to back, without polling for output
+ * in between
+ */
+int ff_vpe_decode_receive_frame(AVCodecContext *avctx, AVFrame *frame)
+{
+    VpeDecCtx *dec_ctx = (VpeDecCtx *)avctx->priv_data;
+    AVPacket avpkt     = { 0 };
+    VpiCtrlCmdParam cmd_param;
+    int strm_buf_count;
+    int ret;
+
+    /* give back all the stream buffers consumed since the last call */
+    do {
+        ret = vpe_release_stream_mem(dec_ctx);
+        if (ret < 0) {
+            return ret;
+        }
+    } while (ret > 0);
     /* poll for new frame */
     ret = vpe_dec_receive(avctx, frame);
     if (ret != AVERROR(EAGAIN)) {
         return ret;
     }
 
+    /* each avcodec_send_packet() makes one packet available, keep them
+       until the batch reaches one of its limits or the stream ends */
+    while (!dec_ctx->batch_submit) {
+        ret = ff_decode_get_packet(avctx, &avpkt);
+        if (ret == AVERROR_EOF) {
+            dec_ctx->batch_eof    = 1;
+            dec_ctx->batch_submit = 1;
+        } else if (ret == AVERROR(EAGAIN)) {
+            break;
+        } else if (ret < 0) {
+            return ret;
+        } else if (vpe_dec_batch_add(dec_ctx, &avpkt)) {
+            dec_ctx->batch_submit = 1;
+        }
+    }
+    if (vpe_dec_batch_expired(dec_ctx))
+        dec_ctx->batch_submit = 1;
+    if (!dec_ctx->batch_submit)
+        return AVERROR(EAGAIN);
+
     /* feed decoder */
-    while (1) {
+    while (dec_ctx->batch_next < dec_ctx->batch_nb_packets) {
         cmd_param.cmd  = VPI_CMD_DEC_STRM_BUF_COUNT;
         cmd_param.data = NULL;
         ret = dec_ctx->vpi->control(dec_ctx->ctx,
@@ -373,7 +515,8 @@ int ff_vpe_decode_receive_frame(AVCodecContext *avctx, AVFrame *frame)
         if (ret)
             return AVERROR_EXTERNAL;
         if (strm_buf_count == -1) {
-            /* no space, block for an output frame to get space */
+            /* no space, block for an output frame to get space, the rest
+               of the batch is submitted by the next call */
             ret = vpe_dec_receive(avctx, frame);
             if (ret != AVERROR(EAGAIN)) {
                 return ret;
@@ -387,87 +530,26 @@ int ff_vpe_decode_receive_frame(AVCodecContext *avctx, AVFrame *frame)
             return ret;
         }
 
-        /* fetch new packet or eof */
-        ret = ff_decode_get_packet(avctx, &avpkt);
-        if (ret == 0) {
-            dec_ctx->buffered_pkt->data     = avpkt.data;
-            dec_ctx->buffered_pkt->size     = avpkt.size;
-            dec_ctx->buffered_pkt->pts      = avpkt.pts;
-            dec_ctx->buffered_pkt->pkt_dts  = avpkt.dts;
-            dec_ctx->buffered_pkt->duration = avpkt.duration;
-            ref                             = av_buffer_ref(avpkt.buf);
-            if (!ref) {
-                av_packet_unref(&avpkt);
-                return AVERROR(ENOMEM);
-            }
-            /* ref the avpkt buffer
-               feed the packet buffer related info to external decoder */
-            dec_ctx->buffered_pkt->opaque  = (void *)ref;
-            av_packet_unref(&avpkt);
-
-            for (i = 0; i < MAX_WAIT_DEPTH; i++) {
-                if (dec_ctx->packet_buf_wait_list[i].state == 0) {
-                    vpe_packet = &dec_ctx->packet_buf_wait_list[i];
-                    break;
-                }
-            }
-            if (i == MAX_WAIT_DEPTH) {
-                return AVERROR_BUFFER_TOO_SMALL;
-            }
-            vpe_packet->state   = 1;
-            vpe_packet->buf_ref = ref;
-
-            cmd_param.cmd  = VPI_CMD_DEC_GET_FRAME_BUFFER_REQUEST;
-            cmd_param.data = NULL;
-            ret = dec_ctx->vpi->control(dec_ctx->ctx,
-                            (void*)&cmd_param, (void *)&frame_buf_req);
-            if (ret)
-                return AVERROR_EXTERNAL;
-            if (frame_buf_req) {
-                /* get frame buffer from pool */
-                ret = vpe_get_frame(avctx, &in_vpi_frame);
-                if (ret < 0) {
-                    return ret;
-                }
-
-                cmd_param.cmd  = VPI_CMD_DEC_SET_FRAME_BUFFER;
-                cmd_param.data = (void *)in_vpi_frame;
-                ret = dec_ctx->vpi->control(dec_ctx->ctx,
-                                            (void *)&cmd_param, NULL);
-                if (ret)
-                    return AVERROR_EXTERNAL;
-            }
-        } else if (ret == AVERROR_EOF) {
-            ret = dec_ctx->vpi->decode_put_packet(dec_ctx->ctx,
-                (void *)dec_ctx->buffered_pkt);
-            if (ret < 0) {
-                return AVERROR_EXTERNAL;
-            } else {
-                return AVERROR(EAGAIN);
-            }
-        } else if (ret == AVERROR(EAGAIN)) {
-            return vpe_dec_receive(avctx, frame);
-        } else if (ret < 0) {
+        ret = vpe_dec_put_packet(avctx,
+                                 &dec_ctx->batch_pkts[dec_ctx->batch_next]);
+        av_packet_unref(&dec_ctx->batch_pkts[dec_ctx->batch_next++]);
+        if (ret < 0)
             return ret;
-        }
+    }
+    vpe_dec_batch_end(dec_ctx);
 
-        /* try to flush packet data */
-        if (dec_ctx->buffered_pkt->size > 0) {
-            ret = dec_ctx->vpi->decode_put_packet(dec_ctx->ctx,
-                    (void *)dec_ctx->buffered_pkt);
-            if (ret > 0) {
-                dec_ctx->buffered_pkt->size -= ret;
-                if (dec_ctx->buffered_pkt->size != 0) {
-                    return AVERROR_EXTERNAL;
-                }
-                return vpe_dec_receive(avctx, frame);
-            } else {
-                return AVERROR_EXTERNAL;
-            }
+    if (dec_ctx->batch_eof) {
+        dec_ctx->batch_eof = 0;
+        ret = dec_ctx->vpi->decode_put_packet(dec_ctx->ctx,
+            (void *)dec_ctx->buffered_pkt);
+        if (ret < 0) {
+            return AVERROR_EXTERNAL;
+        } else {
+            return AVERROR(EAGAIN);
         }
     }
 
-    return AVERROR(EAGAIN);
+    return vpe_dec_receive(avctx, frame);
 }
 
 static av_cold void vpe_dec_consume_flush(VpeDecCtx *dec_ctx)
@@ -475,6 +557,10 @@ static av_cold void vpe_dec_consume_flush(VpeDecCtx *dec_ctx)
     VpeDecPacket *vpe_packet = NULL;
     int i;
 
+    for (i = 0; i < dec_ctx->batch_nb_packets; i++)
+        av_packet_unref(&dec_ctx->batch_pkts[i]);
+    dec_ctx->batch_nb_packets = 0;
+
     for (i = 0; i < MAX_WAIT_DEPTH; i++) {
         if (dec_ctx->packet_buf_wait_list[i].state == 1) {
             vpe_packet = &dec_ctx->packet_buf_wait_list[i];
@@ -488,30 +574,39 @@ static av_cold void vpe_dec_consume_flush(VpeDecCtx *dec_ctx)
 
 av_cold int ff_vpe_decode_close(AVCodecContext *avctx)
 {
-    AVHWDeviceContext *hwdevice_ctx;
-    AVVpeDeviceContext *vpedev_ctx;
+    AVHWFramesContext *hwframe_ctx;
+    AVVpeFramesContext *vpeframe_ctx;
     VpeDecCtx *dec_ctx = avctx->priv_data;
-    VpeDecFrame *cur_frame;
-
-    hwdevice_ctx = (AVHWDeviceContext *)avctx->hw_device_ctx->data;
-    vpedev_ctx   = (AVVpeDeviceContext *)hwdevice_ctx->hwctx;
 
     vpe_clear_unused_frames(dec_ctx);
     if (dec_ctx->ctx == NULL)
         return 0;
+
+    hwframe_ctx  = (AVHWFramesContext *)avctx->hw_frames_ctx->data;
+    vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
+
+    if (dec_ctx->nb_batches)
+        av_log(avctx, AV_LOG_VERBOSE,
+               "%"PRId64" packets in %"PRId64" batches, avg %.2f max %d, "
+               "sizes 1:%"PRId64" 2:%"PRId64" 3-4:%"PRId64" 5-8:%"PRId64" "
+               "9-16:%"PRId64" >16:%"PRId64"\n",
+               dec_ctx->nb_batched_packets, dec_ctx->nb_batches,
+               (double)dec_ctx->nb_batched_packets / dec_ctx->nb_batches,
+               dec_ctx->max_batch, dec_ctx->batch_hist[0],
+               dec_ctx->batch_hist[1], dec_ctx->batch_hist[2],
+               dec_ctx->batch_hist[3], dec_ctx->batch_hist[4],
+               dec_ctx->batch_hist[5]);
+    avpriv_vpe_stats_log(avctx, "decode", &dec_ctx->stats);
+
     dec_ctx->vpi->close(dec_ctx->ctx);
     vpe_dec_consume_flush(dec_ctx);
 
-    cur_frame = dec_ctx->frame_list;
-    while (cur_frame) {
-        dec_ctx->frame_list = cur_frame->next;
-        av_frame_free(&cur_frame->av_frame);
-        av_freep(&cur_frame);
-        cur_frame = dec_ctx->frame_list;
-    }
+    avpriv_vpe_frame_pool_uninit(&dec_ctx->frame_pool);
+    av_freep(&dec_ctx->low_res_list);
     if (dec_ctx->dec_setting)
         free(dec_ctx->dec_setting);
-    if (vpi_destroy(dec_ctx->ctx, vpedev_ctx->device)) {
+    avpriv_vpe_device_session_add(hwframe_ctx, -1);
+    if (vpi_destroy(dec_ctx->ctx, vpeframe_ctx->device)) {
         av_log(avctx, AV_LOG_ERROR, "decoder vpi_destroy failure\n");
         return AVERROR_EXTERNAL;
     }
@@ -530,6 +625,14 @@ const AVOption vpe_decode_options[] = {
       0,
       0,
       VD },
+    { "low_res_output",
+      "output this low_res picture instead of the full resolution one",
+      OFFSET(low_res_output),
+      AV_OPT_TYPE_INT,
+      { .i64 = 0 },
+      0,
+      PIC_INDEX_MAX_NUMBER - 1,
+      VD },
     { "transcode",
       "enable/disable transcoding",
       OFFSET(transcode),
@@ -538,5 +641,30 @@ const AVOption vpe_decode_options[] = {
       0,
       1,
       VD },
+    { "batch_packets",
+      "number of packets kept and submitted back to back before polling for output",
+      OFFSET(max_batch_packets),
+      AV_OPT_TYPE_INT,
+      { .i64 = 1 },
+      1,
+      MAX_WAIT_DEPTH,
+      VD },
+    { "batch_bytes",
+      "submit the kept packets once they hold this many bytes, 0 for no limit",
+      OFFSET(max_batch_bytes),
+      AV_OPT_TYPE_INT,
+      { .i64 = 0 },
+      0,
+      INT_MAX,
+      VD },
+    { "batch_latency",
+      "submit the kept packets after this many microseconds, 0 for no limit",
+      OFFSET(max_batch_latency),
+      AV_OPT_TYPE_INT,
+      { .i64 = 0 },
+      0,
+      INT_MAX,
+      VD },
+    VPE_STATS_OPTIONS(OFFSET, stats, VD),
     { NULL },
 };
@@ -30,6 +30,8 @@
 #include "decode.h"
 #include "libavutil/hwcontext_vpe.h"
 #include "libavutil/opt.h"
+#include "libavutil/vpe_frame_pool.h"
+#include "libavutil/vpe_stats.h"
 
 extern const AVOption vpe_decode_options[];
 
@@ -40,16 +42,6 @@ typedef struct {
     AVBufferRef *buf_ref;
 } VpeDecPacket;
 
-typedef struct VpeDecFrame {
-    AVFrame *av_frame;
-    // frame structure used for external codec
-    VpiFrame *vpi_frame;
-    // vpi_frame has been used
-    int used;
-    // the next linked list item
-    struct VpeDecFrame *next;
-} VpeDecFrame;
-
 /**
  * Communicating VPE parameters between libavcodec and the caller.
  */
@@ -67,17 +59,45 @@ typedef struct VpeDecCtx {
 
     // VPE decoder low_res config
     uint8_t *pp_setting;
+    // low_res picture output instead of the full resolution one, 0 for none
+    int low_res_output;
+    // "index:wxh" list of the low_res pictures, exported in the metadata
+    char *low_res_list;
     // VPE transcode enable
     int transcode;
 
     // buffered packet feed to external decoder
     VpiPacket *buffered_pkt;
 
-    // VPE frame linked list
-    VpeDecFrame *frame_list;
+    // VPE frames lent to the external decoder
+    VpeFramePool frame_pool;
 
     // Input AVPacket buffer_ref
     VpeDecPacket packet_buf_wait_list[MAX_WAIT_DEPTH];
+
+    // packet batch limits
+    int max_batch_packets;
+    int max_batch_bytes;
+    int max_batch_latency;
+    // packets queued for the current batch, batch_next is the first one
+    // not submitted yet
+    AVPacket batch_pkts[MAX_WAIT_DEPTH];
+    int batch_nb_packets;
+    int batch_next;
+    int batch_size;
+    int64_t batch_start;
+    // the batch is complete and being submitted
+    int batch_submit;
+    // the end of stream was reached while queueing the batch
+    int batch_eof;
+    // packet batch statistics
+    int64_t nb_batches;
+    int64_t nb_batched_packets;
+    int max_batch;
+    int64_t batch_hist[6];
+
+    // packet to frame latency and decoder depth
+    VpeStats stats;
 } VpeDecCtx;
 
 int ff_vpe_decode_init(AVCodecContext *avctx, VpiPlugin type);
@@ -20,10 +20,208 @@
  */
 
 #include "libavutil/hwcontext_vpe.h"
+#include "libavutil/hwcontext_vpe_internal.h"
+#include "libavutil/thread.h"
 #include "libavutil/time.h"
 
 #include "vpe_enc_common.h"
 
+#define VPE_ENC_POLL_MIN_US 16
+#define VPE_ENC_POLL_MAX_US 512
+
+#define VPE_LADDER_NB_PICS 256
+
+/**
+ * The encoders of the renditions of one ABR ladder, joined by name.
+ *
+ * Every rendition encodes the same pictures, so the IDR pictures line up
+ * as long as all of them use the same intra_pic_rate and follow the same
+ * key_frame flags. The ladder imposes the intra_pic_rate of its first
+ * member on the others and checks the picture types of the packets, it
+ * does not share anything else: each member is still a separate encoder
+ * session.
+ */
+typedef struct VpeEncLadder {
+    char *name;
+    int nb_members;
+    /*intra_pic_rate of the first member, NULL for the encoder default*/
+    char *intra_pic_rate;
+    /*Whether the packet at a pts was an IDR, for the latest pts*/
+    struct {
+        int64_t pts;
+        int key;
+    } pics[VPE_LADDER_NB_PICS];
+    int nb_pics;
+    int pic_pos;
+    int64_t nb_misaligned;
+    struct VpeEncLadder *next;
+} VpeEncLadder;
+
+static AVMutex ladder_lock = AV_MUTEX_INITIALIZER;
+static VpeEncLadder *ladders;
+
+/**
+ * Join the ladder named by the ladder option, creating it for the first
+ * member. The GOP settings must match those of the ladder.
+ */
+static int vpe_enc_ladder_join(VpeEncCtx *enc_ctx)
+{
+    AVDictionaryEntry *rate;
+    VpeEncLadder *ladder;
+    int ret = 0;
+
+    if (!enc_ctx->ladder)
+        return 0;
+    rate = av_dict_get(enc_ctx->dict, "intra_pic_rate", NULL, 0);
+
+    ff_mutex_lock(&ladder_lock);
+    for (ladder = ladders; ladder; ladder = ladder->next) {
+        if (!strcmp(ladder->name, enc_ctx->ladder))
+            break;
+    }
+
+    if (!ladder) {
+        ladder = av_mallocz(sizeof(*ladder));
+        if (!ladder) {
+            ret = AVERROR(ENOMEM);
+            goto end;
+        }
+        ladder->name = av_strdup(enc_ctx->ladder);
+        if (rate)
+            ladder->intra_pic_rate = av_strdup(rate->value);
+        if (!ladder->name || (rate && !ladder->intra_pic_rate)) {
+            av_freep(&ladder->name);
+            av_freep(&ladder->intra_pic_rate);
+            av_freep(&ladder);
+            ret = AVERROR(ENOMEM);
+            goto end;
+        }
+        ladder->next = ladders;
+        ladders      = ladder;
+    } else if (!rate && ladder->intra_pic_rate) {
+        ret = av_dict_set(&enc_ctx->dict, "intra_pic_rate",
+                          ladder->intra_pic_rate, 0);
+        if (ret < 0)
+            goto end;
+    } else if (rate && (!ladder->intra_pic_rate ||
+                        strcmp(rate->value, ladder->intra_pic_rate))) {
+        av_log(enc_ctx, AV_LOG_ERROR, "intra_pic_rate %s differs from %s of "
+               "the ladder %s, the IDR pictures would not be aligned\n",
+               rate->value, ladder->intra_pic_rate ? ladder->intra_pic_rate :
+               "default", ladder->name);
+        ret = AVERROR(EINVAL);
+        goto end;
+    }
+
+    ladder->nb_members++;
+    enc_ctx->ladder_group = ladder;
+
+end:
+    ff_mutex_unlock(&ladder_lock);
+    return ret;
+}
+
+static void vpe_enc_ladder_leave(VpeEncCtx *enc_ctx)
+{
+    VpeEncLadder *ladder = enc_ctx->ladder_group;
+    VpeEncLadder **prev;
+
+    if (!ladder)
+        return;
+
+    ff_mutex_lock(&ladder_lock);
+    if (!--ladder->nb_members) {
+        av_log(enc_ctx, AV_LOG_VERBOSE, "ladder %s: %"PRId64" misaligned "
+               "pictures\n", ladder->name, ladder->nb_misaligned);
+        for (prev = &ladders; *prev != ladder; prev = &(*prev)->next)
+            ;
+        *prev = ladder->next;
+        av_freep(&ladder->name);
+        av_freep(&ladder->intra_pic_rate);
+        av_freep(&ladder);
+    }
+    ff_mutex_unlock(&ladder_lock);
+    enc_ctx->ladder_group = NULL;
+}
+
+/**
+ * Check that the packet at pts has the same picture type in all the
+ * renditions which already output it.
+ */
+static void vpe_enc_ladder_check(VpeEncCtx *enc_ctx, const AVPacket *pkt)
+{
+    VpeEncLadder *ladder = enc_ctx->ladder_group;
+    int key = !!(pkt->flags & AV_PKT_FLAG_KEY);
+    int i;
+
+    if (!ladder || pkt->pts == AV_NOPTS_VALUE)
+        return;
+
+    ff_mutex_lock(&ladder_lock);
+    for (i = 0; i < ladder->nb_pics; i++) {
+        if (ladder->pics[i].pts == pkt->pts)
+            break;
+    }
+    if (i < ladder->nb_pics) {
+        if (ladder->pics[i].key != key) {
+            if (!ladder->nb_misaligned++)
+                av_log(enc_ctx, AV_LOG_WARNING, "%s picture at pts %"PRId64
+                       " is not aligned with the other renditions of the "
+                       "ladder %s\n", key ? "IDR" : "Non IDR", pkt->pts,
+                       ladder->name);
+        }
+    } else {
+        ladder->pics[ladder->pic_pos].pts = pkt->pts;
+        ladder->pics[ladder->pic_pos].key = key;
+        ladder->pic_pos = (ladder->pic_pos + 1) % VPE_LADDER_NB_PICS;
+        ladder->nb_pics = FFMIN(ladder->nb_pics + 1, VPE_LADDER_NB_PICS);
+    }
+    ff_mutex_unlock(&ladder_lock);
+}
+
+/**
+ * Check the integer enc_params against the ranges of the codec
+ */
+static int vpe_enc_check_params(VpeEncCtx *enc_ctx)
+{
+    const VpeEncParamRange *range;
+    AVDictionaryEntry *dict_entry;
+    char *end;
+    long val;
+
+    for (range = enc_ctx->param_ranges; range && range->key; range++) {
+        dict_entry = av_dict_get(enc_ctx->dict, range->key, NULL, 0);
+        if (!dict_entry)
+            continue;
+        val = strtol(dict_entry->value, &end, 0);
+        if (end == dict_entry->value || *end ||
+            val < range->min || val > range->max) {
+            av_log(enc_ctx, AV_LOG_ERROR,
+                   "enc_params %s=%s is invalid, the range is [%d...%d]\n",
+                   range->key, dict_entry->value, range->min, range->max);
+            return AVERROR(EINVAL);
+        }
+    }
+    return 0;
+}
+
+int ff_vpe_encode_param_int(VpeEncCtx *enc_ctx, const char *key, int def)
+{
+    AVDictionaryEntry *dict_entry = av_dict_get(enc_ctx->dict, key, NULL, 0);
+
+    return dict_entry ? strtol(dict_entry->value, NULL, 0) : def;
+}
+
+void ff_vpe_encode_set_depth(AVCodecContext *avctx, int depth)
+{
+    VpeEncCtx *enc_ctx = (VpeEncCtx *)avctx->priv_data;
+
+    enc_ctx->pipeline_depth = depth;
+    avctx->delay            = depth;
+    av_log(avctx, AV_LOG_VERBOSE, "encoder pipeline depth %d frames\n",
+           depth);
+}
+
 /**
  * Create the vpe encoder param list
  */
@@ -33,8 +231,28 @@ static int vpe_enc_create_param_list(VpeEncCtx *enc_ctx)
     AVDictionaryEntry *dict_entry = NULL;
     VpiEncParamSet *tail          = NULL;
     VpiEncParamSet *node          = NULL;
+    int parse_ret, ret;
+
+    parse_ret = av_dict_parse_string(&enc_ctx->dict, enc_params, "=", ":", 0);
+    if (!parse_ret && enc_ctx->profile_params)
+        parse_ret = av_dict_parse_string(&enc_ctx->dict,
+                                         enc_ctx->profile_params, "=", ":",
+                                         AV_DICT_DONT_OVERWRITE);
+    if (!parse_ret) {
+        ret = vpe_enc_check_params(enc_ctx);
+        if (ret < 0)
+            return ret;
+        ret = vpe_enc_ladder_join(enc_ctx);
+        if (ret < 0)
+            return ret;
+    } else if (enc_ctx->ladder) {
+        av_log(enc_ctx, AV_LOG_ERROR, "enc_params could not be parsed, the "
+               "intra_pic_rate of the ladder %s cannot be checked\n",
+               enc_ctx->ladder);
+        return parse_ret;
+    }
 
-    if (!av_dict_parse_string(&enc_ctx->dict, enc_params, "=", ":", 0)) {
+    if (!parse_ret) {
         while ((dict_entry = av_dict_get(enc_ctx->dict, "", dict_entry,
                                          AV_DICT_IGNORE_SUFFIX))) {
             node = malloc(sizeof(VpiEncParamSet));
@@ -77,10 +295,12 @@ int ff_vpe_encode_init(AVCodecContext *avctx, VpiPlugin type)
 {
     AVHWFramesContext *hwframe_ctx;
     AVVpeFramesContext *vpeframe_ctx;
-    AVHWDeviceContext *hwdevice_ctx;
-    AVVpeDeviceContext *vpedev_ctx;
     VpeEncCtx *enc_ctx = (VpeEncCtx *)avctx->priv_data;
-    int ret;
+    int ret, i;
+
+    for (i = 0; i < MAX_WAIT_DEPTH; i++)
+        enc_ctx->free_slots[i] = MAX_WAIT_DEPTH - 1 - i;
+    enc_ctx->nb_free_slots = MAX_WAIT_DEPTH;
 
     /*Get HW frame. The avctx->hw_frames_ctx is the reference to the
       AVHWFramesContext describing the input frame for vpe encoder*/
@@ -96,20 +316,15 @@ int ff_vpe_encode_init(AVCodecContext *avctx, VpiPlugin type)
     hwframe_ctx  = (AVHWFramesContext *)enc_ctx->hwframe->data;
     vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
 
-    if (!avctx->hw_device_ctx) {
-        vpedev_ctx = hwframe_ctx->device_ctx->hwctx;
-    } else {
-        hwdevice_ctx = (AVHWDeviceContext *)avctx->hw_device_ctx->data;
-        vpedev_ctx   = (AVVpeDeviceContext *)hwdevice_ctx->hwctx;
-    }
-
-    /*Create context and get the APIs for encoder from VPI layer */
-    if (vpi_create(&enc_ctx->ctx, &enc_ctx->vpi, vpedev_ctx->device, type)) {
+    /*Create context and get the APIs for encoder from VPI layer, on the
+      device holding the input frames */
+    if (vpi_create(&enc_ctx->ctx, &enc_ctx->vpi, vpeframe_ctx->device, type)) {
         av_log(avctx, AV_LOG_ERROR,
                "encoder vpe create failed, error=%s(%d)\n", vpi_error_str(ret),
                ret);
         return AVERROR_EXTERNAL;
     }
+    avpriv_vpe_device_session_add(hwframe_ctx, 1);
 
     ret = vpe_enc_create_param_list(enc_ctx);
     if (ret) {
@@ -172,7 +387,7 @@ static void vpe_dump_pic(AVCodecContext *avctx, const char *str,
 }
 
 /**
- * Release the AVFrame
+ * Release the AVFrame and give its slot back to the free list
  */
 static int vpe_enc_consume_pic(AVCodecContext *avctx, AVFrame *consume_frame)
 {
@@ -182,11 +397,9 @@ static int vpe_enc_consume_pic(AVCodecContext *avctx, AVFrame *consume_frame)
 
     vpe_dump_pic(avctx, "vpe_enc_consume_pic", " --->");
     for (i = 0; i < MAX_WAIT_DEPTH; i++) {
-        if (enc_ctx->pic_wait_list[i].state == 1) {
-            transpic = &enc_ctx->pic_wait_list[i];
-            if (transpic->frame == consume_frame)
-                goto find_pic;
-        }
+        transpic = &enc_ctx->pic_wait_list[i];
+        if (transpic->state == 1 && transpic->frame == consume_frame)
+            break;
     }
     if (i == MAX_WAIT_DEPTH) {
         av_log(avctx, AV_LOG_ERROR,
@@ -194,10 +407,9 @@ static int vpe_enc_consume_pic(AVCodecContext *avctx, AVFrame *consume_frame)
         return AVERROR(EINVAL);
     }
 
-find_pic:
     transpic->state = 0;
     av_frame_unref(transpic->frame);
-    transpic->frame = NULL;
+    enc_ctx->free_slots[enc_ctx->nb_free_slots++] = i;
     return 0;
 }
 
@@ -205,7 +417,7 @@ find_pic:
  * Get the released frame buffer info from external encoder,
  * do release opertion
  */
-static av_cold int vpe_enc_free_frames(AVCodecContext *avctx)
+static int vpe_enc_free_frames(AVCodecContext *avctx)
 {
     VpeEncCtx *enc_ctx = (VpeEncCtx *)avctx->priv_data;
     VpiCtrlCmdParam cmd;
@@ -231,38 +443,55 @@ static av_cold int vpe_enc_free_frames(AVCodecContext *avctx)
     return 0;
 }
 
+/**
+ * Wait for the external encoder to make progress
+ *
+ * VPI does not signal completions, so poll it with an exponential
+ * backoff: a picture finishing shortly after the first check is picked
+ * up within a few microseconds, while a long stall costs at most one
+ * wakeup every VPE_ENC_POLL_MAX_US.
+ */
+static void vpe_enc_wait(int *delay)
+{
+    av_usleep(*delay);
+    *delay = FFMIN(*delay * 2, VPE_ENC_POLL_MAX_US);
+}
+
 /**
  * Fetch new AVFrame and put to external encoder
+ *
+ * Returns AVERROR(EAGAIN) when all the input slots are still held by the
+ * encoder, the caller must then fetch packets before sending again.
  */
-av_cold int ff_enc_receive_pic(AVCodecContext *avctx,
-                   const AVFrame *input_frame)
+int ff_enc_receive_pic(AVCodecContext *avctx, const AVFrame *input_frame)
 {
-    int i               = 0;
     int ret             = 0;
     VpeEncFrm *transpic = NULL;
     VpeEncCtx *enc_ctx  = (VpeEncCtx *)avctx->priv_data;
     VpiFrame *vpi_frame = NULL;
     VpiCtrlCmdParam cmd;
 
-    do {
-        for (i = 0; i < MAX_WAIT_DEPTH; i++) {
-            if (enc_ctx->pic_wait_list[i].state == 0) {
-                transpic = &enc_ctx->pic_wait_list[i];
-                break;
-            }
-        }
+    if (input_frame) {
+        // the frame may still be uploading from hwupload
+        ret = avpriv_vpe_frame_wait(input_frame);
+        if (ret < 0)
+            return ret;
 
-        if (i == MAX_WAIT_DEPTH) {
-            av_usleep(500);
+        if (!enc_ctx->nb_free_slots) {
             ret = vpe_enc_free_frames(avctx);
             if (ret)
                 return ret;
-        } else {
-            break;
+            if (!enc_ctx->nb_free_slots)
+                return AVERROR(EAGAIN);
         }
-    } while (1);
-
-    transpic->state = 1;
+        transpic =
+            &enc_ctx->pic_wait_list[enc_ctx->free_slots[enc_ctx->nb_free_slots - 1]];
+        if (!transpic->frame) {
+            transpic->frame = av_frame_alloc();
+            if (!transpic->frame)
+                return AVERROR(ENOMEM);
+        }
+    }
 
     cmd.cmd  = VPI_CMD_ENC_GET_EMPTY_FRAME_SLOT;
     cmd.data = NULL;
@@ -271,13 +500,11 @@ av_cold int ff_enc_receive_pic(AVCodecContext *avctx,
     if (ret || !vpi_frame)
         return AVERROR_EXTERNAL;
     if (input_frame) {
-        if (!transpic->frame) {
-            transpic->frame = av_frame_alloc();
-            if (!transpic->frame)
-                return AVERROR(ENOMEM);
-        }
-        av_frame_unref(transpic->frame);
-        av_frame_ref(transpic->frame, input_frame);
+        ret = av_frame_ref(transpic->frame, input_frame);
+        if (ret < 0)
+            return ret;
+        transpic->state = 1;
+        enc_ctx->nb_free_slots--;
         vpe_enc_input_frame(transpic->frame, vpi_frame);
     } else {
         av_log(enc_ctx, AV_LOG_DEBUG, "input image is empty, received EOF\n");
@@ -288,6 +515,8 @@ av_cold int ff_enc_receive_pic(AVCodecContext *avctx,
     ret = enc_ctx->vpi->encode_put_frame(enc_ctx->ctx, (void*)vpi_frame);
     if (ret)
         return AVERROR_EXTERNAL;
+    if (input_frame)
+        avpriv_vpe_stats_submit(&enc_ctx->stats, enc_ctx->stats_nb_put++);
 
     vpe_dump_pic(avctx, "vpe_enc_receive_pic", " <---");
     return 0;
@@ -313,20 +542,29 @@ int ff_vpe_encode_receive_packet(AVCodecContext *avctx, AVPacket *avpkt)
     VpeEncCtx *enc_ctx = (VpeEncCtx *)avctx->priv_data;
     VpiPacket vpi_packet;
     VpiCtrlCmdParam cmd;
+    int delay       = VPE_ENC_POLL_MIN_US;
     int stream_size = 0;
     int ret = 0;
 
-    ret = vpe_enc_free_frames(avctx);
-    if (ret)
-        return ret;
+    while (1) {
+        ret = vpe_enc_free_frames(avctx);
+        if (ret)
+            return ret;
+
+        cmd.cmd = VPI_CMD_ENC_GET_FRAME_PACKET;
+        ret = enc_ctx->vpi->control(enc_ctx->ctx, &cmd, (void *)&stream_size);
+        if (ret == 1) {
+            av_log(NULL, AV_LOG_DEBUG, "received EOF from enc\n");
+            return AVERROR_EOF;
+        } else if (ret != -1) {
+            break;
+        }
 
-    cmd.cmd = VPI_CMD_ENC_GET_FRAME_PACKET;
-    ret = enc_ctx->vpi->control(enc_ctx->ctx, &cmd, (void *)&stream_size);
-    if (ret == -1) {
-        return AVERROR(EAGAIN);
-    } else if (ret == 1) {
-        av_log(NULL, AV_LOG_DEBUG, "received EOF from enc\n");
-        return AVERROR_EOF;
+        /* No packet yet: let the caller feed more input while there is room
+           for it, otherwise block until the encoder makes progress */
+        if (enc_ctx->nb_free_slots && !enc_ctx->eof)
+            return AVERROR(EAGAIN);
+        vpe_enc_wait(&delay);
     }
 
     /*Allocate AVPacket bufffer*/
@@ -340,6 +578,8 @@ int ff_vpe_encode_receive_packet(AVCodecContext *avctx, AVPacket *avpkt)
     if (ret == 0) {
         /*Convert output packet from VpiPacket to AVPacket*/
         vpe_enc_output_packet(&vpi_packet, avpkt);
+        avpriv_vpe_stats_complete(&enc_ctx->stats, enc_ctx->stats_nb_got++);
+        vpe_enc_ladder_check(enc_ctx, avpkt);
     } else {
         av_log(avctx, AV_LOG_ERROR, "enc encode failed, error=%s(%d)\n",
                vpi_error_str(ret), ret);
@@ -354,47 +594,44 @@ int ff_vpe_encode_receive_packet(AVCodecContext *avctx, AVPacket *avpkt)
  */
 static av_cold void vpe_enc_consume_flush(AVCodecContext *avctx)
 {
-    VpeEncCtx *enc_ctx  = (VpeEncCtx *)avctx->priv_data;
-    VpeEncFrm *transpic = NULL;
+    VpeEncCtx *enc_ctx = (VpeEncCtx *)avctx->priv_data;
     int i;
 
     for (i = 0; i < MAX_WAIT_DEPTH; i++) {
-        if (enc_ctx->pic_wait_list[i].state == 1) {
-            transpic = &enc_ctx->pic_wait_list[i];
-            if (transpic->frame)
-                av_frame_free(&transpic->frame);
-            transpic->state = 0;
-        }
+        av_frame_free(&enc_ctx->pic_wait_list[i].frame);
+        enc_ctx->pic_wait_list[i].state = 0;
     }
 }
 
 av_cold int ff_vpe_encode_close(AVCodecContext *avctx)
 {
-    AVHWFramesContext *hwframe_ctx;
-    AVHWDeviceContext *hwdevice_ctx;
-    AVVpeDeviceContext *vpedev_ctx;
+    AVHWFramesContext *hwframe_ctx   = NULL;
+    AVVpeFramesContext *vpeframe_ctx = NULL;
     VpeEncCtx *enc_ctx = (VpeEncCtx *)avctx->priv_data;
+    int device = -1;
 
-    if (!avctx->hw_device_ctx) {
-        hwframe_ctx = (AVHWFramesContext *)enc_ctx->hwframe->data;
-        vpedev_ctx  = hwframe_ctx->device_ctx->hwctx;
-    } else {
-        hwdevice_ctx = (AVHWDeviceContext *)avctx->hw_device_ctx->data;
-        vpedev_ctx   = (AVVpeDeviceContext *)hwdevice_ctx->hwctx;
+    if (enc_ctx->hwframe) {
+        hwframe_ctx  = (AVHWFramesContext *)enc_ctx->hwframe->data;
+        vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
+        device       = vpeframe_ctx->device;
     }
 
     if (avctx->extradata)
         av_freep(&avctx->extradata);
+    avpriv_vpe_stats_log(avctx, "encode", &enc_ctx->stats);
 
+    vpe_enc_ladder_leave(enc_ctx);
     vpe_enc_release_param_list(enc_ctx);
     if (enc_ctx->ctx)
         enc_ctx->vpi->close(enc_ctx->ctx);
     vpe_enc_consume_flush(avctx);
+    if (enc_ctx->ctx)
+        avpriv_vpe_device_session_add(hwframe_ctx, -1);
     av_buffer_unref(&enc_ctx->hwframe);
     if (enc_ctx->enc_cfg)
         free(enc_ctx->enc_cfg);
     if (enc_ctx->ctx) {
-        if (vpi_destroy(enc_ctx->ctx, vpedev_ctx->device)) {
+        if (vpi_destroy(enc_ctx->ctx, device)) {
             av_log(avctx, AV_LOG_ERROR, "encoder vpi_destroy failure\n");
             return AVERROR_EXTERNAL;
         }
@@ -28,8 +28,30 @@
 #include "libavutil/frame.h"
 #include "libavutil/buffer.h"
 #include "libavutil/log.h"
+#include "libavutil/vpe_stats.h"
 #include "libavcodec/avcodec.h"
 
+struct VpeEncLadder;
+
+/*Performance profiles, expanded to enc_params defaults by the codec*/
+enum VpeEncPerfProfile {
+    VPE_ENC_PROFILE_NONE = 0,
+    /*Ultra low latency live, no reordering and no lookahead*/
+    VPE_ENC_PROFILE_LIVE,
+    /*Highest channel density for VOD*/
+    VPE_ENC_PROFILE_VOD_DENSITY,
+    /*Best quality for VOD, deep lookahead*/
+    VPE_ENC_PROFILE_VOD_QUALITY,
+    VPE_ENC_PROFILE_NB,
+};
+
+/*Valid range of an integer -enc_params key*/
+typedef struct VpeEncParamRange {
+    const char *key;
+    int min;
+    int max;
+} VpeEncParamRange;
+
 typedef struct VpeEncFrm {
     /*The state of used or not*/
     int state;
@@ -57,6 +79,10 @@ typedef struct VpeEncCtx {
 
     /*The queue for the input AVFrames*/
     VpeEncFrm pic_wait_list[MAX_WAIT_DEPTH];
+    /*Stack of the idle pic_wait_list indexes*/
+    int free_slots[MAX_WAIT_DEPTH];
+    /*Number of valid entries in free_slots*/
+    int nb_free_slots;
 
     /*VPE encoder public parameters with -enc_params*/
     VpiEncParamSet *param_list;
@@ -84,12 +110,45 @@ typedef struct VpeEncCtx {
 
     /*Encoder configure*/
     void *enc_cfg;
+
+    /*Frame to packet latency and encoder depth*/
+    VpeStats stats;
+    /*Pictures put and packets got, the stats key: packets come out in
+      coding order, so the pts of a packet may not be the one of the
+      picture put the same number of calls before*/
+    int64_t stats_nb_put;
+    int64_t stats_nb_got;
+
+    /*Name of the ABR ladder the encoder is a rendition of*/
+    char *ladder;
+    /*The ladder joined, NULL when not part of one*/
+    struct VpeEncLadder *ladder_group;
+
+    /*Performance profile, VPE_ENC_PROFILE_xxx*/
+    int perf_profile;
+    /*enc_params defaults of the profile, set by the codec before init*/
+    const char *profile_params;
+    /*Ranges of the integer enc_params, terminated by a NULL key*/
+    const VpeEncParamRange *param_ranges;
+    /*Frames from an input picture to its packet, set by the codec*/
+    int pipeline_depth;
 } VpeEncCtx;
 
 int ff_vpe_encode_init(AVCodecContext *avctx, VpiPlugin type);
 av_cold int ff_vpe_encode_close(AVCodecContext *avctx);
-av_cold int ff_enc_receive_pic(AVCodecContext *avctx,
-                   const AVFrame *input_frame);
+int ff_enc_receive_pic(AVCodecContext *avctx, const AVFrame *input_frame);
 int ff_vpe_encode_receive_packet(AVCodecContext *avctx, AVPacket *avpkt);
 
+/**
+ * Get an integer enc_params value, after the profile defaults are applied.
+ * Returns def when the key is not set.
+ */
+int ff_vpe_encode_param_int(VpeEncCtx *enc_ctx, const char *key, int def);
+
+/**
+ * Report the number of frames the encoder holds before the packet of a
+ * picture is output, as AVCodecContext.delay and the pipeline_depth option.
+ */
+void ff_vpe_encode_set_depth(AVCodecContext *avctx, int depth);
+
 #endif /*AVCODEC_VPE_ENC_COMMON_H*/
\ No newline at end of file
@@ -73,22 +73,137 @@ static const AVOption vpe_h26x_encode_options[] = {
       AV_OPT_TYPE_STRING,
       { .str = NULL },
       .flags = FLAGS },
+    { "ladder",
+      "Name of the ABR ladder the encoder is a rendition of, the renditions "
+      "of a ladder get the same intra_pic_rate and their IDR alignment is "
+      "checked, each one is still a separate encoder session.",
+      OFFSETOPT(ladder),
+      AV_OPT_TYPE_STRING,
+      { .str = NULL },
+      .flags = FLAGS },
+    { "perf_profile",
+      "Performance profile, expanded to enc_params defaults",
+      OFFSETOPT(perf_profile),
+      AV_OPT_TYPE_INT,
+      { .i64 = VPE_ENC_PROFILE_NONE },
+      VPE_ENC_PROFILE_NONE,
+      VPE_ENC_PROFILE_NB - 1,
+      .flags = FLAGS,
+      "perf_profile" },
+    { "none", "Only the preset", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_NONE }, 0, 0, FLAGS, "perf_profile" },
+    { "live", "Ultra low latency live", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_LIVE }, 0, 0, FLAGS, "perf_profile" },
+    { "vod_density", "High density VOD", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_VOD_DENSITY }, 0, 0, FLAGS, "perf_profile" },
+    { "vod_quality", "Quality VOD", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_VOD_QUALITY }, 0, 0, FLAGS, "perf_profile" },
+    { "pipeline_depth",
+      "Frames held by the encoder before the packet of a picture "
+      "(read-only)",
+      OFFSETOPT(pipeline_depth),
+      AV_OPT_TYPE_INT,
+      { .i64 = 0 },
+      0,
+      INT_MAX,
+      .flags = FLAGS | AV_OPT_FLAG_READONLY },
+    VPE_STATS_OPTIONS(OFFSETOPT, stats, FLAGS),
+    { NULL },
+};
+
+/*enc_params defaults of the performance profiles*/
+static const char *const vpe_h26x_profile_params[VPE_ENC_PROFILE_NB] = {
+    [VPE_ENC_PROFILE_LIVE]        = "gop_size=1:lookahead_depth=0:low_delay=1",
+    [VPE_ENC_PROFILE_VOD_DENSITY] = "gop_size=4:lookahead_depth=0:ctb_rc=0",
+    [VPE_ENC_PROFILE_VOD_QUALITY] = "gop_size=0:lookahead_depth=30",
+};
+
+static const VpeEncParamRange vpe_h26x_param_ranges[] = {
+    { "intra_pic_rate", 0, INT_MAX },
+    { "gop_size", 0, 8 },
+    { "gop_lowdelay", 0, 1 },
+    { "lookahead_depth", 0, 40 },
+    { "low_delay", 0, 1 },
+    { "bitrate_window", 1, 300 },
+    { "pts_passthrough", 0, 1 },
+    { "intra_qp_delta", -51, 51 },
+    { "qp_hdr", -1, 51 },
+    { "qp_min", 0, 51 },
+    { "qp_max", 0, 51 },
+    { "qp_min_I", 0, 51 },
+    { "qp_max_I", 0, 51 },
+    { "fixed_intra_qp", 0, 51 },
+    { "tier", 0, 1 },
+    { "cabac", 0, 1 },
+    { "tol_moving_bitrate", 0, 2000 },
+    { "pic_rc", 0, 1 },
+    { "ctb_rc", 0, 1 },
+    { "chroma_qp_offset", -12, 12 },
+    { "vbr", 0, 1 },
+    { "rdo_level", 1, 3 },
+    { "force8bit", 0, 1 },
     { NULL },
 };
 
+/*gop_size and lookahead_depth of the presets, fast when not set*/
+static const struct {
+    const char *name;
+    int gop_size;
+    int lookahead_depth;
+} vpe_h26x_presets[] = {
+    { "superfast", 1, 0 },
+    { "fast", 4, 0 },
+    { "medium", 4, 20 },
+    { "slow", 0, 30 },
+    { "superslow", 0, 40 },
+};
+
+/**
+ * Frames held before the packet of a picture: the lookahead plus the
+ * reordering of the GOP, whose adaptive size is up to 8
+ */
+static int vpe_h26x_pipeline_depth(VpeEncCtx *enc_ctx)
+{
+    int gop_size = 4, lookahead_depth = 0;
+    int i;
+
+    for (i = 0; i < FF_ARRAY_ELEMS(vpe_h26x_presets); i++) {
+        if (enc_ctx->preset &&
+            !strcmp(enc_ctx->preset, vpe_h26x_presets[i].name)) {
+            gop_size        = vpe_h26x_presets[i].gop_size;
+            lookahead_depth = vpe_h26x_presets[i].lookahead_depth;
+        }
+    }
+    gop_size = ff_vpe_encode_param_int(enc_ctx, "gop_size", gop_size);
+    lookahead_depth =
+        ff_vpe_encode_param_int(enc_ctx, "lookahead_depth", lookahead_depth);
+
+    return lookahead_depth + (gop_size ? gop_size : 8) - 1;
+}
+
 static av_cold int vpe_h26x_encode_init(AVCodecContext *avctx)
 {
     VpeEncCtx *enc_ctx = (VpeEncCtx *)avctx->priv_data;
     VpiCtrlCmdParam cmd;
     VpiH26xEncCfg *h26x_enc_cfg;
     int extradata_size = 0;
+    int lookahead_depth;
     int ret            = 0;
 
+    enc_ctx->profile_params = vpe_h26x_profile_params[enc_ctx->perf_profile];
+    enc_ctx->param_ranges   = vpe_h26x_param_ranges;
     ret = ff_vpe_encode_init(avctx, H26XENC_VPE);
     if (ret < 0) {
         av_log(avctx, AV_LOG_ERROR, "ff_vpe_encode_init H26x failed\n");
         return ret;
     }
+    lookahead_depth = ff_vpe_encode_param_int(enc_ctx, "lookahead_depth", 0);
+    if (lookahead_depth > 0 && lookahead_depth < 4) {
+        av_log(avctx, AV_LOG_ERROR,
+               "lookahead_depth must be 0 or in [4...40]\n");
+        return AVERROR(EINVAL);
+    }
+    ff_vpe_encode_set_depth(avctx, vpe_h26x_pipeline_depth(enc_ctx));
 
     // get the encoder cfg struct
     cmd.cmd = VPI_CMD_ENC_INIT_OPTION;
@@ -73,9 +73,109 @@ const static AVOption vpe_enc_vp9_options[] = {
       0,
       0,
       FLAGS },
+    { "ladder",
+      "Name of the ABR ladder the encoder is a rendition of, the renditions "
+      "of a ladder get the same intra_pic_rate and their key frame "
+      "alignment is checked, each one is still a separate encoder session.",
+      OFFSET(ladder),
+      AV_OPT_TYPE_STRING,
+      { 0 },
+      0,
+      0,
+      FLAGS },
+    { "perf_profile",
+      "Performance profile, expanded to encoder settings defaults",
+      OFFSET(perf_profile),
+      AV_OPT_TYPE_INT,
+      { .i64 = VPE_ENC_PROFILE_NONE },
+      VPE_ENC_PROFILE_NONE,
+      VPE_ENC_PROFILE_NB - 1,
+      FLAGS,
+      "perf_profile" },
+    { "none", "Only the preset", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_NONE }, 0, 0, FLAGS, "perf_profile" },
+    { "live", "Ultra low latency live", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_LIVE }, 0, 0, FLAGS, "perf_profile" },
+    { "vod_density", "High density VOD", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_VOD_DENSITY }, 0, 0, FLAGS, "perf_profile" },
+    { "vod_quality", "Quality VOD", 0, AV_OPT_TYPE_CONST,
+      { .i64 = VPE_ENC_PROFILE_VOD_QUALITY }, 0, 0, FLAGS, "perf_profile" },
+    { "pipeline_depth",
+      "Frames held by the encoder before the packet of a picture "
+      "(read-only)",
+      OFFSET(pipeline_depth),
+      AV_OPT_TYPE_INT,
+      { .i64 = 0 },
+      0,
+      INT_MAX,
+      FLAGS | AV_OPT_FLAG_READONLY },
+    VPE_STATS_OPTIONS(OFFSET, stats, FLAGS),
     { NULL },
 };
 
+/*Settings of the performance profiles, used when not set by the user*/
+static const struct {
+    int effort;
+    int lag_in_frames;
+    int passes;
+    const char *params;
+} vpe_vp9_profiles[VPE_ENC_PROFILE_NB] = {
+    [VPE_ENC_PROFILE_NONE]        = { DEFAULT, DEFAULT, DEFAULT, NULL },
+    [VPE_ENC_PROFILE_LIVE]        = { 0, 0, 1, "low_delay=1:ref_frame_scheme=0" },
+    [VPE_ENC_PROFILE_VOD_DENSITY] = { 0, 7, 1, NULL },
+    [VPE_ENC_PROFILE_VOD_QUALITY] = { 1, 25, 2, NULL },
+};
+
+static const VpeEncParamRange vpe_vp9_param_ranges[] = {
+    { "low_delay", 0, 1 },
+    { "effort", 0, 5 },
+    { "lag_in_frames", 0, 25 },
+    { "passes", 1, 2 },
+    { "intra_pic_rate", 0, INT_MAX },
+    { "bitrate_window", 1, 300 },
+    { "qp_hdr", -1, 255 },
+    { "qp_min", 0, 255 },
+    { "qp_max", 0, 255 },
+    { "fixed_intra_qp", 0, 255 },
+    { "pic_rc", 0, 1 },
+    { "mcomp_filter_type", 0, 4 },
+    { "force8bit", 0, 1 },
+    { "ref_frame_scheme", 0, 4 },
+    { "filter_sharpness", 0, 8 },
+    { NULL },
+};
+
+/*lag_in_frames of the presets*/
+static const struct {
+    const char *name;
+    int lag_in_frames;
+} vpe_vp9_presets[] = {
+    { "superfast", 0 },
+    { "fast", 7 },
+    { "medium", 12 },
+    { "slow", 25 },
+    { "superslow", 25 },
+};
+
+/**
+ * Frames held before the packet of a picture, the lag of the encoder
+ */
+static int vpe_vp9_pipeline_depth(VpeEncCtx *enc_ctx)
+{
+    int lag_in_frames = 7;
+    int i;
+
+    for (i = 0; i < FF_ARRAY_ELEMS(vpe_vp9_presets); i++) {
+        if (enc_ctx->preset &&
+            !strcmp(enc_ctx->preset, vpe_vp9_presets[i].name))
+            lag_in_frames = vpe_vp9_presets[i].lag_in_frames;
+    }
+    if (enc_ctx->lag_in_frames != DEFAULT)
+        lag_in_frames = enc_ctx->lag_in_frames;
+
+    return ff_vpe_encode_param_int(enc_ctx, "lag_in_frames", lag_in_frames);
+}
+
 static av_cold int vpe_vp9_encode_init(AVCodecContext *avctx)
 {
     VpeEncCtx *enc_ctx = avctx->priv_data;
@@ -83,11 +183,22 @@ static av_cold int vpe_vp9_encode_init(AVCodecContext *avctx)
     VpiCtrlCmdParam cmd;
     int ret;
 
+    if (enc_ctx->effort == DEFAULT)
+        enc_ctx->effort = vpe_vp9_profiles[enc_ctx->perf_profile].effort;
+    if (enc_ctx->lag_in_frames == DEFAULT)
+        enc_ctx->lag_in_frames =
+            vpe_vp9_profiles[enc_ctx->perf_profile].lag_in_frames;
+    if (enc_ctx->passes == DEFAULT)
+        enc_ctx->passes = vpe_vp9_profiles[enc_ctx->perf_profile].passes;
+    enc_ctx->profile_params = vpe_vp9_profiles[enc_ctx->perf_profile].params;
+    enc_ctx->param_ranges   = vpe_vp9_param_ranges;
+
     ret = ff_vpe_encode_init(avctx, VP9ENC_VPE);
     if (ret < 0) {
         av_log(avctx, AV_LOG_ERROR, "ff_vpe_encode_init VP9 failed\n");
         return ret;
     }
+    ff_vpe_encode_set_depth(avctx, vpe_vp9_pipeline_depth(enc_ctx));
 
     // get the encoder cfg struct
     cmd.cmd = VPI_CMD_ENC_INIT_OPTION;
@@ -30,9 +30,20 @@
 #define BUFFER_ALIGN 0
 
 
+static AVFrame *get_audio_buffer(AVFilterLink *link, int nb_samples);
+
 AVFrame *ff_null_get_audio_buffer(AVFilterLink *link, int nb_samples)
 {
-    return ff_get_audio_buffer(link->dst->outputs[0], nb_samples);
+    return get_audio_buffer(link->dst->outputs[0], nb_samples);
+}
+
+static FFFramePool *audio_pool_init(AVFilterLink *link, int channels, int nb_samples)
+{
+    if (link->graph)
+        return ff_graph_frame_pool_audio(link->graph, channels, nb_samples,
+                                         link->format, BUFFER_ALIGN);
+    return ff_frame_pool_audio_init(av_buffer_allocz, channels,
+                                    nb_samples, link->format, BUFFER_ALIGN);
 }
 
 AVFrame *ff_default_get_audio_buffer(AVFilterLink *link, int nb_samples)
@@ -43,8 +54,7 @@ AVFrame *ff_default_get_audio_buffer(AVFilterLink *link, int nb_samples)
     av_assert0(channels == av_get_channel_layout_nb_channels(link->channel_layout) || !av_get_channel_layout_nb_channels(link->channel_layout));
 
     if (!link->frame_pool) {
-        link->frame_pool = ff_frame_pool_audio_init(av_buffer_allocz, channels,
-                                                    nb_samples, link->format, BUFFER_ALIGN);
+        link->frame_pool = audio_pool_init(link, channels, nb_samples);
         if (!link->frame_pool)
             return NULL;
     } else {
@@ -63,8 +73,7 @@ AVFrame *ff_default_get_audio_buffer(AVFilterLink *link, int nb_samples)
             pool_format != link->format || pool_align != BUFFER_ALIGN) {
 
             ff_frame_pool_uninit((FFFramePool **)&link->frame_pool);
-            link->frame_pool = ff_frame_pool_audio_init(av_buffer_allocz, channels,
-                                                        nb_samples, link->format, BUFFER_ALIGN);
+            link->frame_pool = audio_pool_init(link, channels, nb_samples);
             if (!link->frame_pool)
                 return NULL;
         }
@@ -83,7 +92,7 @@ AVFrame *ff_default_get_audio_buffer(AVFilterLink *link, int nb_samples)
     return frame;
 }
 
-AVFrame *ff_get_audio_buffer(AVFilterLink *link, int nb_samples)
+static AVFrame *get_audio_buffer(AVFilterLink *link, int nb_samples)
 {
     AVFrame *ret = NULL;
 
@@ -95,3 +104,20 @@ AVFrame *ff_get_audio_buffer(AVFilterLink *link, int nb_samples)
 
     return ret;
 }
+
+AVFrame *ff_get_audio_buffer_for(AVFilterContext *filter, AVFilterLink *link,
+                                 int nb_samples)
+{
+    AVFrame *ret = get_audio_buffer(link, nb_samples);
+
+    /* frames passed through by null filters are accounted once */
+    if (ret && link->graph && link->graph->profile)
+        ff_filter_profile_alloc(filter, ret);
+
+    return ret;
+}
+
+AVFrame *ff_get_audio_buffer(AVFilterLink *link, int nb_samples)
+{
+    return ff_get_audio_buffer_for(link->src, link, nb_samples);
+}
@@ -60,4 +60,11 @@ AVFrame *ff_null_get_audio_buffer(AVFilterLink *link, int nb_samples);
  */
 AVFrame *ff_get_audio_buffer(AVFilterLink *link, int nb_samples);
 
+/**
+ * Same as ff_get_audio_buffer(), but the buffer is accounted in the profile
+ * of filter instead of the source of link.
+ */
+AVFrame *ff_get_audio_buffer_for(AVFilterContext *filter, AVFilterLink *link,
+                                 int nb_samples);
+
 #endif /* AVFILTER_AUDIO_H */
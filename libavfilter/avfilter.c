@@ -19,6 +19,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <time.h>
+
 #include "libavutil/avassert.h"
 #include "libavutil/avstring.h"
 #include "libavutil/buffer.h"
@@ -33,6 +35,7 @@
 #include "libavutil/rational.h"
 #include "libavutil/samplefmt.h"
 #include "libavutil/thread.h"
+#include "libavutil/time.h"
 
 #define FF_INTERNAL_FIELDS 1
 #include "framequeue.h"
@@ -274,6 +277,26 @@ int avfilter_insert_filter(AVFilterLink *link, AVFilterContext *filt,
     return 0;
 }
 
+/**
+ * Tell if frames received on inlink can be sent as is on outlink.
+ */
+static int link_same_geometry(AVFilterLink *inlink, AVFilterLink *outlink)
+{
+    if (inlink->type != outlink->type || inlink->format != outlink->format ||
+        inlink->hw_frames_ctx || outlink->hw_frames_ctx)
+        return 0;
+    switch (inlink->type) {
+    case AVMEDIA_TYPE_VIDEO:
+        return inlink->w == outlink->w && inlink->h == outlink->h;
+    case AVMEDIA_TYPE_AUDIO:
+        return inlink->channels       == outlink->channels &&
+               inlink->channel_layout == outlink->channel_layout &&
+               inlink->sample_rate    == outlink->sample_rate;
+    default:
+        return 0;
+    }
+}
+
 int avfilter_config_links(AVFilterContext *filter)
 {
     int (*config_link)(AVFilterLink *);
@@ -365,6 +388,10 @@ int avfilter_config_links(AVFilterContext *filter)
                     return AVERROR(ENOMEM);
             }
 
+            if (inlink && link->src->nb_inputs == 1 && link->src->nb_outputs == 1 &&
+                link->src->input_pads[0].inplace)
+                inlink->inplace = link_same_geometry(inlink, link);
+
             if ((config_link = link->dstpad->config_props))
                 if ((ret = config_link(link)) < 0) {
                     av_log(link->dst, AV_LOG_ERROR,
@@ -627,8 +654,9 @@ static const AVClass *filter_child_class_next(const AVClass *prev)
 #define FLAGS AV_OPT_FLAG_FILTERING_PARAM
 static const AVOption avfilter_options[] = {
     { "thread_type", "Allowed thread types", OFFSET(thread_type), AV_OPT_TYPE_FLAGS,
-        { .i64 = AVFILTER_THREAD_SLICE }, 0, INT_MAX, FLAGS, "thread_type" },
+        { .i64 = AVFILTER_THREAD_SLICE | AVFILTER_THREAD_FRAME }, 0, INT_MAX, FLAGS, "thread_type" },
         { "slice", NULL, 0, AV_OPT_TYPE_CONST, { .i64 = AVFILTER_THREAD_SLICE }, .flags = FLAGS, .unit = "thread_type" },
+        { "frame", NULL, 0, AV_OPT_TYPE_CONST, { .i64 = AVFILTER_THREAD_FRAME }, .flags = FLAGS, .unit = "thread_type" },
     { "enable", "set enable expression", OFFSET(enable_str), AV_OPT_TYPE_STRING, {.str=NULL}, .flags = FLAGS },
     { "threads", "Allowed number of threads", OFFSET(nb_threads), AV_OPT_TYPE_INT,
         { .i64 = 0 }, 0, INT_MAX, FLAGS },
@@ -696,6 +724,13 @@ AVFilterContext *ff_filter_alloc(const AVFilter *filter, const char *inst_name)
     if (!ret->internal)
         goto err;
     ret->internal->execute = default_execute;
+    atomic_init(&ret->internal->nb_activations, 0);
+    atomic_init(&ret->internal->real_time, 0);
+    atomic_init(&ret->internal->cpu_time, 0);
+    atomic_init(&ret->internal->bytes_alloc, 0);
+    atomic_init(&ret->internal->max_queued, 0);
+    atomic_init(&ret->internal->frames_in, 0);
+    atomic_init(&ret->internal->frames_out, 0);
 
     ret->nb_inputs = avfilter_pad_count(filter->inputs);
     if (ret->nb_inputs ) {
@@ -886,6 +921,7 @@ static int process_options(AVFilterContext *ctx, AVDictionary **options,
 
 int avfilter_init_dict(AVFilterContext *ctx, AVDictionary **options)
 {
+    int thread_type = 0;
     int ret = 0;
 
     ret = av_opt_set_dict(ctx, options);
@@ -897,11 +933,13 @@ int avfilter_init_dict(AVFilterContext *ctx, AVDictionary **options)
     if (ctx->filter->flags & AVFILTER_FLAG_SLICE_THREADS &&
         ctx->thread_type & ctx->graph->thread_type & AVFILTER_THREAD_SLICE &&
         ctx->graph->internal->thread_execute) {
-        ctx->thread_type       = AVFILTER_THREAD_SLICE;
+        thread_type            = AVFILTER_THREAD_SLICE;
         ctx->internal->execute = ctx->graph->internal->thread_execute;
-    } else {
-        ctx->thread_type = 0;
     }
+    if (ctx->thread_type & ctx->graph->thread_type & AVFILTER_THREAD_FRAME &&
+        ctx->graph->internal->frame_execute)
+        thread_type |= AVFILTER_THREAD_FRAME;
+    ctx->thread_type = thread_type;
 
     if (ctx->filter->priv_class) {
         ret = av_opt_set_dict2(ctx->priv, options, AV_OPT_SEARCH_CHILDREN);
@@ -1056,18 +1094,19 @@ static int ff_filter_frame_framed(AVFilterLink *link, AVFrame *frame)
     if (!(filter_frame = dst->filter_frame))
         filter_frame = default_filter_frame;
 
-    if (dst->needs_writable) {
-        ret = ff_inlink_make_frame_writable(link, &frame);
-        if (ret < 0)
-            goto fail;
-    }
-
     ff_inlink_process_commands(link, frame);
     dstctx->is_disabled = !ff_inlink_evaluate_timeline_at_frame(link, frame);
 
     if (dstctx->is_disabled &&
         (dstctx->filter->flags & AVFILTER_FLAG_SUPPORT_TIMELINE_GENERIC))
         filter_frame = default_filter_frame;
+    /* a disabled filter passes the frame as is and does not need a copy */
+    else if (dst->needs_writable) {
+        ret = ff_inlink_make_frame_writable(link, &frame);
+        if (ret < 0)
+            goto fail;
+    }
+
     ret = filter_frame(link, frame);
     link->frame_count_out++;
     return ret;
@@ -1077,6 +1116,17 @@ fail:
     return ret;
 }
 
+static void profile_queue(AVFilterContext *filter, int queued)
+{
+    int max = atomic_load_explicit(&filter->internal->max_queued, memory_order_relaxed);
+
+    while (queued > max &&
+           !atomic_compare_exchange_weak_explicit(&filter->internal->max_queued,
+                                                  &max, queued,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed));
+}
+
 int ff_filter_frame(AVFilterLink *link, AVFrame *frame)
 {
     int ret;
@@ -1120,6 +1170,10 @@ int ff_filter_frame(AVFilterLink *link, AVFrame *frame)
         av_frame_free(&frame);
         return ret;
     }
+    if (link->graph && link->graph->profile) {
+        atomic_fetch_add_explicit(&link->src->internal->frames_out, 1, memory_order_relaxed);
+        profile_queue(link->dst, ff_framequeue_queued_frames(&link->fifo));
+    }
     ff_filter_set_ready(link->dst, 300);
     return 0;
 
@@ -1418,21 +1472,75 @@ static int ff_filter_activate_default(AVFilterContext *filter)
 
  */
 
+int64_t ff_filter_cpu_time(void)
+{
+#if HAVE_CLOCK_GETTIME && defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+
+    if (!clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts))
+        return ts.tv_sec * INT64_C(1000000) + ts.tv_nsec / 1000;
+#endif
+    return 0;
+}
+
 int ff_filter_activate(AVFilterContext *filter)
 {
+    AVFilterInternal *fi = filter->internal;
+    int profile = filter->graph && filter->graph->profile;
+    int64_t real_time = 0, cpu_time = 0;
     int ret;
 
     /* Generic timeline support is not yet implemented but should be easy */
     av_assert1(!(filter->filter->flags & AVFILTER_FLAG_SUPPORT_TIMELINE_GENERIC &&
                  filter->filter->activate));
     filter->ready = 0;
+    if (profile) {
+        real_time = av_gettime_relative();
+        cpu_time  = ff_filter_cpu_time();
+    }
     ret = filter->filter->activate ? filter->filter->activate(filter) :
           ff_filter_activate_default(filter);
+    if (profile) {
+        atomic_fetch_add_explicit(&fi->nb_activations, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&fi->real_time, av_gettime_relative() - real_time,
+                                  memory_order_relaxed);
+        atomic_fetch_add_explicit(&fi->cpu_time, ff_filter_cpu_time() - cpu_time,
+                                  memory_order_relaxed);
+    }
     if (ret == FFERROR_NOT_READY)
         ret = 0;
     return ret;
 }
 
+void ff_filter_profile_alloc(AVFilterContext *filter, const AVFrame *frame)
+{
+    int64_t size = 0;
+    int i;
+
+    for (i = 0; i < FF_ARRAY_ELEMS(frame->buf) && frame->buf[i]; i++)
+        size += frame->buf[i]->size;
+    for (i = 0; i < frame->nb_extended_buf; i++)
+        size += frame->extended_buf[i]->size;
+    atomic_fetch_add_explicit(&filter->internal->bytes_alloc, size,
+                              memory_order_relaxed);
+}
+
+int avfilter_get_profile(AVFilterContext *filter, AVFilterProfile *profile)
+{
+    AVFilterInternal *fi = filter->internal;
+
+    memset(profile, 0, sizeof(*profile));
+    profile->nb_activations = atomic_load(&fi->nb_activations);
+    profile->real_time      = atomic_load(&fi->real_time);
+    profile->cpu_time       = atomic_load(&fi->cpu_time);
+    profile->bytes_alloc    = atomic_load(&fi->bytes_alloc);
+    profile->max_queued     = atomic_load(&fi->max_queued);
+    profile->frames_in      = atomic_load(&fi->frames_in);
+    profile->frames_out     = atomic_load(&fi->frames_out);
+
+    return 0;
+}
+
 int ff_inlink_acknowledge_status(AVFilterLink *link, int *rstatus, int64_t *rpts)
 {
     *rpts = link->current_pts;
@@ -1476,6 +1584,8 @@ static void consume_update(AVFilterLink *link, const AVFrame *frame)
     ff_inlink_process_commands(link, frame);
     link->dst->is_disabled = !ff_inlink_evaluate_timeline_at_frame(link, frame);
     link->frame_count_out++;
+    if (link->graph && link->graph->profile)
+        atomic_fetch_add_explicit(&link->dst->internal->frames_in, 1, memory_order_relaxed);
 }
 
 int ff_inlink_consume_frame(AVFilterLink *link, AVFrame **rframe)
@@ -1532,12 +1642,24 @@ int ff_inlink_make_frame_writable(AVFilterLink *link, AVFrame **rframe)
         return 0;
     av_log(link->dst, AV_LOG_DEBUG, "Copying data in avfilter.\n");
 
+    if (link->graph) {
+        AVFilterGraphInternal *gi = link->graph->internal;
+        int size = link->type == AVMEDIA_TYPE_VIDEO ?
+                   av_image_get_buffer_size(frame->format, frame->width, frame->height, 1) :
+                   av_samples_get_buffer_size(NULL, frame->channels, frame->nb_samples,
+                                              frame->format, 1);
+
+        atomic_fetch_add(&gi->nb_copies, 1);
+        if (size > 0)
+            atomic_fetch_add(&gi->bytes_copied, size);
+    }
+
     switch (link->type) {
     case AVMEDIA_TYPE_VIDEO:
-        out = ff_get_video_buffer(link, link->w, link->h);
+        out = ff_get_video_buffer_for(link->dst, link, link->w, link->h);
         break;
     case AVMEDIA_TYPE_AUDIO:
-        out = ff_get_audio_buffer(link, frame->nb_samples);
+        out = ff_get_audio_buffer_for(link->dst, link, frame->nb_samples);
         break;
     default:
         return AVERROR(EINVAL);
@@ -1571,6 +1693,11 @@ int ff_inlink_make_frame_writable(AVFilterLink *link, AVFrame **rframe)
     return 0;
 }
 
+int ff_inlink_frame_inplace(AVFilterLink *link, AVFrame *frame)
+{
+    return link->inplace && av_frame_is_writable(frame);
+}
+
 int ff_inlink_process_commands(AVFilterLink *link, const AVFrame *frame)
 {
     AVFilterCommand *cmd = link->dst->command_queue;
@@ -332,6 +332,15 @@ typedef struct AVFilter {
  */
 #define AVFILTER_THREAD_SLICE (1 << 0)
 
+/**
+ * Activate several filters of the graph concurrently. Only filters which are
+ * neither linked to each other nor to a common filter run at the same time,
+ * so the filters need no locking of their own. Filters reaching into other
+ * filters of the graph must clear this flag from AVFilterContext.thread_type
+ * in their init callback.
+ */
+#define AVFILTER_THREAD_FRAME (1 << 1)
+
 typedef struct AVFilterInternal AVFilterInternal;
 
 /** An instance of a filter */
@@ -642,6 +651,13 @@ struct AVFilterLink {
      */
     int status_out;
 
+    /**
+     * If set, the destination filter writes its output into the frames
+     * received on this link when they are writable, see
+     * ff_inlink_frame_inplace().
+     */
+    int inplace;
+
 #endif /* FF_INTERNAL_FIELDS */
 
 };
@@ -907,6 +923,25 @@ typedef struct AVFilterGraph {
     int sink_links_count;
 
     unsigned disable_auto_convert;
+
+    /**
+     * Number of buffers a video frame pool of the graph is filled with when
+     * it is created, so that filtering reuses pooled buffers instead of
+     * allocating new ones. A pool is created when a filter first allocates
+     * frames of its geometry and is shared by the links carrying frames of
+     * that geometry, see avfilter_graph_get_pool_stats(). The links whose
+     * frames are passed through get no buffers.
+     * Access ONLY through AVOptions.
+     */
+    int prealloc_frames;
+
+    /**
+     * If set, the filters of the graph accumulate the time spent in them,
+     * the size of the frames they allocate and the depth of their input
+     * queues, see avfilter_get_profile().
+     * Access ONLY through AVOptions.
+     */
+    int profile;
 } AVFilterGraph;
 
 /**
@@ -985,6 +1020,94 @@ enum {
  */
 int avfilter_graph_config(AVFilterGraph *graphctx, void *log_ctx);
 
+/**
+ * Statistics of the frame buffer pools of a filter graph.
+ */
+typedef struct AVFilterGraphPoolStats {
+    /**
+     * Pools in use, one per frame geometry used by the links of the graph.
+     */
+    int nb_pools;
+    /**
+     * Buffers requested from the pools, one per plane of each frame.
+     */
+    int64_t nb_gets;
+    /**
+     * Requests served by a buffer returned to a pool.
+     */
+    int64_t nb_hits;
+    /**
+     * Requests which allocated a new buffer.
+     */
+    int64_t nb_misses;
+    /**
+     * Memory allocated by the pools in use.
+     */
+    int64_t bytes_held;
+    /**
+     * Frames copied because a filter needed to write into a frame it did
+     * not own exclusively.
+     */
+    int64_t nb_copies;
+    /**
+     * Size of the data copied for nb_copies.
+     */
+    int64_t bytes_copied;
+} AVFilterGraphPoolStats;
+
+/**
+ * Get the statistics of the frame buffer pools of a graph.
+ * This function may be called while the graph is processing frames in
+ * another thread.
+ *
+ * @param graph the filter graph
+ * @param stats filled with the statistics
+ * @return 0 on success, a negative AVERROR code otherwise
+ */
+int avfilter_graph_get_pool_stats(AVFilterGraph *graph, AVFilterGraphPoolStats *stats);
+
+/**
+ * Profile of a filter, accumulated while AVFilterGraph.profile is set.
+ */
+typedef struct AVFilterProfile {
+    /**
+     * Number of times the filter was activated by the graph.
+     */
+    int64_t nb_activations;
+    /**
+     * Wall clock and CPU time spent in the filter, in microseconds.
+     * The CPU time includes the slices processed by the threads of the
+     * graph, but not by a custom AVFilterGraph.execute callback. It is 0 on
+     * platforms without per-thread CPU clocks.
+     */
+    int64_t real_time;
+    int64_t cpu_time;
+    /**
+     * Frames consumed from the inputs and sent on the outputs.
+     */
+    int64_t frames_in;
+    int64_t frames_out;
+    /**
+     * Size of the frame buffers obtained for the outputs.
+     */
+    int64_t bytes_alloc;
+    /**
+     * Largest number of frames queued on one of the inputs.
+     */
+    int max_queued;
+} AVFilterProfile;
+
+/**
+ * Get the profile of a filter.
+ * This function may be called while the graph is processing frames in
+ * another thread, the values are then a snapshot.
+ *
+ * @param filter  the filter
+ * @param profile filled with the profile
+ * @return 0 on success, a negative AVERROR code otherwise
+ */
+int avfilter_get_profile(AVFilterContext *filter, AVFilterProfile *profile);
+
 /**
  * Free a graph, destroy its links, and set *graph to NULL.
  * If *graph is NULL, do nothing.
@@ -1141,6 +1264,17 @@ int avfilter_graph_queue_command(AVFilterGraph *graph, const char *target, const
  */
 char *avfilter_graph_dump(AVFilterGraph *graph, const char *options);
 
+/**
+ * Dump the profile of the filters of a graph into a human-readable table,
+ * see avfilter_get_profile().
+ *
+ * @param graph    the graph to dump
+ * @param options  formatting options; currently ignored
+ * @return  a string, or NULL in case of memory allocation failure;
+ *          the string must be freed using av_free
+ */
+char *avfilter_graph_dump_profile(AVFilterGraph *graph, const char *options);
+
 /**
  * Request a frame on the oldest sink link.
  *
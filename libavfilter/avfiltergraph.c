@@ -28,6 +28,7 @@
 #include "libavutil/avstring.h"
 #include "libavutil/bprint.h"
 #include "libavutil/channel_layout.h"
+#include "libavutil/hwcontext.h"
 #include "libavutil/imgutils.h"
 #include "libavutil/internal.h"
 #include "libavutil/opt.h"
@@ -41,6 +42,7 @@
 #include "formats.h"
 #include "internal.h"
 #include "thread.h"
+#include "video.h"
 
 #define OFFSET(x) offsetof(AVFilterGraph, x)
 #define F AV_OPT_FLAG_FILTERING_PARAM
@@ -50,12 +52,17 @@ static const AVOption filtergraph_options[] = {
     { "thread_type", "Allowed thread types", OFFSET(thread_type), AV_OPT_TYPE_FLAGS,
         { .i64 = AVFILTER_THREAD_SLICE }, 0, INT_MAX, F|V|A, "thread_type" },
         { "slice", NULL, 0, AV_OPT_TYPE_CONST, { .i64 = AVFILTER_THREAD_SLICE }, .flags = F|V|A, .unit = "thread_type" },
+        { "frame", NULL, 0, AV_OPT_TYPE_CONST, { .i64 = AVFILTER_THREAD_FRAME }, .flags = F|V|A, .unit = "thread_type" },
     { "threads",     "Maximum number of threads", OFFSET(nb_threads),
         AV_OPT_TYPE_INT,   { .i64 = 0 }, 0, INT_MAX, F|V|A },
     {"scale_sws_opts"       , "default scale filter options"        , OFFSET(scale_sws_opts)        ,
         AV_OPT_TYPE_STRING, {.str = NULL}, 0, 0, F|V },
     {"aresample_swr_opts"   , "default aresample filter options"    , OFFSET(aresample_swr_opts)    ,
         AV_OPT_TYPE_STRING, {.str = NULL}, 0, 0, F|A },
+    { "prealloc_frames", "Number of frame buffers allocated up front for each video frame pool", OFFSET(prealloc_frames),
+        AV_OPT_TYPE_INT,   { .i64 = 0 }, 0, INT_MAX, F|V },
+    { "profile",         "Accumulate the time spent in each filter", OFFSET(profile),
+        AV_OPT_TYPE_BOOL,  { .i64 = 0 }, 0, 1, F|V|A },
     { NULL },
 };
 
@@ -95,6 +102,10 @@ AVFilterGraph *avfilter_graph_alloc(void)
     ret->av_class = &filtergraph_class;
     av_opt_set_defaults(ret);
     ff_framequeue_global_init(&ret->internal->frame_queues);
+    ff_mutex_init(&ret->internal->heap_lock, NULL);
+    ff_mutex_init(&ret->internal->pool_lock, NULL);
+    atomic_init(&ret->internal->nb_copies, 0);
+    atomic_init(&ret->internal->bytes_copied, 0);
 
     return ret;
 }
@@ -117,6 +128,162 @@ void ff_filter_graph_remove_filter(AVFilterGraph *graph, AVFilterContext *filter
     }
 }
 
+/**
+ * Release the pools only referenced by the graph, keeping keep.
+ * Must be called with pool_lock held.
+ */
+static void release_unused_pools(AVFilterGraphInternal *gi, FFFramePool **pools,
+                                 int *nb_pools, FFFramePool *keep)
+{
+    int i;
+
+    for (i = *nb_pools - 1; i >= 0; i--) {
+        FFFramePoolStats stats;
+
+        if (pools[i] == keep || ff_frame_pool_get_stats(pools[i], &stats) < 0 ||
+            stats.nb_refs > 1)
+            continue;
+        gi->released_gets   += stats.nb_gets;
+        gi->released_misses += stats.nb_misses;
+        ff_frame_pool_uninit(&pools[i]);
+        pools[i] = pools[--*nb_pools];
+    }
+}
+
+static FFFramePool *add_pool(AVFilterGraphInternal *gi, FFFramePool ***pools,
+                             int *nb_pools, FFFramePool *pool)
+{
+    FFFramePool **tmp;
+
+    if (!pool)
+        return NULL;
+    tmp = av_realloc_array(*pools, *nb_pools + 1, sizeof(**pools));
+    if (!tmp) {
+        ff_frame_pool_uninit(&pool);
+        return NULL;
+    }
+    *pools = tmp;
+    (*pools)[(*nb_pools)++] = pool;
+    release_unused_pools(gi, *pools, nb_pools, pool);
+    return ff_frame_pool_ref(pool);
+}
+
+/**
+ * Fill a new video pool with prealloc_frames buffers. The frames are all
+ * held before being released, so that the pool keeps as many buffers.
+ * A failure is left to the allocation which needs the frame.
+ */
+static void prealloc_pool(AVFilterGraph *graph, FFFramePool *pool)
+{
+    AVFrame **frames;
+    int nb_frames = 0;
+
+    if (!pool || graph->prealloc_frames <= 0)
+        return;
+    frames = av_malloc_array(graph->prealloc_frames, sizeof(*frames));
+    if (!frames)
+        return;
+    while (nb_frames < graph->prealloc_frames &&
+           (frames[nb_frames] = ff_frame_pool_get(pool)))
+        nb_frames++;
+    while (nb_frames)
+        av_frame_free(&frames[--nb_frames]);
+    av_free(frames);
+}
+
+FFFramePool *ff_graph_frame_pool_video(AVFilterGraph *graph, int width, int height,
+                                       enum AVPixelFormat format, int align)
+{
+    AVFilterGraphInternal *gi = graph->internal;
+    FFFramePool *pool = NULL;
+    int i, created = 0;
+
+    ff_mutex_lock(&gi->pool_lock);
+    for (i = 0; i < gi->nb_video_pools; i++) {
+        int pool_width, pool_height, pool_align;
+        enum AVPixelFormat pool_format;
+
+        ff_frame_pool_get_video_config(gi->video_pools[i], &pool_width, &pool_height,
+                                       &pool_format, &pool_align);
+        if (pool_width == width && pool_height == height &&
+            pool_format == format && pool_align == align) {
+            pool = ff_frame_pool_ref(gi->video_pools[i]);
+            break;
+        }
+    }
+    if (!pool) {
+        pool = add_pool(gi, &gi->video_pools, &gi->nb_video_pools,
+                        ff_frame_pool_video_init(av_buffer_allocz, width, height,
+                                                 format, align));
+        created = 1;
+    }
+    ff_mutex_unlock(&gi->pool_lock);
+
+    if (created)
+        prealloc_pool(graph, pool);
+
+    return pool;
+}
+
+FFFramePool *ff_graph_frame_pool_audio(AVFilterGraph *graph, int channels,
+                                       int nb_samples, enum AVSampleFormat format,
+                                       int align)
+{
+    AVFilterGraphInternal *gi = graph->internal;
+    FFFramePool *pool = NULL;
+    int i;
+
+    ff_mutex_lock(&gi->pool_lock);
+    for (i = 0; i < gi->nb_audio_pools; i++) {
+        int pool_channels, pool_nb_samples, pool_align;
+        enum AVSampleFormat pool_format;
+
+        ff_frame_pool_get_audio_config(gi->audio_pools[i], &pool_channels,
+                                       &pool_nb_samples, &pool_format, &pool_align);
+        if (pool_channels == channels && pool_nb_samples == nb_samples &&
+            pool_format == format && pool_align == align) {
+            pool = ff_frame_pool_ref(gi->audio_pools[i]);
+            break;
+        }
+    }
+    if (!pool)
+        pool = add_pool(gi, &gi->audio_pools, &gi->nb_audio_pools,
+                        ff_frame_pool_audio_init(av_buffer_allocz, channels,
+                                                 nb_samples, format, align));
+    ff_mutex_unlock(&gi->pool_lock);
+
+    return pool;
+}
+
+int avfilter_graph_get_pool_stats(AVFilterGraph *graph, AVFilterGraphPoolStats *stats)
+{
+    AVFilterGraphInternal *gi = graph->internal;
+    int i;
+
+    memset(stats, 0, sizeof(*stats));
+
+    ff_mutex_lock(&gi->pool_lock);
+    stats->nb_pools  = gi->nb_video_pools + gi->nb_audio_pools;
+    stats->nb_gets   = gi->released_gets;
+    stats->nb_misses = gi->released_misses;
+    for (i = 0; i < stats->nb_pools; i++) {
+        FFFramePool *pool = i < gi->nb_video_pools ? gi->video_pools[i] :
+                            gi->audio_pools[i - gi->nb_video_pools];
+        FFFramePoolStats pool_stats;
+
+        ff_frame_pool_get_stats(pool, &pool_stats);
+        stats->nb_gets    += pool_stats.nb_gets;
+        stats->nb_misses  += pool_stats.nb_misses;
+        stats->bytes_held += pool_stats.bytes;
+    }
+    ff_mutex_unlock(&gi->pool_lock);
+    stats->nb_hits = stats->nb_gets - stats->nb_misses;
+    stats->nb_copies    = atomic_load(&gi->nb_copies);
+    stats->bytes_copied = atomic_load(&gi->bytes_copied);
+
+    return 0;
+}
+
 void avfilter_graph_free(AVFilterGraph **graph)
 {
     if (!*graph)
@@ -126,6 +293,15 @@ void avfilter_graph_free(AVFilterGraph **graph)
         avfilter_free((*graph)->filters[0]);
 
     ff_graph_thread_free(*graph);
+    ff_mutex_destroy(&(*graph)->internal->heap_lock);
+
+    while ((*graph)->internal->nb_video_pools)
+        ff_frame_pool_uninit(&(*graph)->internal->video_pools[--(*graph)->internal->nb_video_pools]);
+    while ((*graph)->internal->nb_audio_pools)
+        ff_frame_pool_uninit(&(*graph)->internal->audio_pools[--(*graph)->internal->nb_audio_pools]);
+    av_freep(&(*graph)->internal->video_pools);
+    av_freep(&(*graph)->internal->audio_pools);
+    ff_mutex_destroy(&(*graph)->internal->pool_lock);
 
     av_freep(&(*graph)->sink_links);
 
@@ -1390,8 +1566,14 @@ static void heap_bubble_down(AVFilterGraph *graph,
 
 void ff_avfilter_graph_update_heap(AVFilterGraph *graph, AVFilterLink *link)
 {
+    int locked = !!graph->internal->frame_execute;
+
+    if (locked)
+        ff_mutex_lock(&graph->internal->heap_lock);
     heap_bubble_up  (graph, link, link->age_index);
     heap_bubble_down(graph, link, link->age_index);
+    if (locked)
+        ff_mutex_unlock(&graph->internal->heap_lock);
 }
 
 int avfilter_graph_request_oldest(AVFilterGraph *graph)
@@ -1439,6 +1621,57 @@ int avfilter_graph_request_oldest(AVFilterGraph *graph)
     return 0;
 }
 
+static void mark_frame_job(AVFilterContext *filter, unsigned stamp, int depth)
+{
+    unsigned i;
+
+    filter->internal->frame_stamp = stamp;
+    if (!depth--)
+        return;
+    for (i = 0; i < filter->nb_inputs; i++)
+        if (filter->inputs[i])
+            mark_frame_job(filter->inputs[i]->src, stamp, depth);
+    for (i = 0; i < filter->nb_outputs; i++)
+        if (filter->outputs[i])
+            mark_frame_job(filter->outputs[i]->dst, stamp, depth);
+}
+
+/**
+ * Activate first together with other ready filters, one per thread.
+ * Activating a filter touches its links and the filters at the other end of
+ * them, so filters sharing a link or a neighbour are never scheduled in the
+ * same batch: every filter scheduled marks the ones up to two links away.
+ * The frame pools shared by links of the graph are the exception, the list
+ * of pools is protected by pool_lock and the pools themselves only update
+ * atomic counters and their thread-safe AVBufferPool.
+ */
+static int run_frame_jobs(AVFilterGraph *graph, AVFilterContext *first)
+{
+    AVFilterGraphInternal *gi = graph->internal;
+    unsigned stamp = ++gi->frame_stamp;
+    int nb_jobs = 0, i;
+
+    gi->frame_jobs[nb_jobs++] = first;
+    mark_frame_job(first, stamp, 2);
+    for (i = 0; i < graph->nb_filters && nb_jobs < gi->nb_frame_jobs; i++) {
+        AVFilterContext *filter = graph->filters[i];
+
+        if (!filter->ready || filter->internal->frame_stamp == stamp ||
+            !(filter->thread_type & AVFILTER_THREAD_FRAME))
+            continue;
+        gi->frame_jobs[nb_jobs++] = filter;
+        mark_frame_job(filter, stamp, 2);
+    }
+    if (nb_jobs == 1)
+        return ff_filter_activate(first);
+
+    gi->frame_execute(graph, nb_jobs);
+    for (i = 0; i < nb_jobs; i++)
+        if (gi->frame_rets[i] < 0)
+            return gi->frame_rets[i];
+    return 0;
+}
+
 int ff_filter_graph_run_once(AVFilterGraph *graph)
 {
     AVFilterContext *filter;
@@ -1451,5 +1684,8 @@ int ff_filter_graph_run_once(AVFilterGraph *graph)
             filter = graph->filters[i];
     if (!filter->ready)
         return AVERROR(EAGAIN);
+    if (graph->internal->frame_execute &&
+        filter->thread_type & AVFILTER_THREAD_FRAME)
+        return run_frame_jobs(graph, filter);
     return ff_filter_activate(filter);
 }
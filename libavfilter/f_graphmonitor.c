@@ -342,6 +342,9 @@ static int config_output(AVFilterLink *outlink)
 {
     GraphMonitorContext *s = outlink->src->priv;
 
+    /* reads the links of the whole graph */
+    outlink->src->thread_type &= ~AVFILTER_THREAD_FRAME;
+
     s->bg[3] = 255 * s->opacity;
     s->white[0] = s->white[1] = s->white[2] = 255;
     s->yellow[0] = s->yellow[1] = 255;
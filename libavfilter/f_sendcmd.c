@@ -378,6 +378,9 @@ static av_cold int init(AVFilterContext *ctx)
     SendCmdContext *s = ctx->priv;
     int ret, i, j;
 
+    /* sends commands to the other filters of the graph */
+    ctx->thread_type &= ~AVFILTER_THREAD_FRAME;
+
     if ((!!s->commands_filename + !!s->commands_str) != 1) {
         av_log(ctx, AV_LOG_ERROR,
                "One and only one of the filename or commands options must be specified\n");
@@ -52,6 +52,9 @@ static av_cold int init(AVFilterContext *ctx)
 {
     ZMQContext *zmq = ctx->priv;
 
+    /* sends commands to the other filters of the graph */
+    ctx->thread_type &= ~AVFILTER_THREAD_FRAME;
+
     zmq->zmq = zmq_ctx_new();
     if (!zmq->zmq) {
         av_log(ctx, AV_LOG_ERROR,
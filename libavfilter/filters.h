@@ -129,6 +129,15 @@ AVFrame *ff_inlink_peek_frame(AVFilterLink *link, size_t idx);
  */
 int ff_inlink_make_frame_writable(AVFilterLink *link, AVFrame **rframe);
 
+/**
+ * Tell if the destination filter of the link can write its output into
+ * the frame instead of allocating a new one.
+ * This is true if the frame is writable and the link was configured in
+ * place, i.e. the input pad has the inplace flag and the output link of
+ * the filter uses the same frame geometry.
+ */
+int ff_inlink_frame_inplace(AVFilterLink *link, AVFrame *frame);
+
 /**
  * Test and acknowledge the change of status on the link.
  *
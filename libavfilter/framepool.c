@@ -18,6 +18,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <stdatomic.h>
+
 #include "framepool.h"
 #include "libavutil/avassert.h"
 #include "libavutil/avutil.h"
@@ -45,9 +47,46 @@ struct FFFramePool {
     int align;
     int linesize[4];
     AVBufferPool *pools[4];
+    AVBufferRef* (*alloc)(int size);
+
+    atomic_int refcount;
+    atomic_int_least64_t nb_gets;
+    atomic_int_least64_t nb_misses;
+    atomic_int_least64_t bytes;
 
 };
 
+static AVBufferRef *pool_alloc(void *opaque, int size)
+{
+    FFFramePool *pool = opaque;
+    AVBufferRef *buf = pool->alloc ? pool->alloc(size) : av_buffer_alloc(size);
+
+    if (buf) {
+        atomic_fetch_add_explicit(&pool->nb_misses, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&pool->bytes, size, memory_order_relaxed);
+    }
+    return buf;
+}
+
+static AVBufferRef *pool_get(FFFramePool *pool, AVBufferPool *buffers)
+{
+    atomic_fetch_add_explicit(&pool->nb_gets, 1, memory_order_relaxed);
+    return av_buffer_pool_get(buffers);
+}
+
+static FFFramePool *pool_alloc_context(void)
+{
+    FFFramePool *pool = av_mallocz(sizeof(FFFramePool));
+
+    if (pool) {
+        atomic_init(&pool->refcount, 1);
+        atomic_init(&pool->nb_gets, 0);
+        atomic_init(&pool->nb_misses, 0);
+        atomic_init(&pool->bytes, 0);
+    }
+    return pool;
+}
+
 FFFramePool *ff_frame_pool_video_init(AVBufferRef* (*alloc)(int size),
                                       int width,
                                       int height,
@@ -61,10 +100,11 @@ FFFramePool *ff_frame_pool_video_init(AVBufferRef* (*alloc)(int size),
     if (!desc)
         return NULL;
 
-    pool = av_mallocz(sizeof(FFFramePool));
+    pool = pool_alloc_context();
     if (!pool)
         return NULL;
 
+    pool->alloc = alloc;
     pool->type = AVMEDIA_TYPE_VIDEO;
     pool->width = width;
     pool->height = height;
@@ -96,15 +136,15 @@ FFFramePool *ff_frame_pool_video_init(AVBufferRef* (*alloc)(int size),
         if (i == 1 || i == 2)
             h = AV_CEIL_RSHIFT(h, desc->log2_chroma_h);
 
-        pool->pools[i] = av_buffer_pool_init(pool->linesize[i] * h + 16 + 16 - 1,
-                                             alloc);
+        pool->pools[i] = av_buffer_pool_init2(pool->linesize[i] * h + 16 + 16 - 1,
+                                              pool, pool_alloc, NULL);
         if (!pool->pools[i])
             goto fail;
     }
 
     if (desc->flags & AV_PIX_FMT_FLAG_PAL ||
         desc->flags & FF_PSEUDOPAL) {
-        pool->pools[1] = av_buffer_pool_init(AVPALETTE_SIZE, alloc);
+        pool->pools[1] = av_buffer_pool_init2(AVPALETTE_SIZE, pool, pool_alloc, NULL);
         if (!pool->pools[1])
             goto fail;
     }
@@ -125,7 +165,7 @@ FFFramePool *ff_frame_pool_audio_init(AVBufferRef* (*alloc)(int size),
     int ret, planar;
     FFFramePool *pool;
 
-    pool = av_mallocz(sizeof(FFFramePool));
+    pool = pool_alloc_context();
     if (!pool)
         return NULL;
 
@@ -143,7 +183,7 @@ FFFramePool *ff_frame_pool_audio_init(AVBufferRef* (*alloc)(int size),
     if (ret < 0)
         goto fail;
 
-    pool->pools[0] = av_buffer_pool_init(pool->linesize[0], NULL);
+    pool->pools[0] = av_buffer_pool_init2(pool->linesize[0], pool, pool_alloc, NULL);
     if (!pool->pools[0])
         goto fail;
 
@@ -219,7 +259,7 @@ AVFrame *ff_frame_pool_get(FFFramePool *pool)
             if (!pool->pools[i])
                 break;
 
-            frame->buf[i] = av_buffer_pool_get(pool->pools[i]);
+            frame->buf[i] = pool_get(pool, pool->pools[i]);
             if (!frame->buf[i])
                 goto fail;
 
@@ -258,13 +298,13 @@ AVFrame *ff_frame_pool_get(FFFramePool *pool)
         }
 
         for (i = 0; i < FFMIN(pool->planes, AV_NUM_DATA_POINTERS); i++) {
-            frame->buf[i] = av_buffer_pool_get(pool->pools[0]);
+            frame->buf[i] = pool_get(pool, pool->pools[0]);
             if (!frame->buf[i])
                 goto fail;
             frame->extended_data[i] = frame->data[i] = frame->buf[i]->data;
         }
         for (i = 0; i < frame->nb_extended_buf; i++) {
-            frame->extended_buf[i] = av_buffer_pool_get(pool->pools[0]);
+            frame->extended_buf[i] = pool_get(pool, pool->pools[0]);
             if (!frame->extended_buf[i])
                 goto fail;
             frame->extended_data[i + AV_NUM_DATA_POINTERS] = frame->extended_buf[i]->data;
@@ -281,6 +321,26 @@ fail:
     return NULL;
 }
 
+FFFramePool *ff_frame_pool_ref(FFFramePool *pool)
+{
+    atomic_fetch_add_explicit(&pool->refcount, 1, memory_order_relaxed);
+    return pool;
+}
+
+int ff_frame_pool_get_stats(FFFramePool *pool, FFFramePoolStats *stats)
+{
+    if (!pool)
+        return AVERROR(EINVAL);
+
+    /* the graph releases a pool it sees unreferenced by links */
+    stats->nb_refs   = atomic_load_explicit(&pool->refcount,  memory_order_acquire);
+    stats->nb_gets   = atomic_load_explicit(&pool->nb_gets,   memory_order_relaxed);
+    stats->nb_misses = atomic_load_explicit(&pool->nb_misses, memory_order_relaxed);
+    stats->bytes     = atomic_load_explicit(&pool->bytes,     memory_order_relaxed);
+
+    return 0;
+}
+
 void ff_frame_pool_uninit(FFFramePool **pool)
 {
     int i;
@@ -288,6 +348,11 @@ void ff_frame_pool_uninit(FFFramePool **pool)
     if (!pool || !*pool)
         return;
 
+    if (atomic_fetch_sub_explicit(&(*pool)->refcount, 1, memory_order_acq_rel) > 1) {
+        *pool = NULL;
+        return;
+    }
+
     for (i = 0; i < 4; i++) {
         av_buffer_pool_uninit(&(*pool)->pools[i]);
     }
@@ -71,10 +71,36 @@ FFFramePool *ff_frame_pool_audio_init(AVBufferRef* (*alloc)(int size),
  * Deallocate the frame pool. It is safe to call this function while
  * some of the allocated frame are still in use.
  *
+ * The pool is only freed once all the references created with
+ * ff_frame_pool_ref() are released.
+ *
  * @param pool pointer to the frame pool to be freed. It will be set to NULL.
  */
 void ff_frame_pool_uninit(FFFramePool **pool);
 
+/**
+ * Create a new reference to the frame pool, released with
+ * ff_frame_pool_uninit().
+ *
+ * @return pool
+ */
+FFFramePool *ff_frame_pool_ref(FFFramePool *pool);
+
+typedef struct FFFramePoolStats {
+    int nb_refs;          ///< references to the pool
+    int64_t nb_gets;      ///< buffers requested from the pool
+    int64_t nb_misses;    ///< requests which allocated a new buffer
+    int64_t bytes;        ///< size of the buffers allocated by the pool
+} FFFramePoolStats;
+
+/**
+ * Get the frame pool statistics.
+ * This function may be called simultaneously from multiple threads.
+ *
+ * @return 0 on success, a negative AVERROR otherwise.
+ */
+int ff_frame_pool_get_stats(FFFramePool *pool, FFFramePoolStats *stats);
+
 /**
  * Get the video frame pool configuration.
  *
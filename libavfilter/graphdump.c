@@ -151,6 +151,36 @@ static void avfilter_graph_dump_to_buf(AVBPrint *buf, AVFilterGraph *graph)
     }
 }
 
+char *avfilter_graph_dump_profile(AVFilterGraph *graph, const char *options)
+{
+    AVBPrint buf;
+    char *dump;
+    unsigned i;
+
+    av_bprint_init(&buf, 0, AV_BPRINT_SIZE_UNLIMITED);
+    av_bprintf(&buf, "%-32s %11s %10s %10s %10s %10s %10s %6s\n",
+               "filter", "activations", "real_ms", "cpu_ms",
+               "frames_in", "frames_out", "alloc_kB", "queue");
+    for (i = 0; i < graph->nb_filters; i++) {
+        AVFilterContext *filter = graph->filters[i];
+        AVFilterProfile profile;
+
+        avfilter_get_profile(filter, &profile);
+        av_bprintf(&buf, "%-32s %11"PRId64" %10.3f %10.3f %10"PRId64" %10"PRId64
+                   " %10"PRId64" %6d\n",
+                   filter->name, profile.nb_activations,
+                   profile.real_time / 1000.0, profile.cpu_time / 1000.0,
+                   profile.frames_in, profile.frames_out,
+                   profile.bytes_alloc >> 10, profile.max_queued);
+    }
+    if (!av_bprint_is_complete(&buf)) {
+        av_bprint_finalize(&buf, NULL);
+        return NULL;
+    }
+    av_bprint_finalize(&buf, &dump);
+    return dump;
+}
+
 char *avfilter_graph_dump(AVFilterGraph *graph, const char *options)
 {
     AVBPrint buf;
@@ -29,6 +29,8 @@ typedef struct FlipContext {
     int max_step[4];    ///< max pixel step for each plane, expressed as a number of bytes
     int planewidth[4];  ///< width of each plane
     int planeheight[4]; ///< height of each plane
+    uint8_t *line_buf;  ///< one line per job for flipping frames in place
+    int line_size;      ///< size of a line in line_buf
 
     void (*flip_line[4])(const uint8_t *src, uint8_t *dst, int w);
 } FlipContext;
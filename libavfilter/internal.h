@@ -24,7 +24,10 @@
  * internal API functions
  */
 
+#include <stdatomic.h>
+
 #include "libavutil/internal.h"
+#include "libavutil/thread.h"
 #include "avfilter.h"
 #include "formats.h"
 #include "framepool.h"
@@ -143,18 +146,91 @@ struct AVFilterPad {
      * input pads only.
      */
     int needs_writable;
+
+    /**
+     * The filter can write its output into the frames received on this
+     * input instead of allocating new ones. The graph enables it on the link
+     * when the filter has a single input and output with the same frame
+     * geometry, see ff_inlink_frame_inplace().
+     *
+     * input pads only.
+     */
+    int inplace;
 };
 
 struct AVFilterGraphInternal {
     void *thread;
     avfilter_execute_func *thread_execute;
     FFFrameQueueGlobal frame_queues;
+
+    /**
+     * Activate frame_jobs[0..nb_jobs-1] concurrently and store the return
+     * values in frame_rets. Set when AVFILTER_THREAD_FRAME is in use.
+     */
+    void (*frame_execute)(AVFilterGraph *graph, int nb_jobs);
+    AVFilterContext **frame_jobs;
+    int *frame_rets;
+    int nb_frame_jobs;              ///< allocated size of frame_jobs and frame_rets
+    unsigned frame_stamp;
+    /**
+     * Protects sink_links while filters are activated concurrently.
+     */
+    AVMutex heap_lock;
+
+    /**
+     * Frame pools shared by the links of the graph with the same frame
+     * geometry, see ff_graph_frame_pool_video().
+     */
+    FFFramePool **video_pools;
+    int nb_video_pools;
+    FFFramePool **audio_pools;
+    int nb_audio_pools;
+    /**
+     * Statistics of the pools no longer used by any link.
+     */
+    int64_t released_gets;
+    int64_t released_misses;
+    AVMutex pool_lock;
+
+    /**
+     * Frames copied by ff_inlink_make_frame_writable() and their size.
+     */
+    atomic_int_least64_t nb_copies;
+    atomic_int_least64_t bytes_copied;
 };
 
 struct AVFilterInternal {
     avfilter_execute_func *execute;
+
+    /**
+     * Stamp of the last ff_filter_graph_run_once() batch this filter was
+     * scheduled in or next to, see AVFilterGraphInternal.frame_stamp.
+     */
+    unsigned frame_stamp;
+
+    /**
+     * Profile counters, updated while AVFilterGraph.profile is set,
+     * see avfilter_get_profile().
+     */
+    atomic_int_least64_t nb_activations;
+    atomic_int_least64_t real_time;
+    atomic_int_least64_t cpu_time;
+    atomic_int_least64_t bytes_alloc;
+    atomic_int max_queued;
+    atomic_int_least64_t frames_in;
+    atomic_int_least64_t frames_out;
 };
 
+/**
+ * Account a frame allocated by a filter in its profile.
+ */
+void ff_filter_profile_alloc(AVFilterContext *filter, const AVFrame *frame);
+
+/**
+ * CPU time used by the calling thread, in microseconds, or 0 if unknown.
+ */
+int64_t ff_filter_cpu_time(void);
+
 /**
  * Tell if an integer is contained in the provided -1-terminated list of integers.
  * This is useful for determining (for instance) if an AVPixelFormat is in an
@@ -389,6 +465,25 @@ void ff_filter_graph_remove_filter(AVFilterGraph *graph, AVFilterContext *filter
  */
 int ff_filter_graph_run_once(AVFilterGraph *graph);
 
+/**
+ * Get a reference to the frame pool of the graph allocating video frames of
+ * the given geometry, creating it if no link of the graph uses one yet.
+ * The pools no longer used by any link are released.
+ * This function may be called simultaneously from multiple threads.
+ *
+ * @return a new reference to be released with ff_frame_pool_uninit(),
+ *         NULL on error
+ */
+FFFramePool *ff_graph_frame_pool_video(AVFilterGraph *graph, int width, int height,
+                                       enum AVPixelFormat format, int align);
+
+/**
+ * Audio counterpart of ff_graph_frame_pool_video().
+ */
+FFFramePool *ff_graph_frame_pool_audio(AVFilterGraph *graph, int channels,
+                                       int nb_samples, enum AVSampleFormat format,
+                                       int align);
+
 /**
  * Normalize the qscale factor
  * FIXME the H264 qscale is a log based scale, mpeg1/2 is not, the code below
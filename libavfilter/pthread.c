@@ -38,18 +38,37 @@ typedef struct ThreadContext {
     AVSliceThread *thread;
     avfilter_action_func *func;
 
+    /* set while filters are activated concurrently on the workers, their
+     * slice jobs then run in the thread activating them */
+    int frame_jobs;
+
     /* per-execute parameters */
     AVFilterContext *ctx;
     void *arg;
     int   *rets;
+    int    profile;
 } ThreadContext;
 
 static void worker_func(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads)
 {
     ThreadContext *c = priv;
-    int ret = c->func(c->ctx, c->arg, jobnr, nb_jobs);
+    int64_t cpu_time = 0;
+    int ret;
+
+    if (c->frame_jobs) {
+        AVFilterGraphInternal *gi = c->graph->internal;
+        gi->frame_rets[jobnr] = ff_filter_activate(gi->frame_jobs[jobnr]);
+        return;
+    }
+    if (c->profile)
+        cpu_time = ff_filter_cpu_time();
+    ret = c->func(c->ctx, c->arg, jobnr, nb_jobs);
     if (c->rets)
         c->rets[jobnr] = ret;
+    if (c->profile)
+        atomic_fetch_add_explicit(&c->ctx->internal->cpu_time,
+                                  ff_filter_cpu_time() - cpu_time,
+                                  memory_order_relaxed);
 }
 
 static void slice_thread_uninit(ThreadContext *c)
@@ -57,22 +76,60 @@ static void slice_thread_uninit(ThreadContext *c)
     avpriv_slicethread_free(&c->thread);
 }
 
+static void frame_thread_uninit(ThreadContext *c)
+{
+    AVFilterGraphInternal *gi = c->graph->internal;
+
+    gi->frame_execute = NULL;
+    gi->nb_frame_jobs = 0;
+    av_freep(&gi->frame_jobs);
+    av_freep(&gi->frame_rets);
+}
+
 static int thread_execute(AVFilterContext *ctx, avfilter_action_func *func,
                           void *arg, int *ret, int nb_jobs)
 {
     ThreadContext *c = ctx->graph->internal->thread;
+    int64_t cpu_time = 0;
 
     if (nb_jobs <= 0)
         return 0;
+    if (c->frame_jobs) {
+        /* already on a worker, which cannot wait for the others */
+        int i;
+        for (i = 0; i < nb_jobs; i++) {
+            int r = func(ctx, arg, i, nb_jobs);
+            if (ret)
+                ret[i] = r;
+        }
+        return 0;
+    }
     c->ctx         = ctx;
     c->arg         = arg;
     c->func        = func;
     c->rets        = ret;
+    c->profile     = ctx->graph->profile;
 
+    if (c->profile)
+        cpu_time = ff_filter_cpu_time();
     avpriv_slicethread_execute(c->thread, nb_jobs, 0);
+    /* the jobs run in this thread are part of the activation of the filter */
+    if (c->profile)
+        atomic_fetch_sub_explicit(&ctx->internal->cpu_time,
+                                  ff_filter_cpu_time() - cpu_time,
+                                  memory_order_relaxed);
     return 0;
 }
 
+static void frame_execute(AVFilterGraph *graph, int nb_jobs)
+{
+    ThreadContext *c = graph->internal->thread;
+
+    c->frame_jobs = 1;
+    avpriv_slicethread_execute(c->thread, nb_jobs, 0);
+    c->frame_jobs = 0;
+}
+
 static int thread_init_internal(ThreadContext *c, int nb_threads)
 {
     nb_threads = avpriv_slicethread_create(&c->thread, c, worker_func, NULL, nb_threads);
@@ -81,6 +138,21 @@ static int thread_init_internal(ThreadContext *c, int nb_threads)
     return FFMAX(nb_threads, 1);
 }
 
+/* the filters activated concurrently share the workers of slice threading */
+static int frame_thread_init(ThreadContext *c, int nb_threads)
+{
+    AVFilterGraphInternal *gi = c->graph->internal;
+
+    gi->frame_jobs = av_calloc(nb_threads, sizeof(*gi->frame_jobs));
+    gi->frame_rets = av_calloc(nb_threads, sizeof(*gi->frame_rets));
+    if (!gi->frame_jobs || !gi->frame_rets)
+        return AVERROR(ENOMEM);
+    gi->nb_frame_jobs = nb_threads;
+
+    gi->frame_execute = frame_execute;
+    return 0;
+}
+
 int ff_graph_thread_init(AVFilterGraph *graph)
 {
     int ret;
@@ -94,6 +166,8 @@ int ff_graph_thread_init(AVFilterGraph *graph)
     if (!graph->internal->thread)
         return AVERROR(ENOMEM);
 
+    ((ThreadContext *)graph->internal->thread)->graph = graph;
+
     ret = thread_init_internal(graph->internal->thread, graph->nb_threads);
     if (ret <= 1) {
         av_freep(&graph->internal->thread);
@@ -103,6 +177,16 @@ int ff_graph_thread_init(AVFilterGraph *graph)
     }
     graph->nb_threads = ret;
 
+    if (graph->thread_type & AVFILTER_THREAD_FRAME) {
+        ret = frame_thread_init(graph->internal->thread, graph->nb_threads);
+        if (ret < 0) {
+            ff_graph_thread_free(graph);
+            graph->thread_type = 0;
+            graph->nb_threads  = 1;
+            return ret;
+        }
+    }
+
     graph->internal->thread_execute = thread_execute;
 
     return 0;
@@ -110,7 +194,9 @@ int ff_graph_thread_init(AVFilterGraph *graph)
 
 void ff_graph_thread_free(AVFilterGraph *graph)
 {
-    if (graph->internal->thread)
+    if (graph->internal->thread) {
+        frame_thread_uninit(graph->internal->thread);
         slice_thread_uninit(graph->internal->thread);
+    }
     av_freep(&graph->internal->thread);
 }
@@ -27,6 +27,7 @@
  * very simple video equalizer
  */
 
+#include "libavfilter/filters.h"
 #include "libavfilter/internal.h"
 #include "libavutil/common.h"
 #include "libavutil/imgutils.h"
@@ -256,15 +257,20 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
     AVFrame *out;
     int64_t pos = in->pkt_pos;
     const AVPixFmtDescriptor *desc;
-    int i;
-
-    out = ff_get_video_buffer(outlink, inlink->w, inlink->h);
-    if (!out) {
-        av_frame_free(&in);
-        return AVERROR(ENOMEM);
+    int i, direct = 0;
+
+    if (ff_inlink_frame_inplace(inlink, in)) {
+        direct = 1;
+        out = in;
+    } else {
+        out = ff_get_video_buffer(outlink, inlink->w, inlink->h);
+        if (!out) {
+            av_frame_free(&in);
+            return AVERROR(ENOMEM);
+        }
+        av_frame_copy_props(out, in);
     }
 
-    av_frame_copy_props(out, in);
     desc = av_pix_fmt_desc_get(inlink->format);
 
     eq->var_values[VAR_N]   = inlink->frame_count_out;
@@ -290,12 +296,13 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
         if (eq->param[i].adjust)
             eq->param[i].adjust(&eq->param[i], out->data[i], out->linesize[i],
                                  in->data[i], in->linesize[i], w, h);
-        else
+        else if (!direct)
             av_image_copy_plane(out->data[i], out->linesize[i],
                                 in->data[i], in->linesize[i], w, h);
     }
 
-    av_frame_free(&in);
+    if (!direct)
+        av_frame_free(&in);
     return ff_filter_frame(outlink, out);
 }
 
@@ -336,6 +343,7 @@ static const AVFilterPad eq_inputs[] = {
         .type = AVMEDIA_TYPE_VIDEO,
         .filter_frame = filter_frame,
         .config_props = config_props,
+        .inplace      = 1,
     },
     { NULL }
 };
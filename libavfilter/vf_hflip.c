@@ -28,6 +28,7 @@
 
 #include "libavutil/opt.h"
 #include "avfilter.h"
+#include "filters.h"
 #include "formats.h"
 #include "hflip.h"
 #include "internal.h"
@@ -131,7 +132,7 @@ static int config_props(AVFilterLink *inlink)
     const AVPixFmtDescriptor *pix_desc = av_pix_fmt_desc_get(inlink->format);
     const int hsub = pix_desc->log2_chroma_w;
     const int vsub = pix_desc->log2_chroma_h;
-    int nb_planes;
+    int i, nb_planes;
 
     av_image_fill_max_pixsteps(s->max_step, NULL, pix_desc);
     s->planewidth[0]  = s->planewidth[3]  = inlink->w;
@@ -141,6 +142,14 @@ static int config_props(AVFilterLink *inlink)
 
     nb_planes = av_pix_fmt_count_planes(inlink->format);
 
+    s->line_size = 0;
+    for (i = 0; i < nb_planes; i++)
+        s->line_size = FFMAX(s->line_size, FFALIGN(s->planewidth[i] * s->max_step[i], 32));
+    av_freep(&s->line_buf);
+    s->line_buf = av_malloc_array(ff_filter_get_nb_threads(inlink->dst), s->line_size);
+    if (!s->line_buf)
+        return AVERROR(ENOMEM);
+
     return ff_hflip_init(s, s->max_step, nb_planes);
 }
 
@@ -189,6 +198,18 @@ static int filter_slice(AVFilterContext *ctx, void *arg, int job, int nb_jobs)
 
         outrow = out->data[plane] + start * out->linesize[plane];
         inrow  = in ->data[plane] + start * in->linesize[plane] + (width - 1) * step;
+        if (in == out) {
+            uint8_t *line = s->line_buf + job * s->line_size;
+
+            for (i = start; i < end; i++) {
+                s->flip_line[plane](inrow, line, width);
+                memcpy(outrow, line, width * step);
+
+                inrow  += in ->linesize[plane];
+                outrow += out->linesize[plane];
+            }
+            continue;
+        }
         for (i = start; i < end; i++) {
             s->flip_line[plane](inrow, outrow, width);
 
@@ -207,30 +228,43 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
     ThreadData td;
     AVFrame *out;
 
-    out = ff_get_video_buffer(outlink, outlink->w, outlink->h);
-    if (!out) {
-        av_frame_free(&in);
-        return AVERROR(ENOMEM);
-    }
-    av_frame_copy_props(out, in);
+    if (ff_inlink_frame_inplace(inlink, in)) {
+        out = in;
+    } else {
+        out = ff_get_video_buffer(outlink, outlink->w, outlink->h);
+        if (!out) {
+            av_frame_free(&in);
+            return AVERROR(ENOMEM);
+        }
+        av_frame_copy_props(out, in);
 
-    /* copy palette if required */
-    if (av_pix_fmt_desc_get(inlink->format)->flags & AV_PIX_FMT_FLAG_PAL)
-        memcpy(out->data[1], in->data[1], AVPALETTE_SIZE);
+        /* copy palette if required */
+        if (av_pix_fmt_desc_get(inlink->format)->flags & AV_PIX_FMT_FLAG_PAL)
+            memcpy(out->data[1], in->data[1], AVPALETTE_SIZE);
+    }
 
     td.in = in, td.out = out;
     ctx->internal->execute(ctx, filter_slice, &td, NULL, FFMIN(outlink->h, ff_filter_get_nb_threads(ctx)));
 
-    av_frame_free(&in);
+    if (out != in)
+        av_frame_free(&in);
     return ff_filter_frame(outlink, out);
 }
 
+static av_cold void uninit(AVFilterContext *ctx)
+{
+    FlipContext *s = ctx->priv;
+
+    av_freep(&s->line_buf);
+}
+
 static const AVFilterPad avfilter_vf_hflip_inputs[] = {
     {
         .name         = "default",
         .type         = AVMEDIA_TYPE_VIDEO,
         .filter_frame = filter_frame,
         .config_props = config_props,
+        .inplace      = 1,
     },
     { NULL }
 };
@@ -249,6 +283,7 @@ AVFilter ff_vf_hflip = {
     .priv_size     = sizeof(FlipContext),
     .priv_class    = &hflip_class,
     .query_formats = query_formats,
+    .uninit        = uninit,
     .inputs        = avfilter_vf_hflip_inputs,
     .outputs       = avfilter_vf_hflip_outputs,
     .flags         = AVFILTER_FLAG_SLICE_THREADS | AVFILTER_FLAG_SUPPORT_TIMELINE_GENERIC,
@@ -32,6 +32,7 @@
 #include "libavutil/pixdesc.h"
 #include "avfilter.h"
 #include "drawutils.h"
+#include "filters.h"
 #include "formats.h"
 #include "internal.h"
 #include "video.h"
@@ -526,7 +527,7 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
     AVFrame *out;
     int direct = 0;
 
-    if (av_frame_is_writable(in)) {
+    if (ff_inlink_frame_inplace(inlink, in)) {
         direct = 1;
         out = in;
     } else {
@@ -571,6 +572,7 @@ static const AVFilterPad inputs[] = {
       .type         = AVMEDIA_TYPE_VIDEO,
       .filter_frame = filter_frame,
       .config_props = config_props,
+      .inplace      = 1,
     },
     { NULL }
 };
@@ -28,16 +28,9 @@
 #include "libavutil/opt.h"
 #include "libavutil/hwcontext.h"
 #include "libavutil/hwcontext_vpe.h"
-
-typedef struct VpePPFrame {
-    AVFrame *av_frame;
-    // frame structure used for external hw device
-    VpiFrame *vpi_frame;
-    // vpi_frame has been used
-    int used;
-    // the next linked list item
-    struct VpePPFrame *next;
-} VpePPFrame;
+#include "libavutil/hwcontext_vpe_internal.h"
+#include "libavutil/vpe_frame_pool.h"
+#include "libavutil/vpe_stats.h"
 
 typedef struct VpePPFilter {
     const AVClass *av_class;
@@ -57,8 +50,11 @@ typedef struct VpePPFilter {
     char *low_res;
     /*pp option*/
     VpiPPOption *option;
-    /*VPE frame linked list*/
-    VpePPFrame *frame_list;
+    /*VPE frames lent to the external hw device*/
+    VpeFramePool frame_pool;
+    /*process() latency, logged and set in the frame metadata only: the call
+      is synchronous, so there is no depth to report*/
+    VpeStats stats;
 } VpePPFilter;
 
 static const enum AVPixelFormat input_pix_fmts[] = {
@@ -106,6 +102,9 @@ static av_cold int vpe_pp_init(AVFilterContext *avf_ctx)
 {
     int ret         = 0;
     AVFilterPad pad = { 0 };
+    VpePPFilter *ctx = avf_ctx->priv;
+
+    ctx->stats.sync = 1;
 
     pad.type = AVMEDIA_TYPE_VIDEO;
     pad.name = "output0";
@@ -118,33 +117,25 @@ static av_cold int vpe_pp_init(AVFilterContext *avf_ctx)
 static av_cold void vpe_pp_uninit(AVFilterContext *avf_ctx)
 {
     AVHWFramesContext *hwframe_ctx;
-    AVHWDeviceContext *hwdevice_ctx;
-    AVVpeDeviceContext *vpedev_ctx;
+    AVVpeFramesContext *vpeframe_ctx;
     VpePPFilter *ctx = avf_ctx->priv;
-    VpePPFrame *cur_frame;
+    int device;
 
+    avpriv_vpe_stats_log(avf_ctx, "pp", &ctx->stats);
     if (ctx->hw_device) {
-        if (!avf_ctx->hw_device_ctx) {
-            hwframe_ctx = (AVHWFramesContext *)ctx->hw_frame->data;
-            vpedev_ctx  = hwframe_ctx->device_ctx->hwctx;
-        } else {
-            hwdevice_ctx = (AVHWDeviceContext *)avf_ctx->hw_device_ctx->data;
-            vpedev_ctx   = (AVVpeDeviceContext *)hwdevice_ctx->hwctx;
-        }
+        hwframe_ctx  = (AVHWFramesContext *)ctx->hw_frame->data;
+        vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
+        device       = vpeframe_ctx->device;
 
         ctx->vpi->close(ctx->ctx);
 
-        cur_frame = ctx->frame_list;
-        while (cur_frame) {
-            ctx->frame_list = cur_frame->next;
-            av_frame_free(&cur_frame->av_frame);
-            av_freep(&cur_frame);
-            cur_frame = ctx->frame_list;
-        }
+        avpriv_vpe_frame_pool_uninit(&ctx->frame_pool);
 
+        if (ctx->ctx)
+            avpriv_vpe_device_session_add(hwframe_ctx, -1);
         av_buffer_unref(&ctx->hw_frame);
         av_buffer_unref(&ctx->hw_device);
-        vpi_destroy(ctx->ctx, vpedev_ctx->device);
+        vpi_destroy(ctx->ctx, device);
         avf_ctx->priv = NULL;
     }
 }
@@ -164,82 +155,49 @@ static void vpe_pp_output_vpeframe(AVFrame *input, VpiFrame *output)
     output->data[2]     = input->data[2];
 }
 
-/**
- * alloc frame from hwcontext for pp filter
- */
-static int vpe_pp_alloc_frame(AVFilterLink *outlink, VpePPFrame *pp_frame)
-{
-    AVFrame *frame;
-
-    frame = ff_get_video_buffer(outlink, outlink->w, outlink->h);
-    if (!frame) {
-        av_log(outlink, AV_LOG_ERROR, "Failed to allocate frame to pp_vpe to.\n");
-        return AVERROR(ENOMEM);
-    }
-
-    pp_frame->av_frame  = frame;
-    pp_frame->vpi_frame = (VpiFrame*)frame->data[0];
-    pp_frame->used      = 1;
-
-    return 0;
-}
-
 /**
  * clear the unsed frames
  */
 static void vpe_pp_clear_unused_frames(VpePPFilter *ctx)
 {
-    VpePPFrame *cur_frame = ctx->frame_list;
-
-    while (cur_frame) {
-        if (cur_frame->used
-            && !cur_frame->vpi_frame->locked) {
-            cur_frame->used = 0;
-            av_frame_unref(cur_frame->av_frame);
-        }
-        cur_frame = cur_frame->next;
-    }
+    avpriv_vpe_frame_pool_release_unlocked(&ctx->frame_pool, NULL, NULL);
 }
 
 /**
- * get frame from the linked list
+ * alloc frame from hwcontext for pp filter, the frame pool keeps a
+ * reference until the hw device unlocks it
  */
 static int vpe_pp_get_frame(AVFilterLink *inlink, AVFrame **frame)
 {
     AVFilterContext *avf_ctx = inlink->dst;
     AVFilterLink *outlink    = avf_ctx->outputs[0];
     VpePPFilter *ctx         = avf_ctx->priv;
-    VpePPFrame *pp_frame, **last;
+    VpeFramePoolEntry *entry;
+    AVFrame *out;
     int ret;
 
     vpe_pp_clear_unused_frames(ctx);
 
-    pp_frame = ctx->frame_list;
-    last     = &ctx->frame_list;
-    while (pp_frame) {
-        if (!pp_frame->used) {
-            ret = vpe_pp_alloc_frame(outlink, pp_frame);
-            if (ret < 0)
-                return ret;
-            *frame = pp_frame->av_frame;
-            return 0;
-        }
-
-        last     = &pp_frame->next;
-        pp_frame = pp_frame->next;
-    }
+    ret = avpriv_vpe_frame_pool_get(&ctx->frame_pool, &entry);
+    if (ret < 0)
+        return ret;
 
-    pp_frame = av_mallocz(sizeof(*pp_frame));
-    if (!pp_frame)
+    out = ff_get_video_buffer(outlink, outlink->w, outlink->h);
+    if (!out) {
+        av_log(outlink, AV_LOG_ERROR, "Failed to allocate frame to pp_vpe to.\n");
+        avpriv_vpe_frame_pool_release(&ctx->frame_pool, entry);
         return AVERROR(ENOMEM);
+    }
 
-    *last = pp_frame;
-
-    ret = vpe_pp_alloc_frame(outlink, pp_frame);
-    if (ret < 0)
+    ret = av_frame_ref(entry->frame, out);
+    if (ret < 0) {
+        av_frame_free(&out);
+        avpriv_vpe_frame_pool_release(&ctx->frame_pool, entry);
         return ret;
+    }
+    avpriv_vpe_frame_pool_publish(&ctx->frame_pool, entry);
 
-    *frame = pp_frame->av_frame;
+    *frame = out;
 
     return 0;
 }
@@ -248,11 +206,12 @@ static int vpe_pp_filter_frame(AVFilterLink *inlink, AVFrame *frame)
 {
     AVFilterContext *avf_ctx = inlink->dst;
     AVFilterLink *outlink    = avf_ctx->outputs[0];
-    AVFrame *pp_frame, *out = NULL;
-    VpePPFilter *ctx = avf_ctx->priv;
+    AVFrame *pp_frame = NULL;
+    VpePPFilter *ctx  = avf_ctx->priv;
     AVHWFramesContext *hwframe_ctx;
     AVVpeFramesContext *vpeframe_ctx;
     VpiFrame *in_picture, *out_picture;
+    int64_t latency;
     int ret = 0;
 
     hwframe_ctx  = (AVHWFramesContext *)ctx->hw_frame->data;
@@ -266,6 +225,10 @@ static int vpe_pp_filter_frame(AVFilterLink *inlink, AVFrame *frame)
         }
         vpe_pp_output_vpeframe(frame, in_picture);
     } else {
+        // the previous filter is hwupload, the upload may still be running
+        ret = avpriv_vpe_frame_wait(frame);
+        if (ret < 0)
+            goto fail;
         in_picture = (VpiFrame *)frame->data[0];
     }
 
@@ -273,7 +236,9 @@ static int vpe_pp_filter_frame(AVFilterLink *inlink, AVFrame *frame)
     if (ret)
         goto fail;
 
+    avpriv_vpe_stats_submit(&ctx->stats, 0);
     ret = ctx->vpi->process(ctx->ctx, in_picture, pp_frame->data[0]);
+    latency = avpriv_vpe_stats_complete(&ctx->stats, 0);
     if (ret) {
         ret = AVERROR_EXTERNAL;
         goto fail;
@@ -282,6 +247,8 @@ static int vpe_pp_filter_frame(AVFilterLink *inlink, AVFrame *frame)
     ret = av_frame_copy_props(pp_frame, frame);
     if (ret)
         goto fail;
+    avpriv_vpe_stats_export(&ctx->stats, &pp_frame->metadata, "lavfi.vpe_pp",
+                            latency);
 
     out_picture = (VpiFrame *)pp_frame->data[0];
 
@@ -300,19 +267,14 @@ static int vpe_pp_filter_frame(AVFilterLink *inlink, AVFrame *frame)
     if (ret < 0)
         goto fail;
 
-    out = av_frame_alloc();
-    if (!out) {
-        ret = AVERROR(ENOMEM);
-        goto fail;
-    }
-
     av_frame_free(&frame);
-    av_frame_ref(out, pp_frame);
-    return ff_filter_frame(outlink, out);
+    return ff_filter_frame(outlink, pp_frame);
 
 fail:
+    if (inlink->format != AV_PIX_FMT_VPE)
+        av_freep(&in_picture);
     av_frame_free(&frame);
-    av_frame_free(&out);
+    av_frame_free(&pp_frame);
     return ret;
 }
 
@@ -370,8 +332,6 @@ static int vpe_pp_config_props(AVFilterLink *inlink)
     AVFilterContext *avf_ctx = inlink->dst;
     AVHWFramesContext *hwframe_ctx;
     AVVpeFramesContext *vpeframe_ctx;
-    AVHWDeviceContext *hwdevice_ctx;
-    AVVpeDeviceContext *vpedev_ctx;
     VpePPFilter *ctx = avf_ctx->priv;
     VpiPPOption *option;
     VpiCtrlCmdParam cmd;
@@ -383,16 +343,12 @@ static int vpe_pp_config_props(AVFilterLink *inlink)
 
     hwframe_ctx  = (AVHWFramesContext *)ctx->hw_frame->data;
     vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
-    if (!avf_ctx->hw_device_ctx) {
-        vpedev_ctx = hwframe_ctx->device_ctx->hwctx;
-    } else {
-        hwdevice_ctx = (AVHWDeviceContext *)avf_ctx->hw_device_ctx->data;
-        vpedev_ctx   = (AVVpeDeviceContext *)hwdevice_ctx->hwctx;
-    }
 
-    ret = vpi_create(&ctx->ctx, &ctx->vpi, vpedev_ctx->device, PP_VPE);
+    // the session runs on the device holding the frames
+    ret = vpi_create(&ctx->ctx, &ctx->vpi, vpeframe_ctx->device, PP_VPE);
     if (ret)
         return AVERROR_EXTERNAL;
+    avpriv_vpe_device_session_add(hwframe_ctx, 1);
 
     // get the pp option struct
     cmd.cmd = VPI_CMD_PP_INIT_OPTION;
@@ -47,10 +47,31 @@ enum EvalMode {
     EVAL_MODE_NB
 };
 
+/**
+ * A horizontal band of the output scaled by a thread of its own.
+ *
+ * The band is scaled together with margin rows above and below it, so the
+ * taps of the vertical filter see the same input rows as when scaling the
+ * whole picture, then copied to the output frame.
+ */
+typedef struct ScaleBand {
+    struct SwsContext *sws;
+    AVFrame *frame;             ///< the band and its margins
+    int in_y, in_h;             ///< input rows scaled
+    int out_y, out_h;           ///< output rows of the band
+    int margin;                 ///< rows of frame above out_y
+} ScaleBand;
+
+typedef struct ThreadData {
+    AVFrame *in, *out;
+} ThreadData;
+
 typedef struct ScaleContext {
     const AVClass *class;
     struct SwsContext *sws;     ///< software scaler context
     struct SwsContext *isws[2]; ///< software scaler context for interlaced material
+    ScaleBand *bands;           ///< bands scaled in parallel for progressive frames
+    int nb_bands;
     AVDictionary *opts;
 
     /**
@@ -65,6 +86,7 @@ typedef struct ScaleContext {
     double param[2];            // sws params
 
     int hsub, vsub;             ///< chroma subsampling
+    int out_vsub;               ///< output chroma vertical subsampling
     int slice_y;                ///< top of current output slice
     int input_is_pal;           ///< set to 1 if the input format is paletted
     int output_is_pal;          ///< set to 1 if the output format is paletted
@@ -145,6 +167,18 @@ static av_cold int init_dict(AVFilterContext *ctx, AVDictionary **opts)
     return 0;
 }
 
+static void free_bands(ScaleContext *scale)
+{
+    int i;
+
+    for (i = 0; i < scale->nb_bands; i++) {
+        sws_freeContext(scale->bands[i].sws);
+        av_frame_free(&scale->bands[i].frame);
+    }
+    av_freep(&scale->bands);
+    scale->nb_bands = 0;
+}
+
 static av_cold void uninit(AVFilterContext *ctx)
 {
     ScaleContext *scale = ctx->priv;
@@ -152,6 +186,7 @@ static av_cold void uninit(AVFilterContext *ctx)
     sws_freeContext(scale->isws[0]);
     sws_freeContext(scale->isws[1]);
     scale->sws = NULL;
+    free_bands(scale);
     av_dict_free(&scale->opts);
 }
 
@@ -217,6 +252,176 @@ static const int *parse_yuv_type(const char *s, enum AVColorSpace colorspace)
     return sws_getCoefficients(colorspace);
 }
 
+/**
+ * Allocate and initialize a scaler from srch rows of inlink0 to dsth rows of
+ * outlink. field is 0 for progressive material, 1 and 2 for the top and
+ * bottom fields of interlaced material.
+ */
+static int init_sws(ScaleContext *scale, struct SwsContext **s,
+                    AVFilterLink *inlink0, AVFilterLink *outlink,
+                    enum AVPixelFormat outfmt, int srch, int dsth, int field)
+{
+    int in_v_chr_pos = scale->in_v_chr_pos, out_v_chr_pos = scale->out_v_chr_pos;
+    int ret;
+
+    *s = sws_alloc_context();
+    if (!*s)
+        return AVERROR(ENOMEM);
+
+    av_opt_set_int(*s, "srcw", inlink0 ->w, 0);
+    av_opt_set_int(*s, "srch", srch, 0);
+    av_opt_set_int(*s, "src_format", inlink0->format, 0);
+    av_opt_set_int(*s, "dstw", outlink->w, 0);
+    av_opt_set_int(*s, "dsth", dsth, 0);
+    av_opt_set_int(*s, "dst_format", outfmt, 0);
+    av_opt_set_int(*s, "sws_flags", scale->flags, 0);
+    av_opt_set_int(*s, "param0", scale->param[0], 0);
+    av_opt_set_int(*s, "param1", scale->param[1], 0);
+    if (scale->in_range != AVCOL_RANGE_UNSPECIFIED)
+        av_opt_set_int(*s, "src_range",
+                       scale->in_range == AVCOL_RANGE_JPEG, 0);
+    if (scale->out_range != AVCOL_RANGE_UNSPECIFIED)
+        av_opt_set_int(*s, "dst_range",
+                       scale->out_range == AVCOL_RANGE_JPEG, 0);
+
+    if (scale->opts) {
+        AVDictionaryEntry *e = NULL;
+        while ((e = av_dict_get(scale->opts, "", e, AV_DICT_IGNORE_SUFFIX))) {
+            if ((ret = av_opt_set(*s, e->key, e->value, 0)) < 0)
+                return ret;
+        }
+    }
+    /* Override YUV420P default settings to have the correct (MPEG-2) chroma positions
+     * MPEG-2 chroma positions are used by convention
+     * XXX: support other 4:2:0 pixel formats */
+    if (inlink0->format == AV_PIX_FMT_YUV420P && scale->in_v_chr_pos == -513) {
+        in_v_chr_pos = (field == 0) ? 128 : (field == 1) ? 64 : 192;
+    }
+
+    if (outlink->format == AV_PIX_FMT_YUV420P && scale->out_v_chr_pos == -513) {
+        out_v_chr_pos = (field == 0) ? 128 : (field == 1) ? 64 : 192;
+    }
+
+    av_opt_set_int(*s, "src_h_chr_pos", scale->in_h_chr_pos, 0);
+    av_opt_set_int(*s, "src_v_chr_pos", in_v_chr_pos, 0);
+    av_opt_set_int(*s, "dst_h_chr_pos", scale->out_h_chr_pos, 0);
+    av_opt_set_int(*s, "dst_v_chr_pos", out_v_chr_pos, 0);
+
+    return sws_init_context(*s, NULL, NULL);
+}
+
+/**
+ * Number of input rows the vertical filter of the scaler spans per output
+ * row when not downscaling, see initFilter() in libswscale.
+ */
+static int sws_size_factor(int flags, double param0)
+{
+    int size = 2;
+
+    if (flags & (SWS_BICUBIC | SWS_BICUBLIN))
+        size = 4;
+    if (flags & SWS_LANCZOS)
+        size = FFMAX(size, param0 != SWS_PARAM_DEFAULT ? ceil(2 * param0) : 6);
+    return size;
+}
+
+/**
+ * Split the output into bands scaled in parallel.
+ *
+ * A band scaler sees the picture through a window of whole rows, so its
+ * vertical filter matches the one of the full picture scaler only when the
+ * window starts on an input row mapped exactly to an output row, i.e. when
+ * the fixed point scaling steps of libswscale are exact. The windows also
+ * start on a multiple of 8 chroma rows to keep the ordered dither pattern.
+ * Bands are not used when these conditions do not hold, for paletted and
+ * low depth formats, which may be error diffusion dithered, nor for the
+ * kernels without a finite support, whose taps libswscale trims depending on
+ * all the rows scaled.
+ */
+static int init_bands(AVFilterContext *ctx, AVFilterLink *inlink0,
+                      AVFilterLink *outlink, enum AVPixelFormat outfmt)
+{
+    ScaleContext *scale = ctx->priv;
+    const AVPixFmtDescriptor *idesc = av_pix_fmt_desc_get(inlink0->format);
+    const AVPixFmtDescriptor *odesc = av_pix_fmt_desc_get(outfmt);
+    int nb_threads = ff_filter_get_nb_threads(ctx);
+    int in_h = inlink0->h, out_h = outlink->h;
+    int ivsub = idesc->log2_chroma_h, ovsub = odesc->log2_chroma_h;
+    int in_step, out_step, unit_in, unit_out, margin_in, margin_out;
+    int nb_units, i, ret;
+
+    if (nb_threads <= 1 || scale->interlaced > 0 || scale->nb_slices ||
+        scale->input_is_pal || scale->output_is_pal ||
+        odesc->comp[0].depth < 8 || !in_h || !out_h ||
+        scale->flags & (SWS_GAUSS | SWS_SINC | SWS_SPLINE | SWS_X) ||
+        in_h & ((1 << ivsub) - 1) || out_h & ((1 << ovsub) - 1) ||
+        ((int64_t)in_h << 16) % out_h ||
+        ((int64_t)(in_h >> ivsub) << 16) % (out_h >> ovsub))
+        return 0;
+
+    /* smallest band boundary step mapping input rows to output rows */
+    out_step = out_h / av_gcd(in_h, out_h);
+    in_step  = in_h  / av_gcd(in_h, out_h);
+    unit_out = out_step * (8 << ovsub) / av_gcd(out_step, 8 << ovsub);
+    unit_in  = unit_out / out_step * in_step;
+    while (unit_in & ((1 << ivsub) - 1)) {
+        unit_out *= 2;
+        unit_in  *= 2;
+    }
+
+    /* half the filter taps and some slack for the alignment of the filter */
+    margin_in  = (sws_size_factor(scale->flags, scale->param[0]) *
+                  FFMAX(in_step, out_step) / out_step / 2 + 4) << ivsub;
+    margin_out = (margin_in + unit_in - 1) / unit_in * unit_out;
+
+    /* keep the bands at least as high as their margins */
+    nb_units   = out_h / unit_out;
+    nb_threads = FFMIN(nb_threads, nb_units / (margin_out / unit_out));
+    if (nb_threads <= 1)
+        return 0;
+
+    scale->bands = av_calloc(nb_threads, sizeof(*scale->bands));
+    if (!scale->bands)
+        return AVERROR(ENOMEM);
+    scale->nb_bands = nb_threads;
+
+    for (i = 0; i < scale->nb_bands; i++) {
+        ScaleBand *b = &scale->bands[i];
+        int start = nb_units *  i      / scale->nb_bands * unit_out;
+        int end   = i == scale->nb_bands - 1 ? out_h :
+                    nb_units * (i + 1) / scale->nb_bands * unit_out;
+        int win_start = FFMAX(start - margin_out, 0);
+        int win_end   = FFMIN(end + margin_out, out_h);
+
+        b->out_y  = start;
+        b->out_h  = end - start;
+        b->margin = start - win_start;
+        b->in_y   = win_start / unit_out * unit_in;
+        b->in_h   = win_end == out_h ? in_h - b->in_y :
+                    win_end / unit_out * unit_in - b->in_y;
+
+        if ((ret = init_sws(scale, &b->sws, inlink0, outlink, outfmt,
+                            b->in_h, win_end - win_start, 0)) < 0)
+            return ret;
+
+        b->frame = av_frame_alloc();
+        if (!b->frame)
+            return AVERROR(ENOMEM);
+        b->frame->format = outlink->format;
+        b->frame->width  = outlink->w;
+        b->frame->height = win_end - win_start;
+        if ((ret = av_frame_get_buffer(b->frame, 0)) < 0)
+            return ret;
+    }
+
+    /* progressive frames are only scaled by the bands */
+    sws_freeContext(scale->sws);
+    scale->sws = NULL;
+
+    av_log(ctx, AV_LOG_VERBOSE, "Scaling in %d bands.\n", scale->nb_bands);
+    return 0;
+}
+
 static int config_props(AVFilterLink *outlink)
 {
     AVFilterContext *ctx = outlink->src;
@@ -273,6 +478,8 @@ static int config_props(AVFilterLink *outlink)
     if (scale->isws[1])
         sws_freeContext(scale->isws[1]);
     scale->isws[0] = scale->isws[1] = scale->sws = NULL;
+    free_bands(scale);
+    scale->out_vsub = av_pix_fmt_desc_get(outfmt)->log2_chroma_h;
     if (inlink0->w == outlink->w &&
         inlink0->h == outlink->h &&
         !scale->out_color_matrix &&
@@ -284,56 +491,14 @@ static int config_props(AVFilterLink *outlink)
         int i;
 
         for (i = 0; i < 3; i++) {
-            int in_v_chr_pos = scale->in_v_chr_pos, out_v_chr_pos = scale->out_v_chr_pos;
-            struct SwsContext **s = swscs[i];
-            *s = sws_alloc_context();
-            if (!*s)
-                return AVERROR(ENOMEM);
-
-            av_opt_set_int(*s, "srcw", inlink0 ->w, 0);
-            av_opt_set_int(*s, "srch", inlink0 ->h >> !!i, 0);
-            av_opt_set_int(*s, "src_format", inlink0->format, 0);
-            av_opt_set_int(*s, "dstw", outlink->w, 0);
-            av_opt_set_int(*s, "dsth", outlink->h >> !!i, 0);
-            av_opt_set_int(*s, "dst_format", outfmt, 0);
-            av_opt_set_int(*s, "sws_flags", scale->flags, 0);
-            av_opt_set_int(*s, "param0", scale->param[0], 0);
-            av_opt_set_int(*s, "param1", scale->param[1], 0);
-            if (scale->in_range != AVCOL_RANGE_UNSPECIFIED)
-                av_opt_set_int(*s, "src_range",
-                               scale->in_range == AVCOL_RANGE_JPEG, 0);
-            if (scale->out_range != AVCOL_RANGE_UNSPECIFIED)
-                av_opt_set_int(*s, "dst_range",
-                               scale->out_range == AVCOL_RANGE_JPEG, 0);
-
-            if (scale->opts) {
-                AVDictionaryEntry *e = NULL;
-                while ((e = av_dict_get(scale->opts, "", e, AV_DICT_IGNORE_SUFFIX))) {
-                    if ((ret = av_opt_set(*s, e->key, e->value, 0)) < 0)
-                        return ret;
-                }
-            }
-            /* Override YUV420P default settings to have the correct (MPEG-2) chroma positions
-             * MPEG-2 chroma positions are used by convention
-             * XXX: support other 4:2:0 pixel formats */
-            if (inlink0->format == AV_PIX_FMT_YUV420P && scale->in_v_chr_pos == -513) {
-                in_v_chr_pos = (i == 0) ? 128 : (i == 1) ? 64 : 192;
-            }
-
-            if (outlink->format == AV_PIX_FMT_YUV420P && scale->out_v_chr_pos == -513) {
-                out_v_chr_pos = (i == 0) ? 128 : (i == 1) ? 64 : 192;
-            }
-
-            av_opt_set_int(*s, "src_h_chr_pos", scale->in_h_chr_pos, 0);
-            av_opt_set_int(*s, "src_v_chr_pos", in_v_chr_pos, 0);
-            av_opt_set_int(*s, "dst_h_chr_pos", scale->out_h_chr_pos, 0);
-            av_opt_set_int(*s, "dst_v_chr_pos", out_v_chr_pos, 0);
-
-            if ((ret = sws_init_context(*s, NULL, NULL)) < 0)
+            if ((ret = init_sws(scale, swscs[i], inlink0, outlink, outfmt,
+                                inlink0->h >> !!i, outlink->h >> !!i, i)) < 0)
                 return ret;
             if (!scale->interlaced)
                 break;
         }
+        if ((ret = init_bands(ctx, inlink0, outlink, outfmt)) < 0)
+            return ret;
     }
 
     if (inlink0->sample_aspect_ratio.num){
@@ -400,6 +565,42 @@ static int scale_slice(AVFilterLink *link, AVFrame *out_buf, AVFrame *cur_pic, s
                          out,out_stride);
 }
 
+static int scale_band(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
+{
+    ScaleContext *scale = ctx->priv;
+    ThreadData *td = arg;
+    ScaleBand *b = &scale->bands[jobnr];
+    AVFrame *cur_pic = td->in, *out_buf = td->out;
+    const uint8_t *in[4];
+    int in_stride[4];
+    int i, ret;
+
+    for (i = 0; i < 4; i++) {
+        int vsub = ((i+1)&2) ? scale->vsub : 0;
+        in_stride[i] = cur_pic->linesize[i];
+        in[i] = cur_pic->data[i] + (b->in_y >> vsub) * cur_pic->linesize[i];
+    }
+
+    ret = sws_scale(b->sws, in, in_stride, 0, b->in_h,
+                    b->frame->data, b->frame->linesize);
+    if (ret < 0)
+        return ret;
+
+    for (i = 0; i < av_pix_fmt_count_planes(out_buf->format); i++) {
+        int vsub = (i == 1 || i == 2) ? scale->out_vsub : 0;
+        int y    = b->out_y >> vsub;
+        int h    = AV_CEIL_RSHIFT(b->out_y + b->out_h, vsub) - y;
+
+        av_image_copy_plane(out_buf->data[i] + y * out_buf->linesize[i],
+                            out_buf->linesize[i],
+                            b->frame->data[i] + (b->margin >> vsub) * b->frame->linesize[i],
+                            b->frame->linesize[i],
+                            av_image_get_linesize(out_buf->format, out_buf->width, i),
+                            h);
+    }
+    return 0;
+}
+
 static int filter_frame(AVFilterLink *link, AVFrame *in)
 {
     ScaleContext *scale = link->dst->priv;
@@ -407,7 +608,7 @@ static int filter_frame(AVFilterLink *link, AVFrame *in)
     AVFrame *out;
     const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(link->format);
     char buf[32];
-    int in_range;
+    int in_range, i;
 
     if (in->colorspace == AVCOL_SPC_YCGCO)
         av_log(link->dst, AV_LOG_WARNING, "Detected unsupported YCgCo colorspace.\n");
@@ -437,7 +638,7 @@ static int filter_frame(AVFilterLink *link, AVFrame *in)
             return ret;
     }
 
-    if (!scale->sws)
+    if (!scale->sws && !scale->nb_bands)
         return ff_filter_frame(outlink, in);
 
     scale->hsub = desc->log2_chroma_w;
@@ -466,7 +667,8 @@ static int filter_frame(AVFilterLink *link, AVFrame *in)
         int in_full, out_full, brightness, contrast, saturation;
         const int *inv_table, *table;
 
-        sws_getColorspaceDetails(scale->sws, (int **)&inv_table, &in_full,
+        sws_getColorspaceDetails(scale->nb_bands ? scale->bands[0].sws : scale->sws,
+                                 (int **)&inv_table, &in_full,
                                  (int **)&table, &out_full,
                                  &brightness, &contrast, &saturation);
 
@@ -484,9 +686,10 @@ static int filter_frame(AVFilterLink *link, AVFrame *in)
         if (scale->out_range != AVCOL_RANGE_UNSPECIFIED)
             out_full = (scale->out_range == AVCOL_RANGE_JPEG);
 
-        sws_setColorspaceDetails(scale->sws, inv_table, in_full,
-                                 table, out_full,
-                                 brightness, contrast, saturation);
+        if (scale->sws)
+            sws_setColorspaceDetails(scale->sws, inv_table, in_full,
+                                     table, out_full,
+                                     brightness, contrast, saturation);
         if (scale->isws[0])
             sws_setColorspaceDetails(scale->isws[0], inv_table, in_full,
                                      table, out_full,
@@ -495,6 +698,10 @@ static int filter_frame(AVFilterLink *link, AVFrame *in)
             sws_setColorspaceDetails(scale->isws[1], inv_table, in_full,
                                      table, out_full,
                                      brightness, contrast, saturation);
+        for (i = 0; i < scale->nb_bands; i++)
+            sws_setColorspaceDetails(scale->bands[i].sws, inv_table, in_full,
+                                     table, out_full,
+                                     brightness, contrast, saturation);
 
         out->color_range = out_full ? AVCOL_RANGE_JPEG : AVCOL_RANGE_MPEG;
     }
@@ -507,8 +714,12 @@ static int filter_frame(AVFilterLink *link, AVFrame *in)
     if(scale->interlaced>0 || (scale->interlaced<0 && in->interlaced_frame)){
         scale_slice(link, out, in, scale->isws[0], 0, (link->h+1)/2, 2, 0);
         scale_slice(link, out, in, scale->isws[1], 0,  link->h   /2, 2, 1);
+    }else if (scale->nb_bands) {
+        ThreadData td = { .in = in, .out = out };
+        link->dst->internal->execute(link->dst, scale_band, &td, NULL,
+                                     scale->nb_bands);
     }else if (scale->nb_slices) {
-        int i, slice_h, slice_start, slice_end = 0;
+        int slice_h, slice_start, slice_end = 0;
         const int nb_slices = FFMIN(scale->nb_slices, link->h);
         for (i = 0; i < nb_slices; i++) {
             slice_start = slice_end;
@@ -647,6 +858,7 @@ AVFilter ff_vf_scale = {
     .inputs          = avfilter_vf_scale_inputs,
     .outputs         = avfilter_vf_scale_outputs,
     .process_command = process_command,
+    .flags           = AVFILTER_FLAG_SLICE_THREADS,
 };
 
 static const AVClass scale2ref_class = {
@@ -699,4 +911,5 @@ AVFilter ff_vf_scale2ref = {
     .inputs          = avfilter_vf_scale2ref_inputs,
     .outputs         = avfilter_vf_scale2ref_outputs,
     .process_command = process_command,
+    .flags           = AVFILTER_FLAG_SLICE_THREADS,
 };
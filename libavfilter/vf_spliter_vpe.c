@@ -22,6 +22,7 @@
 #include <vpe/vpi_types.h>
 
 #include "filters.h"
+#include "libavutil/buffer.h"
 #include "libavutil/opt.h"
 #include "libavutil/hwcontext.h"
 #include "libavutil/hwcontext_vpe.h"
@@ -39,6 +40,10 @@ typedef struct VpeSpliterContext {
         int width;
         int height;
     } pic_info[PIC_INDEX_MAX_NUMBER];
+    /*pic_info buffers attached to the frames of the outputs after the first*/
+    AVBufferPool *pic_info_pool[4];
+    /*number of pic_info buffers allocated by the pools, exported*/
+    int64_t nb_pic_info_allocs;
 } VpeSpliterContext;
 
 static int vpe_spliter_out_config_props(AVFilterLink *outlink);
@@ -75,11 +80,23 @@ static av_cold int vpe_spliter_init(AVFilterContext *ctx)
 
 static av_cold void vpe_spliter_uninit(AVFilterContext *ctx)
 {
+    VpeSpliterContext *s = ctx->priv;
     int i;
 
     for (i = 0; i < ctx->nb_outputs; i++) {
         av_freep(&ctx->output_pads[i].name);
     }
+    for (i = 0; i < FF_ARRAY_ELEMS(s->pic_info_pool); i++) {
+        av_buffer_pool_uninit(&s->pic_info_pool[i]);
+    }
+}
+
+static AVBufferRef *vpe_spliter_pic_info_alloc(void *opaque, int size)
+{
+    VpeSpliterContext *s = opaque;
+
+    s->nb_pic_info_allocs++;
+    return av_buffer_alloc(size);
 }
 
 static int vpe_spliter_config_props(AVFilterLink *inlink)
@@ -97,6 +114,16 @@ static int vpe_spliter_config_props(AVFilterLink *inlink)
     vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
     frame_hwctx  = vpeframe_ctx->frame;
 
+    // the first output forwards the input frame with its own pic_info
+    for (i = 1; i < s->nb_outputs; i++) {
+        av_buffer_pool_uninit(&s->pic_info_pool[i]);
+        s->pic_info_pool[i] =
+            av_buffer_pool_init2(vpeframe_ctx->pic_info_size, s,
+                                 vpe_spliter_pic_info_alloc, NULL);
+        if (!s->pic_info_pool[i])
+            return AVERROR(ENOMEM);
+    }
+
     for (i = 0; i < PIC_INDEX_MAX_NUMBER; i++) {
         s->pic_info[i].enabled = frame_hwctx->pic_info[i].enabled;
         s->pic_info[i].flag    = frame_hwctx->pic_info[i].flag;
@@ -181,19 +208,49 @@ static int vpe_spliter_query_formats(AVFilterContext *ctx)
     return ff_set_common_formats(ctx, fmts_list);
 }
 
+/**
+ * Reference the input frame for an additional output, with pic_info
+ * buffers of its own taken from the output pool.
+ */
+static int vpe_spliter_ref_frame(VpeSpliterContext *s, int out_index,
+                                 AVFrame *dst, AVFrame *src)
+{
+    AVBufferRef *pic_info_buf[PIC_INDEX_MAX_NUMBER] = { NULL };
+    int j, ret;
+
+    // keep the input pic_info out of av_frame_ref(), they are replaced
+    for (j = 1; j < PIC_INDEX_MAX_NUMBER; j++) {
+        pic_info_buf[j] = src->buf[j];
+        src->buf[j]     = NULL;
+    }
+    ret = av_frame_ref(dst, src);
+    for (j = 1; j < PIC_INDEX_MAX_NUMBER; j++)
+        src->buf[j] = pic_info_buf[j];
+    if (ret < 0)
+        return ret;
+
+    for (j = 1; j < PIC_INDEX_MAX_NUMBER; j++) {
+        dst->buf[j] = av_buffer_pool_get(s->pic_info_pool[out_index]);
+        if (!dst->buf[j])
+            return AVERROR(ENOMEM);
+        if (src->buf[j])
+            memcpy(dst->buf[j]->data, src->buf[j]->data,
+                   FFMIN(src->buf[j]->size, dst->buf[j]->size));
+        else
+            memset(dst->buf[j]->data, 0, dst->buf[j]->size);
+    }
+
+    return 0;
+}
+
 static int vpe_spliter_filter_frame(AVFilterLink *inlink, AVFrame *frame)
 {
-    AVHWFramesContext *hwframe_ctx;
-    AVVpeFramesContext *vpeframe_ctx;
     AVFilterContext *ctx = inlink->dst;
     VpeSpliterContext *s   = ctx->priv;
     int i, j, pp_index, ret = AVERROR_UNKNOWN;
     VpiPicInfo *pic_info;
     VpiFrame *vpi_frame;
 
-    hwframe_ctx  = (AVHWFramesContext *)inlink->hw_frames_ctx->data;
-    vpeframe_ctx = (AVVpeFramesContext *)hwframe_ctx->hwctx;
-
     pp_index = 0;
     for (i = 0; i < ctx->nb_outputs; i++) {
         AVFrame *buf_out;
@@ -216,21 +273,11 @@ static int vpe_spliter_filter_frame(AVFilterLink *inlink, AVFrame *frame)
             buf_out = av_frame_alloc();
             if (!buf_out)
                 return AVERROR(ENOMEM);
-            ret = av_frame_ref(buf_out, frame);
-            if (ret < 0)
+            ret = vpe_spliter_ref_frame(s, i, buf_out, frame);
+            if (ret < 0) {
+                av_frame_free(&buf_out);
                 return ret;
-
-            for (j = 1; j < PIC_INDEX_MAX_NUMBER; j++) {
-                if (buf_out->buf[j])
-                    av_buffer_unref(&buf_out->buf[j]);
-            }
-            for (j = 1; j < PIC_INDEX_MAX_NUMBER; j++) {
-                buf_out->buf[j] =
-                    av_buffer_alloc(sizeof(vpeframe_ctx->pic_info_size));
-                if (!buf_out->buf[j])
-                    return AVERROR(ENOMEM);
             }
-
         } else {
             buf_out = frame;
         }
@@ -269,6 +316,15 @@ static const AVOption vpe_spliter_options[] = { { "outputs",
                                                   1,
                                                   4,
                                                   FLAGS },
+                                                { "pic_info_allocs",
+                                                  "number of pic_info buffers allocated",
+                                                  OFFSET(nb_pic_info_allocs),
+                                                  AV_OPT_TYPE_INT64,
+                                                  { .i64 = 0 },
+                                                  0,
+                                                  INT64_MAX,
+                                                  FLAGS | AV_OPT_FLAG_EXPORT |
+                                                  AV_OPT_FLAG_READONLY },
                                                 { NULL } };
 
 AVFILTER_DEFINE_CLASS(vpe_spliter);
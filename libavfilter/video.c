@@ -36,9 +36,20 @@
 #define BUFFER_ALIGN 32
 
 
+static AVFrame *get_video_buffer(AVFilterLink *link, int w, int h);
+
 AVFrame *ff_null_get_video_buffer(AVFilterLink *link, int w, int h)
 {
-    return ff_get_video_buffer(link->dst->outputs[0], w, h);
+    return get_video_buffer(link->dst->outputs[0], w, h);
+}
+
+static FFFramePool *video_pool_init(AVFilterLink *link, int w, int h)
+{
+    if (link->graph)
+        return ff_graph_frame_pool_video(link->graph, w, h,
+                                         link->format, BUFFER_ALIGN);
+    return ff_frame_pool_video_init(av_buffer_allocz, w, h,
+                                    link->format, BUFFER_ALIGN);
 }
 
 AVFrame *ff_default_get_video_buffer(AVFilterLink *link, int w, int h)
@@ -65,8 +76,7 @@ AVFrame *ff_default_get_video_buffer(AVFilterLink *link, int w, int h)
     }
 
     if (!link->frame_pool) {
-        link->frame_pool = ff_frame_pool_video_init(av_buffer_allocz, w, h,
-                                                    link->format, BUFFER_ALIGN);
+        link->frame_pool = video_pool_init(link, w, h);
         if (!link->frame_pool)
             return NULL;
     } else {
@@ -80,8 +90,7 @@ AVFrame *ff_default_get_video_buffer(AVFilterLink *link, int w, int h)
             pool_format != link->format || pool_align != BUFFER_ALIGN) {
 
             ff_frame_pool_uninit((FFFramePool **)&link->frame_pool);
-            link->frame_pool = ff_frame_pool_video_init(av_buffer_allocz, w, h,
-                                                        link->format, BUFFER_ALIGN);
+            link->frame_pool = video_pool_init(link, w, h);
             if (!link->frame_pool)
                 return NULL;
         }
@@ -96,7 +105,7 @@ AVFrame *ff_default_get_video_buffer(AVFilterLink *link, int w, int h)
     return frame;
 }
 
-AVFrame *ff_get_video_buffer(AVFilterLink *link, int w, int h)
+static AVFrame *get_video_buffer(AVFilterLink *link, int w, int h)
 {
     AVFrame *ret = NULL;
 
@@ -110,3 +119,20 @@ AVFrame *ff_get_video_buffer(AVFilterLink *link, int w, int h)
 
     return ret;
 }
+
+AVFrame *ff_get_video_buffer_for(AVFilterContext *filter, AVFilterLink *link,
+                                 int w, int h)
+{
+    AVFrame *ret = get_video_buffer(link, w, h);
+
+    /* frames passed through by null filters are accounted once */
+    if (ret && link->graph && link->graph->profile)
+        ff_filter_profile_alloc(filter, ret);
+
+    return ret;
+}
+
+AVFrame *ff_get_video_buffer(AVFilterLink *link, int w, int h)
+{
+    return ff_get_video_buffer_for(link->src, link, w, h);
+}
@@ -38,4 +38,11 @@ AVFrame *ff_null_get_video_buffer(AVFilterLink *link, int w, int h);
  */
 AVFrame *ff_get_video_buffer(AVFilterLink *link, int w, int h);
 
+/**
+ * Same as ff_get_video_buffer(), but the buffer is accounted in the profile
+ * of filter instead of the source of link.
+ */
+AVFrame *ff_get_video_buffer_for(AVFilterContext *filter, AVFilterLink *link,
+                                 int w, int h);
+
 #endif /* AVFILTER_VIDEO_H */
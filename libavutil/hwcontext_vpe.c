@@ -25,17 +25,50 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <pthread.h>
 #include <sys/ioctl.h>
 
+#include "avstring.h"
+#include "buffer_internal.h"
+#include "imgutils.h"
 #include "pixdesc.h"
 #include "hwcontext_internal.h"
 #include "hwcontext_vpe.h"
+#include "hwcontext_vpe_internal.h"
 #include "libavutil/opt.h"
 
-typedef struct VpeDevicePriv {
+#define VPE_MAX_TRANSFER_DEPTH 16
+
+typedef struct VpeDevice {
     VpiSysInfo *sys_info;
+    VpiApi *func;
+    AVVpeDeviceLoad load;
+} VpeDevice;
+
+typedef struct VpeDevicePriv {
+    VpeDevice devices[AV_VPE_MAX_DEVICES];
+    // protects the load of the devices
+    pthread_mutex_t lock;
+    int transfer_depth;
+    int initial_pool_size;
+    int max_pool_size;
 } VpeDevicePriv;
 
+/**
+ * One asynchronous upload, the staging frame holds a copy of the source
+ * until the worker thread has sent it to the device.
+ */
+typedef struct VpeTransfer {
+    AVFrame *staging;
+    VpiFrame in_frame;
+    // destination of the upload, NULL when the slot never completed one
+    VpiFrame *out_frame;
+    // queued or running on the worker thread
+    int pending;
+    // VPI status of the last upload
+    int ret;
+} VpeTransfer;
+
 typedef struct VpeFramesContext {
     VpiCtx hwdownload_ctx;
     VpiApi *hwdownload_vpi;
@@ -43,6 +76,35 @@ typedef struct VpeFramesContext {
     VpiCtx hwupload_ctx;
     VpiApi *hwupload_vpi;
     int hwupload_init;
+
+    // ring of the asynchronous uploads
+    VpeTransfer *transfers;
+    int nb_transfers;
+    // next slot filled by the caller and next slot run by the worker
+    int transfer_in;
+    int transfer_out;
+    pthread_t transfer_thread;
+    pthread_mutex_t transfer_lock;
+    pthread_cond_t transfer_cond;
+    int transfer_thread_started;
+    int transfer_exit;
+
+    // index of AVVpeFramesContext.device in AVVpeDeviceContext.devices
+    int device_index;
+    // counted in the nb_frames_ctx of the device
+    int placed;
+
+    // host buffers of the read-only mappings, swapped under pool_lock
+    AVBufferPool *map_pool;
+    int map_pool_size;
+
+    // pic_info buffers of the output references
+    AVBufferPool *pic_info_pool;
+
+    // buffer pool statistics but nb_in_use, protected by pool_lock
+    AVVpeFramesStats stats;
+    pthread_mutex_t pool_lock;
+    int pool_lock_init;
 } VpeFramesContext;
 
 static const enum AVPixelFormat supported_sw_formats[] = {
@@ -121,19 +183,89 @@ static int vpe_transfer_get_formats(AVHWFramesContext *ctx,
     return 0;
 }
 
+static void vpe_device_load_add(AVHWFramesContext *ctx, int sessions,
+                                int frames)
+{
+    VpeDevicePriv *device_priv = ctx->device_ctx->user_opaque;
+    VpeFramesContext *priv     = ctx->internal->priv;
+    AVVpeDeviceLoad *load      = &device_priv->devices[priv->device_index].load;
+
+    pthread_mutex_lock(&device_priv->lock);
+    load->nb_sessions += sessions;
+    load->nb_frames   += frames;
+    pthread_mutex_unlock(&device_priv->lock);
+}
+
+void avpriv_vpe_device_session_add(AVHWFramesContext *ctx, int delta)
+{
+    vpe_device_load_add(ctx, delta, 0);
+}
+
+int av_vpe_device_get_load(AVHWDeviceContext *ctx, int index,
+                           AVVpeDeviceLoad *load)
+{
+    AVVpeDeviceContext *hwctx = ctx->hwctx;
+    VpeDevicePriv *priv       = ctx->user_opaque;
+
+    if (ctx->type != AV_HWDEVICE_TYPE_VPE || index < 0 ||
+        index >= hwctx->nb_devices)
+        return AVERROR(EINVAL);
+
+    pthread_mutex_lock(&priv->lock);
+    *load = priv->devices[index].load;
+    pthread_mutex_unlock(&priv->lock);
+
+    return 0;
+}
+
+/**
+ * Pick the device of a new frames context: the fewest sessions, then the
+ * fewest frame buffers, then the fewest frames contexts.
+ */
+static int vpe_device_select(AVHWDeviceContext *device_ctx)
+{
+    AVVpeDeviceContext *hwctx = device_ctx->hwctx;
+    VpeDevicePriv *priv       = device_ctx->user_opaque;
+    AVVpeDeviceLoad *load, *best = NULL;
+    int i, index = 0;
+
+    pthread_mutex_lock(&priv->lock);
+    for (i = 0; i < hwctx->nb_devices; i++) {
+        load = &priv->devices[i].load;
+        if (best) {
+            if (load->nb_sessions != best->nb_sessions) {
+                if (load->nb_sessions > best->nb_sessions)
+                    continue;
+            } else if (load->nb_frames != best->nb_frames) {
+                if (load->nb_frames > best->nb_frames)
+                    continue;
+            } else if (load->nb_frames_ctx >= best->nb_frames_ctx) {
+                continue;
+            }
+        }
+        best  = load;
+        index = i;
+    }
+    best->nb_frames_ctx++;
+    pthread_mutex_unlock(&priv->lock);
+
+    return index;
+}
+
 static int vpe_init_internal_session(AVHWFramesContext *ctx, int download)
 {
-    AVVpeDeviceContext *device_hwctx = ctx->device_ctx->hwctx;
-    VpeFramesContext *priv           = ctx->internal->priv;
+    AVVpeFramesContext *frame_hwctx = ctx->hwctx;
+    VpeFramesContext *priv          = ctx->internal->priv;
     VpiPixsFmt format;
     int ret;
 
     if (!priv->hwdownload_ctx && !priv->hwdownload_init && download) {
         //Create HWDOWNLOAD_VPE
         ret = vpi_create(&priv->hwdownload_ctx, &priv->hwdownload_vpi,
-                         device_hwctx->device, HWDOWNLOAD_VPE);
+                         frame_hwctx->device, HWDOWNLOAD_VPE);
         if (ret != 0)
             return AVERROR_EXTERNAL;
+        vpe_device_load_add(ctx, 1, 0);
 
         ret = priv->hwdownload_vpi->init(priv->hwdownload_ctx, NULL);
         if (ret != 0)
@@ -145,9 +277,10 @@ static int vpe_init_internal_session(AVHWFramesContext *ctx, int download)
     if (!priv->hwupload_ctx && !priv->hwupload_init && !download) {
         //Create HWUPLOAD_VPE
         ret = vpi_create(&priv->hwupload_ctx, &priv->hwupload_vpi,
-                         device_hwctx->device, HWUPLOAD_VPE);
+                         frame_hwctx->device, HWUPLOAD_VPE);
         if (ret != 0)
             return AVERROR_EXTERNAL;
+        vpe_device_load_add(ctx, 1, 0);
 
         if(ctx->sw_format == AV_PIX_FMT_NV12)
             format = VPI_FMT_NV12;
@@ -183,6 +316,10 @@ static int vpe_transfer_data_from(AVHWFramesContext *ctx, AVFrame *dst,
 
     vpe_init_internal_session(ctx, 1);
 
+    ret = avpriv_vpe_frame_wait(src);
+    if (ret < 0)
+        return ret;
+
     in_frame = (VpiFrame *)src->data[0];
     for (i = 1; i < PIC_INDEX_MAX_NUMBER; i++) {
         pic_info = (VpiPicInfo *)src->buf[i]->data;
@@ -220,6 +357,265 @@ static int vpe_transfer_data_from(AVHWFramesContext *ctx, AVFrame *dst,
     return 0;
 }
 
+/**
+ * Read-only "mapping" of a frame on the host.
+ *
+ * The VPI has no host view of the device buffers, so this is a download
+ * into a host buffer taken from a pool, which goes back to the pool when
+ * dst is unreferenced. dst does not reference src once the copy is done,
+ * so the device buffer can be reused while the host copy is read.
+ */
+static int vpe_map_from(AVHWFramesContext *ctx, AVFrame *dst,
+                        const AVFrame *src, int flags)
+{
+    VpeFramesContext *priv = ctx->internal->priv;
+    AVFrame *map;
+    int size, ret = 0;
+
+    if (flags & (AV_HWFRAME_MAP_WRITE | AV_HWFRAME_MAP_OVERWRITE))
+        return AVERROR(ENOSYS);
+    if (dst->format != AV_PIX_FMT_NONE && dst->format != ctx->sw_format)
+        return AVERROR(ENOSYS);
+
+    size = av_image_get_buffer_size(ctx->sw_format, src->width, src->height,
+                                    32);
+    if (size < 0)
+        return size;
+
+    map = av_frame_alloc();
+    if (!map)
+        return AVERROR(ENOMEM);
+
+    pthread_mutex_lock(&priv->pool_lock);
+    if (size != priv->map_pool_size) {
+        // mappings still out keep the old pool alive until they are freed
+        av_buffer_pool_uninit(&priv->map_pool);
+        priv->map_pool = av_buffer_pool_init(size, NULL);
+        priv->map_pool_size = priv->map_pool ? size : 0;
+    }
+    if (priv->map_pool)
+        map->buf[0] = av_buffer_pool_get(priv->map_pool);
+    pthread_mutex_unlock(&priv->pool_lock);
+    if (!map->buf[0]) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+
+    map->format = ctx->sw_format;
+    map->width  = src->width;
+    map->height = src->height;
+    ret = av_image_fill_arrays(map->data, map->linesize, map->buf[0]->data,
+                               map->format, map->width, map->height, 32);
+    if (ret < 0)
+        goto end;
+
+    ret = vpe_transfer_data_from(ctx, map, src);
+    if (ret < 0)
+        goto end;
+
+    av_frame_unref(dst);
+    av_frame_move_ref(dst, map);
+
+end:
+    av_frame_free(&map);
+    return ret;
+}
+
+static void *vpe_transfer_worker(void *arg)
+{
+    AVHWFramesContext *ctx = arg;
+    VpeFramesContext *priv = ctx->internal->priv;
+    VpeTransfer *transfer;
+    int ret;
+
+    pthread_mutex_lock(&priv->transfer_lock);
+    while (1) {
+        transfer = &priv->transfers[priv->transfer_out];
+        if (!transfer->pending) {
+            // uploads run in ring order, nothing is queued behind this one
+            if (priv->transfer_exit)
+                break;
+            pthread_cond_wait(&priv->transfer_cond, &priv->transfer_lock);
+            continue;
+        }
+        pthread_mutex_unlock(&priv->transfer_lock);
+
+        ret = priv->hwupload_vpi->process(priv->hwupload_ctx,
+                                          &transfer->in_frame,
+                                          transfer->out_frame);
+        if (ret)
+            av_log(ctx, AV_LOG_ERROR,
+                   "hwupload_vpe filter frame failed,error=%s(%d)\n",
+                   vpi_error_str(ret), ret);
+
+        pthread_mutex_lock(&priv->transfer_lock);
+        transfer->ret      = ret;
+        transfer->pending  = 0;
+        priv->transfer_out = (priv->transfer_out + 1) % priv->nb_transfers;
+        pthread_cond_broadcast(&priv->transfer_cond);
+    }
+    pthread_mutex_unlock(&priv->transfer_lock);
+
+    return NULL;
+}
+
+static int vpe_transfer_start(AVHWFramesContext *ctx, int depth)
+{
+    VpeFramesContext *priv = ctx->internal->priv;
+    int i, ret;
+
+    priv->transfers = av_mallocz_array(depth, sizeof(*priv->transfers));
+    if (!priv->transfers)
+        return AVERROR(ENOMEM);
+    priv->nb_transfers = depth;
+
+    for (i = 0; i < depth; i++) {
+        priv->transfers[i].staging = av_frame_alloc();
+        if (!priv->transfers[i].staging)
+            return AVERROR(ENOMEM);
+    }
+
+    pthread_mutex_init(&priv->transfer_lock, NULL);
+    pthread_cond_init(&priv->transfer_cond, NULL);
+    ret = pthread_create(&priv->transfer_thread, NULL, vpe_transfer_worker, ctx);
+    if (ret) {
+        pthread_mutex_destroy(&priv->transfer_lock);
+        pthread_cond_destroy(&priv->transfer_cond);
+        return AVERROR(ret);
+    }
+    priv->transfer_thread_started = 1;
+
+    return 0;
+}
+
+static void vpe_transfer_stop(AVHWFramesContext *ctx)
+{
+    VpeFramesContext *priv = ctx->internal->priv;
+    int i;
+
+    if (priv->transfer_thread_started) {
+        pthread_mutex_lock(&priv->transfer_lock);
+        priv->transfer_exit = 1;
+        pthread_cond_broadcast(&priv->transfer_cond);
+        pthread_mutex_unlock(&priv->transfer_lock);
+        pthread_join(priv->transfer_thread, NULL);
+
+        pthread_mutex_destroy(&priv->transfer_lock);
+        pthread_cond_destroy(&priv->transfer_cond);
+        priv->transfer_thread_started = 0;
+    }
+
+    for (i = 0; i < priv->nb_transfers; i++)
+        av_frame_free(&priv->transfers[i].staging);
+    av_freep(&priv->transfers);
+    priv->nb_transfers = 0;
+}
+
+/**
+ * Wait for the uploads into vpi_frame. With forget set the frame goes back
+ * to the pool, so the status of its last upload is dropped.
+ */
+static int vpe_transfer_wait(AVHWFramesContext *ctx, const VpiFrame *vpi_frame,
+                             int forget)
+{
+    VpeFramesContext *priv = ctx->internal->priv;
+    VpeTransfer *transfer;
+    int i, ret = 0;
+
+    if (!priv->transfer_thread_started)
+        return 0;
+
+    pthread_mutex_lock(&priv->transfer_lock);
+    for (i = 0; i < priv->nb_transfers; i++) {
+        transfer = &priv->transfers[i];
+        if (transfer->out_frame != vpi_frame)
+            continue;
+        while (transfer->pending)
+            pthread_cond_wait(&priv->transfer_cond, &priv->transfer_lock);
+        if (transfer->ret)
+            ret = AVERROR_EXTERNAL;
+        if (forget)
+            transfer->out_frame = NULL;
+    }
+    pthread_mutex_unlock(&priv->transfer_lock);
+
+    return ret;
+}
+
+int avpriv_vpe_frame_wait(const AVFrame *frame)
+{
+    AVHWFramesContext *ctx;
+
+    if (!frame || !frame->hw_frames_ctx)
+        return 0;
+    ctx = (AVHWFramesContext *)frame->hw_frames_ctx->data;
+    if (ctx->device_ctx->type != AV_HWDEVICE_TYPE_VPE)
+        return 0;
+
+    return vpe_transfer_wait(ctx, (VpiFrame *)frame->data[0], 0);
+}
+
+static void vpe_fill_upload_frame(VpiFrame *in_frame, const AVFrame *src)
+{
+    in_frame->linesize[0] = src->linesize[0];
+    in_frame->linesize[1] = src->linesize[1];
+    in_frame->linesize[2] = src->linesize[2];
+    in_frame->src_width   = src->width;
+    in_frame->src_height  = src->height;
+    in_frame->data[0]     = src->data[0];
+    in_frame->data[1]     = src->data[1];
+    in_frame->data[2]     = src->data[2];
+    in_frame->key_frame   = src->key_frame;
+    in_frame->pts         = src->pts;
+    in_frame->pkt_dts     = src->pkt_dts;
+}
+
+/**
+ * Copy src to the next staging buffer and queue its upload, only blocks
+ * when all the staging buffers are in flight.
+ */
+static int vpe_transfer_data_to_async(AVHWFramesContext *ctx, AVFrame *dst,
+                                      const AVFrame *src)
+{
+    VpeFramesContext *priv = ctx->internal->priv;
+    VpeTransfer *transfer;
+    AVFrame *staging;
+    int ret;
+
+    pthread_mutex_lock(&priv->transfer_lock);
+    transfer = &priv->transfers[priv->transfer_in];
+    while (transfer->pending)
+        pthread_cond_wait(&priv->transfer_cond, &priv->transfer_lock);
+    pthread_mutex_unlock(&priv->transfer_lock);
+
+    staging = transfer->staging;
+    if (staging->format != src->format || staging->width != src->width ||
+        staging->height != src->height) {
+        av_frame_unref(staging);
+        staging->format = src->format;
+        staging->width  = src->width;
+        staging->height = src->height;
+        ret = av_frame_get_buffer(staging, 0);
+        if (ret < 0)
+            return ret;
+    }
+
+    ret = av_frame_copy(staging, src);
+    if (ret < 0)
+        return ret;
+    vpe_fill_upload_frame(&transfer->in_frame, staging);
+
+    pthread_mutex_lock(&priv->transfer_lock);
+    transfer->out_frame = (VpiFrame *)dst->data[0];
+    transfer->ret       = 0;
+    transfer->pending   = 1;
+    priv->transfer_in   = (priv->transfer_in + 1) % priv->nb_transfers;
+    pthread_cond_broadcast(&priv->transfer_cond);
+    pthread_mutex_unlock(&priv->transfer_lock);
+
+    return 0;
+}
+
 static int vpe_transfer_data_to(AVHWFramesContext *ctx, AVFrame *dst,
                                 const AVFrame *src)
 {
@@ -229,25 +625,21 @@ static int vpe_transfer_data_to(AVHWFramesContext *ctx, AVFrame *dst,
 
     vpe_init_internal_session(ctx, 0);
 
-    in_frame.linesize[0] = src->linesize[0];
-    in_frame.linesize[1] = src->linesize[1];
-    in_frame.linesize[2] = src->linesize[2];
-    in_frame.src_width   = src->width;
-    in_frame.src_height  = src->height;
-    in_frame.data[0]     = src->data[0];
-    in_frame.data[1]     = src->data[1];
-    in_frame.data[2]     = src->data[2];
-    in_frame.key_frame   = src->key_frame;
-    in_frame.pts         = src->pts;
-    in_frame.pkt_dts     = src->pkt_dts;
-
-    ret = priv->hwupload_vpi->process(priv->hwupload_ctx,
-                                      &in_frame, dst->data[0]);
-    if (ret) {
-        av_log(ctx, AV_LOG_ERROR,
-               "hwupload_vpe filter frame failed,error=%s(%d)\n",
-               vpi_error_str(ret), ret);
-        return AVERROR_EXTERNAL;
+    if (priv->nb_transfers) {
+        ret = vpe_transfer_data_to_async(ctx, dst, src);
+        if (ret < 0)
+            return ret;
+    } else {
+        vpe_fill_upload_frame(&in_frame, src);
+
+        ret = priv->hwupload_vpi->process(priv->hwupload_ctx,
+                                          &in_frame, dst->data[0]);
+        if (ret) {
+            av_log(ctx, AV_LOG_ERROR,
+                   "hwupload_vpe filter frame failed,error=%s(%d)\n",
+                   vpi_error_str(ret), ret);
+            return AVERROR_EXTERNAL;
+        }
     }
 
     dst->format      = AV_PIX_FMT_VPE;
@@ -257,34 +649,107 @@ static int vpe_transfer_data_to(AVHWFramesContext *ctx, AVFrame *dst,
     return 0;
 }
 
-static void vpe_buffer_free(void *opaque, uint8_t *data)
+/**
+ * Send a HWCONTEXT command to the device the frames context is placed on.
+ */
+static int vpe_frames_control(AVHWFramesContext *ctx, VpiCtrlCmdParam *cmd_param,
+                              void *out)
 {
-    AVHWFramesContext *ctx           = opaque;
     AVVpeDeviceContext *device_hwctx = ctx->device_ctx->hwctx;
+    VpeDevicePriv *device_priv       = ctx->device_ctx->user_opaque;
+    VpeFramesContext *priv           = ctx->internal->priv;
+
+    return device_priv->devices[priv->device_index].func->control(
+        &device_hwctx->devices[priv->device_index], cmd_param, out);
+}
+
+static void vpe_buffer_free(void *opaque, uint8_t *data)
+{
+    AVHWFramesContext *ctx = opaque;
+    VpeFramesContext *priv = ctx->internal->priv;
     VpiCtrlCmdParam cmd_param;
 
+    vpe_transfer_wait(ctx, (VpiFrame *)data, 1);
+
     cmd_param.cmd  = VPI_CMD_FREE_FRAME_BUFFER;
     cmd_param.data = (void *)data;
-    device_hwctx->func->control(&device_hwctx->device, &cmd_param, NULL);
+    vpe_frames_control(ctx, &cmd_param, NULL);
+    vpe_device_load_add(ctx, 0, -1);
+
+    pthread_mutex_lock(&priv->pool_lock);
+    priv->stats.nb_allocated--;
+    pthread_mutex_unlock(&priv->pool_lock);
 }
 
 static AVBufferRef *vpe_pool_alloc(void *opaque, int size)
 {
-    AVHWFramesContext *ctx           = opaque;
-    AVVpeDeviceContext *device_hwctx = ctx->device_ctx->hwctx;
-    VpiFrame *v_frame                = NULL;
+    AVHWFramesContext *ctx          = opaque;
+    AVVpeFramesContext *frame_hwctx = ctx->hwctx;
+    VpeFramesContext *priv          = ctx->internal->priv;
+    VpiFrame *v_frame               = NULL;
     VpiCtrlCmdParam cmd_param;
     AVBufferRef *ret;
 
+    // reserve the buffer first so concurrent gets cannot exceed the limit
+    pthread_mutex_lock(&priv->pool_lock);
+    if (frame_hwctx->max_pool_size &&
+        priv->stats.nb_allocated >= frame_hwctx->max_pool_size) {
+        pthread_mutex_unlock(&priv->pool_lock);
+        return NULL;
+    }
+    priv->stats.nb_allocated++;
+    priv->stats.nb_misses++;
+    pthread_mutex_unlock(&priv->pool_lock);
+
     cmd_param.cmd = VPI_CMD_GET_FRAME_BUFFER;
-    device_hwctx->func->control(&device_hwctx->device, &cmd_param, (void *)&v_frame);
+    vpe_frames_control(ctx, &cmd_param, (void *)&v_frame);
     if (!v_frame)
-        return NULL;
+        goto fail;
 
     ret = av_buffer_create((uint8_t*)v_frame, size,
                             vpe_buffer_free, ctx, 0);
+    if (!ret) {
+        cmd_param.cmd  = VPI_CMD_FREE_FRAME_BUFFER;
+        cmd_param.data = (void *)v_frame;
+        vpe_frames_control(ctx, &cmd_param, NULL);
+        goto fail;
+    }
+    vpe_device_load_add(ctx, 0, 1);
 
     return ret;
+
+fail:
+    pthread_mutex_lock(&priv->pool_lock);
+    priv->stats.nb_allocated--;
+    priv->stats.nb_misses--;
+    pthread_mutex_unlock(&priv->pool_lock);
+    return NULL;
+}
+
+/**
+ * Number of buffers lent by a pool. Each of them holds a reference to the
+ * pool, next to the one of its owner.
+ */
+static int vpe_pool_in_use(AVBufferPool *pool)
+{
+    return atomic_load_explicit(&pool->refcount, memory_order_relaxed) - 1;
+}
+
+int av_vpe_frames_get_stats(AVHWFramesContext *ctx, AVVpeFramesStats *stats)
+{
+    VpeFramesContext *priv;
+
+    if (ctx->device_ctx->type != AV_HWDEVICE_TYPE_VPE)
+        return AVERROR(EINVAL);
+    priv = ctx->internal->priv;
+
+    pthread_mutex_lock(&priv->pool_lock);
+    *stats         = priv->stats;
+    stats->nb_hits = stats->nb_gets - stats->nb_misses - stats->nb_failures;
+    pthread_mutex_unlock(&priv->pool_lock);
+    stats->nb_in_use = ctx->pool ? vpe_pool_in_use(ctx->pool) : 0;
+
+    return 0;
 }
 
 static int vpe_frames_init(AVHWFramesContext *hwfc)
@@ -292,10 +757,11 @@ static int vpe_frames_init(AVHWFramesContext *hwfc)
     AVVpeDeviceContext *device_hwctx = hwfc->device_ctx->hwctx;
     AVVpeFramesContext *frame_hwctx  = hwfc->hwctx;
     VpeFramesContext *priv           = hwfc->internal->priv;
+    VpeDevicePriv *device_priv       = hwfc->device_ctx->user_opaque;
     VpiCtrlCmdParam cmd_param;
     int size         = 0;
     int picinfo_size = 0;
-    int i;
+    int i, ret;
 
     for (i = 0; i < FF_ARRAY_ELEMS(supported_sw_formats); i++) {
         if (hwfc->sw_format == supported_sw_formats[i])
@@ -307,9 +773,32 @@ static int vpe_frames_init(AVHWFramesContext *hwfc)
         return AVERROR(ENOSYS);
     }
 
+    pthread_mutex_init(&priv->pool_lock, NULL);
+    priv->pool_lock_init = 1;
+
+    // the generic code preallocates initial_pool_size frames after this
+    if (!hwfc->initial_pool_size)
+        hwfc->initial_pool_size = device_priv->initial_pool_size;
+    if (!frame_hwctx->max_pool_size)
+        frame_hwctx->max_pool_size = device_priv->max_pool_size;
+    if (frame_hwctx->max_pool_size < 0 || (frame_hwctx->max_pool_size &&
+        hwfc->initial_pool_size > frame_hwctx->max_pool_size)) {
+        av_log(hwfc, AV_LOG_ERROR, "Invalid max_pool_size %d for an "
+               "initial_pool_size of %d\n", frame_hwctx->max_pool_size,
+               hwfc->initial_pool_size);
+        return AVERROR(EINVAL);
+    }
+
+    priv->device_index  = vpe_device_select(hwfc->device_ctx);
+    priv->placed        = 1;
+    frame_hwctx->device = device_hwctx->devices[priv->device_index];
+    if (device_hwctx->nb_devices > 1)
+        av_log(hwfc, AV_LOG_VERBOSE, "Frames placed on device %d of %d\n",
+               priv->device_index, device_hwctx->nb_devices);
+
     if (!hwfc->pool) {
         cmd_param.cmd = VPI_CMD_GET_VPEFRAME_SIZE;
-        device_hwctx->func->control(&device_hwctx->device, &cmd_param, (void *)&size);
+        vpe_frames_control(hwfc, &cmd_param, (void *)&size);
         if (!size)
             return AVERROR_EXTERNAL;
         frame_hwctx->frame = (VpiFrame *)av_mallocz(size);
@@ -322,13 +811,16 @@ static int vpe_frames_init(AVHWFramesContext *hwfc)
 
         cmd_param.cmd  = VPI_CMD_SET_VPEFRAME;
         cmd_param.data = (void *)frame_hwctx->frame;
-        device_hwctx->func->control(&device_hwctx->device, &cmd_param, NULL);
+        vpe_frames_control(hwfc, &cmd_param, NULL);
 
         cmd_param.cmd = VPI_CMD_GET_PICINFO_SIZE;
-        device_hwctx->func->control(&device_hwctx->device, &cmd_param, (void *)&picinfo_size);
+        vpe_frames_control(hwfc, &cmd_param, (void *)&picinfo_size);
         if (!picinfo_size)
             return AVERROR_EXTERNAL;
         frame_hwctx->pic_info_size = picinfo_size;
+        priv->pic_info_pool = av_buffer_pool_init(picinfo_size, NULL);
+        if (!priv->pic_info_pool)
+            return AVERROR(ENOMEM);
 
         hwfc->internal->pool_internal =
             av_buffer_pool_init2(size, hwfc, vpe_pool_alloc, NULL);
@@ -342,30 +834,92 @@ static int vpe_frames_init(AVHWFramesContext *hwfc)
     priv->hwupload_ctx  = NULL;
     priv->hwupload_init = 0;
 
+    if (!frame_hwctx->transfer_depth)
+        frame_hwctx->transfer_depth = device_priv->transfer_depth;
+    if (frame_hwctx->transfer_depth < 0 ||
+        frame_hwctx->transfer_depth > VPE_MAX_TRANSFER_DEPTH) {
+        av_log(hwfc, AV_LOG_ERROR, "transfer_depth %d out of range [0, %d]\n",
+               frame_hwctx->transfer_depth, VPE_MAX_TRANSFER_DEPTH);
+        return AVERROR(EINVAL);
+    }
+    if (frame_hwctx->transfer_depth) {
+        ret = vpe_transfer_start(hwfc, frame_hwctx->transfer_depth);
+        if (ret < 0)
+            return ret;
+    }
+
     return 0;
 }
 
 static void vpe_frames_uninit(AVHWFramesContext *ctx)
 {
-    AVVpeDeviceContext *device_hwctx = ctx->device_ctx->hwctx;
-    AVVpeFramesContext *frame_hwctx  = ctx->hwctx;
-    VpeFramesContext *priv           = ctx->internal->priv;
+    VpeDevicePriv *device_priv      = ctx->device_ctx->user_opaque;
+    AVVpeFramesContext *frame_hwctx = ctx->hwctx;
+    VpeFramesContext *priv          = ctx->internal->priv;
+
+    // the worker uses the upload session, stop it first
+    vpe_transfer_stop(ctx);
 
     if (priv->hwdownload_ctx) {
         priv->hwdownload_vpi->close(priv->hwdownload_ctx);
-        vpi_destroy(priv->hwdownload_ctx, device_hwctx->device);
+        vpi_destroy(priv->hwdownload_ctx, frame_hwctx->device);
+        vpe_device_load_add(ctx, -1, 0);
         priv->hwdownload_ctx  = NULL;
         priv->hwdownload_init = 0;
     }
     if (priv->hwupload_ctx) {
         priv->hwupload_vpi->close(priv->hwupload_ctx);
-        vpi_destroy(priv->hwupload_ctx, device_hwctx->device);
+        vpi_destroy(priv->hwupload_ctx, frame_hwctx->device);
+        vpe_device_load_add(ctx, -1, 0);
         priv->hwupload_ctx  = NULL;
         priv->hwupload_init = 0;
     }
     if (frame_hwctx->frame) {
         av_freep(&frame_hwctx->frame);
     }
+    av_buffer_pool_uninit(&priv->map_pool);
+    av_buffer_pool_uninit(&priv->pic_info_pool);
+    if (priv->pool_lock_init) {
+        if (priv->stats.nb_gets)
+            av_log(ctx, AV_LOG_VERBOSE, "Frame pool: %"PRId64" gets, "
+                   "%"PRId64" hits, %"PRId64" misses, %"PRId64" failures, "
+                   "max %d in use\n", priv->stats.nb_gets,
+                   priv->stats.nb_gets - priv->stats.nb_misses -
+                   priv->stats.nb_failures, priv->stats.nb_misses,
+                   priv->stats.nb_failures, priv->stats.max_in_use);
+        pthread_mutex_destroy(&priv->pool_lock);
+        priv->pool_lock_init = 0;
+    }
+    if (priv->placed) {
+        pthread_mutex_lock(&device_priv->lock);
+        device_priv->devices[priv->device_index].load.nb_frames_ctx--;
+        pthread_mutex_unlock(&device_priv->lock);
+        priv->placed = 0;
+    }
+}
+
+static AVBufferRef *vpe_buffer_get(AVHWFramesContext *hwfc)
+{
+    VpeFramesContext *priv = hwfc->internal->priv;
+    AVVpeFramesContext *vpeframe_ctx = hwfc->hwctx;
+    AVBufferRef *buf;
+
+    buf = av_buffer_pool_get(hwfc->pool);
+
+    pthread_mutex_lock(&priv->pool_lock);
+    priv->stats.nb_gets++;
+    if (buf)
+        priv->stats.max_in_use = FFMAX(priv->stats.max_in_use,
+                                       vpe_pool_in_use(hwfc->pool));
+    else
+        priv->stats.nb_failures++;
+    pthread_mutex_unlock(&priv->pool_lock);
+
+    if (!buf && vpeframe_ctx->max_pool_size)
+        av_log(hwfc, AV_LOG_ERROR, "No free frame buffer, %d of "
+               "max_pool_size %d allocated\n", priv->stats.nb_allocated,
+               vpeframe_ctx->max_pool_size);
+    return buf;
 }
 
 static int vpe_get_buffer(AVHWFramesContext *hwfc, AVFrame *frame)
@@ -374,10 +928,13 @@ static int vpe_get_buffer(AVHWFramesContext *hwfc, AVFrame *frame)
     VpiPicInfo *pic_info;
     int i;
 
-    frame->buf[0] = av_buffer_pool_get(hwfc->pool);
+    frame->buf[0] = vpe_buffer_get(hwfc);
     if (!frame->buf[0])
         return AVERROR(ENOMEM);
 
+    // an upload into the previous user of the buffer may still be running
+    vpe_transfer_wait(hwfc, (VpiFrame *)frame->buf[0]->data, 1);
+
     frame->data[0] = frame->buf[0]->data;
     memset(frame->data[0], 0, vpeframe_ctx->frame_size);
 
@@ -397,18 +954,104 @@ static int vpe_get_buffer(AVHWFramesContext *hwfc, AVFrame *frame)
     return 0;
 }
 
+int av_vpe_frame_ref_output(AVFrame *dst, const AVFrame *src, int index)
+{
+    AVHWFramesContext *ctx;
+    VpeFramesContext *priv;
+    VpiFrame *vpi_frame;
+    AVBufferRef *buf;
+    VpiPicInfo *pic_info;
+    int i, ret;
+
+    if (src->format != AV_PIX_FMT_VPE || !src->hw_frames_ctx || !src->data[0])
+        return AVERROR(EINVAL);
+    ctx       = (AVHWFramesContext *)src->hw_frames_ctx->data;
+    priv      = ctx->internal->priv;
+    vpi_frame = (VpiFrame *)src->data[0];
+    if (ctx->device_ctx->type != AV_HWDEVICE_TYPE_VPE || !priv->pic_info_pool)
+        return AVERROR(EINVAL);
+    if (index < 1 || index >= PIC_INDEX_MAX_NUMBER ||
+        !vpi_frame->pic_info[index].enabled) {
+        av_log(ctx, AV_LOG_ERROR, "Frame has no output %d\n", index);
+        return AVERROR(EINVAL);
+    }
+
+    ret = av_frame_ref(dst, src);
+    if (ret < 0)
+        return ret;
+
+    for (i = 1; i < PIC_INDEX_MAX_NUMBER; i++) {
+        buf = av_buffer_pool_get(priv->pic_info_pool);
+        if (!buf) {
+            av_frame_unref(dst);
+            return AVERROR(ENOMEM);
+        }
+        if (src->buf[i])
+            memcpy(buf->data, src->buf[i]->data,
+                   FFMIN(src->buf[i]->size, buf->size));
+        else
+            memset(buf->data, 0, buf->size);
+        pic_info          = (VpiPicInfo *)buf->data;
+        pic_info->enabled = i == index;
+        av_buffer_unref(&dst->buf[i]);
+        dst->buf[i] = buf;
+    }
+    dst->width  = vpi_frame->pic_info[index].width;
+    dst->height = vpi_frame->pic_info[index].height;
+
+    return 0;
+}
+
 static void vpe_device_free(AVHWDeviceContext *device_ctx)
 {
     AVVpeDeviceContext *hwctx = device_ctx->hwctx;
     VpeDevicePriv *priv = (VpeDevicePriv *)device_ctx->user_opaque;
+    int i;
 
-    vpi_destroy(priv->sys_info, hwctx->device);
-
-    vpi_freep(&priv->sys_info);
+    for (i = 0; i < hwctx->nb_devices; i++) {
+        vpi_destroy(priv->devices[i].sys_info, hwctx->devices[i]);
+        vpi_freep(&priv->devices[i].sys_info);
+        vpi_close_hwdevice(hwctx->devices[i]);
+    }
+    pthread_mutex_destroy(&priv->lock);
     av_freep(&priv);
+}
 
-    if (hwctx->device >= 0)
-        vpi_close_hwdevice(hwctx->device);
+static int vpe_device_open(AVHWDeviceContext *device_ctx, const char *path,
+                           int priority, int log_level)
+{
+    AVVpeDeviceContext *hwctx = device_ctx->hwctx;
+    VpeDevicePriv *priv       = device_ctx->user_opaque;
+    VpeDevice *dev            = &priv->devices[hwctx->nb_devices];
+    int ret, fd;
+
+    if (hwctx->nb_devices == AV_VPE_MAX_DEVICES) {
+        av_log(device_ctx, AV_LOG_ERROR, "More than %d devices\n",
+               AV_VPE_MAX_DEVICES);
+        return AVERROR(EINVAL);
+    }
+
+    ret = vpi_get_sys_info_struct(&dev->sys_info);
+    if (ret || !dev->sys_info)
+        return AVERROR(ENOMEM);
+
+    fd = vpi_open_hwdevice(path);
+    if (fd == -1) {
+        av_log(device_ctx, AV_LOG_ERROR, "failed to open hw device %s\n", path);
+        vpi_freep(&dev->sys_info);
+        return AVERROR_EXTERNAL;
+    }
+    hwctx->devices[hwctx->nb_devices++] = fd;
+
+    dev->sys_info->device        = fd;
+    dev->sys_info->priority      = priority;
+    dev->sys_info->sys_log_level = log_level;
+    dev->load.device             = fd;
+
+    if (vpi_create((void**)&dev->sys_info, &dev->func, fd, HWCONTEXT_VPE) != 0)
+        return AVERROR_EXTERNAL;
+
+    return 0;
 }
 
 static int vpe_device_create(AVHWDeviceContext *device_ctx, const char *device,
@@ -417,16 +1060,15 @@ static int vpe_device_create(AVHWDeviceContext *device_ctx, const char *device,
     AVVpeDeviceContext *hwctx = device_ctx->hwctx;
     AVDictionaryEntry *opt;
     VpeDevicePriv *priv;
-    int ret;
+    int priority  = VPE_TASK_VOD;
+    int log_level = 0;
+    char path[32], *paths, *next, *saveptr;
+    int i, ret;
 
     priv = av_mallocz(sizeof(*priv));
     if (!priv)
         return AVERROR(ENOMEM);
-    ret = vpi_get_sys_info_struct(&priv->sys_info);
-    if (ret || !priv->sys_info) {
-        av_freep(&priv);
-        return AVERROR(ENOMEM);
-    }
+    pthread_mutex_init(&priv->lock, NULL);
 
     device_ctx->user_opaque = priv;
     device_ctx->free        = vpe_device_free;
@@ -435,23 +1077,14 @@ static int vpe_device_create(AVHWDeviceContext *device_ctx, const char *device,
         av_log(device_ctx, AV_LOG_ERROR, "No valid device path\n");
         return AVERROR_INVALIDDATA;
     }
-    hwctx->device = vpi_open_hwdevice(device);
-    if (hwctx->device == -1) {
-        av_log(device_ctx, AV_LOG_ERROR, "failed to open hw device\n");
-        return AVERROR_EXTERNAL;
-    }
-
-    priv->sys_info->device        = hwctx->device;
-    priv->sys_info->priority      = VPE_TASK_VOD;
-    priv->sys_info->sys_log_level = 0;
 
     if (opts) {
         opt = av_dict_get(opts, "priority", NULL, 0);
         if (opt) {
             if (!strcmp(opt->value, "live")) {
-                priv->sys_info->priority = VPE_TASK_LIVE;
+                priority = VPE_TASK_LIVE;
             } else if (!strcmp(opt->value, "vod")) {
-                priv->sys_info->priority = VPE_TASK_VOD;
+                priority = VPE_TASK_VOD;
             } else {
                 av_log(device_ctx, AV_LOG_ERROR, "Unknow priority : %s\n",
                        opt->value);
@@ -461,12 +1094,51 @@ static int vpe_device_create(AVHWDeviceContext *device_ctx, const char *device,
 
         opt = av_dict_get(opts, "vpeloglevel", NULL, 0);
         if (opt)
-            priv->sys_info->sys_log_level = atoi(opt->value);
+            log_level = atoi(opt->value);
+
+        opt = av_dict_get(opts, "transfer_depth", NULL, 0);
+        if (opt)
+            priv->transfer_depth = atoi(opt->value);
+
+        opt = av_dict_get(opts, "initial_pool_size", NULL, 0);
+        if (opt)
+            priv->initial_pool_size = atoi(opt->value);
+
+        opt = av_dict_get(opts, "max_pool_size", NULL, 0);
+        if (opt)
+            priv->max_pool_size = atoi(opt->value);
     }
 
-    if (vpi_create((void**)&priv->sys_info, &hwctx->func, hwctx->device,
-                    HWCONTEXT_VPE) != 0)
-        return AVERROR_EXTERNAL;
+    if (!strcmp(device, "auto")) {
+        for (i = 0; i < AV_VPE_MAX_DEVICES; i++) {
+            snprintf(path, sizeof(path), "/dev/transcoder%d", i);
+            if (access(path, F_OK))
+                continue;
+            ret = vpe_device_open(device_ctx, path, priority, log_level);
+            if (ret < 0)
+                return ret;
+        }
+    } else {
+        paths = av_strdup(device);
+        if (!paths)
+            return AVERROR(ENOMEM);
+        for (next = av_strtok(paths, ":", &saveptr); next;
+             next = av_strtok(NULL, ":", &saveptr)) {
+            ret = vpe_device_open(device_ctx, next, priority, log_level);
+            if (ret < 0) {
+                av_free(paths);
+                return ret;
+            }
+        }
+        av_free(paths);
+    }
+
+    if (!hwctx->nb_devices) {
+        av_log(device_ctx, AV_LOG_ERROR, "No device found for '%s'\n", device);
+        return AVERROR(ENODEV);
+    }
+    hwctx->device = hwctx->devices[0];
+    hwctx->func   = priv->devices[0].func;
 
     return 0;
 }
@@ -487,6 +1159,7 @@ const HWContextType ff_hwcontext_type_vpe = {
     .transfer_get_formats   = vpe_transfer_get_formats,
     .transfer_data_from     = vpe_transfer_data_from,
     .transfer_data_to       = vpe_transfer_data_to,
+    .map_from               = vpe_map_from,
 
     .pix_fmts = (const enum AVPixelFormat[]){ AV_PIX_FMT_VPE, AV_PIX_FMT_NONE },
 };
@@ -25,21 +25,64 @@
 #include <vpe/vpi_api.h>
 #include <vpe/vpi_types.h>
 
+#include "frame.h"
+#include "hwcontext.h"
+
 /**
  * @file
  * An API-specific header for AV_HWDEVICE_TYPE_VPE.
  */
 
+/**
+ * Maximum number of devices in one AVHWDeviceContext.
+ */
+#define AV_VPE_MAX_DEVICES 16
+
 /**
  * This struct is allocated as AVHWDeviceContext.hwctx
  * It will save some device level info
+ *
+ * The device string given to av_hwdevice_ctx_create() is either one device
+ * path, a ':' separated list of device paths or "auto" for all the
+ * /dev/transcoder* devices present. Each frames context is placed on the
+ * least loaded device of the set, see AVVpeFramesContext.device.
  */
-
 typedef struct AVVpeDeviceContext {
+    /**
+     * The first device of the set, same as devices[0].
+     */
     int device;
     VpiApi *func;
+    /**
+     * All the devices of the set.
+     */
+    int devices[AV_VPE_MAX_DEVICES];
+    int nb_devices;
 } AVVpeDeviceContext;
 
+/**
+ * Utilisation of one device of an AVVpeDeviceContext.
+ */
+typedef struct AVVpeDeviceLoad {
+    /**
+     * The device, one of AVVpeDeviceContext.devices.
+     */
+    int device;
+    /**
+     * Decoder, encoder, pp and transfer sessions open on the device.
+     */
+    int nb_sessions;
+    /**
+     * Frame buffers allocated on the device, i.e. the frames queued in or
+     * held by its sessions.
+     */
+    int nb_frames;
+    /**
+     * Frames contexts placed on the device.
+     */
+    int nb_frames_ctx;
+} AVVpeDeviceLoad;
+
 /**
  * This struct is allocated as AVHWFramesContext.hwctx
  * It will save some frame level info
@@ -48,5 +91,104 @@ typedef struct AVVpeFramesContext {
     VpiFrame *frame;
     int frame_size;
     int pic_info_size;
+    /**
+     * Number of uploads which may be in flight. 0 uploads synchronously,
+     * otherwise the source is copied to one of transfer_depth host staging
+     * buffers and sent to the device by a worker thread, and
+     * av_hwframe_transfer_data() only blocks when all of them are busy.
+     * Set by the user before av_hwframe_ctx_init(), defaults to the
+     * transfer_depth option of the device.
+     */
+    int transfer_depth;
+    /**
+     * Device the frames are allocated on, one of AVVpeDeviceContext.devices.
+     * Set by av_hwframe_ctx_init() to the device with the fewest sessions,
+     * then the fewest frame buffers, then the fewest frames contexts. The
+     * sessions processing these frames must be created on this device.
+     */
+    int device;
+    /**
+     * Maximum number of frame buffers allocated on the device, 0 for no
+     * limit. Once all of them are in use av_hwframe_get_buffer() fails with
+     * AVERROR(ENOMEM) instead of pinning more device memory. Set by the user
+     * before av_hwframe_ctx_init(), defaults to the max_pool_size option of
+     * the device. AVHWFramesContext.initial_pool_size likewise defaults to
+     * the initial_pool_size option of the device.
+     */
+    int max_pool_size;
 } AVVpeFramesContext;
+
+/**
+ * Frame buffer pool statistics of an AVVpeFramesContext.
+ */
+typedef struct AVVpeFramesStats {
+    /**
+     * Number of av_hwframe_get_buffer() calls.
+     */
+    int64_t nb_gets;
+    /**
+     * Gets served by a buffer returned to the pool.
+     */
+    int64_t nb_hits;
+    /**
+     * Gets which allocated a new device buffer.
+     */
+    int64_t nb_misses;
+    /**
+     * Gets which failed because max_pool_size was reached or the device
+     * was out of memory.
+     */
+    int64_t nb_failures;
+    /**
+     * Device buffers currently allocated.
+     */
+    int nb_allocated;
+    /**
+     * Buffers currently referenced by frames.
+     */
+    int nb_in_use;
+    /**
+     * High-water mark of nb_in_use.
+     */
+    int max_in_use;
+} AVVpeFramesStats;
+
+/**
+ * Get the frame buffer pool statistics of a frames context.
+ *
+ * @param ctx   an initialized AV_HWDEVICE_TYPE_VPE frames context
+ * @param stats filled with the statistics
+ * @return 0 on success, AVERROR(EINVAL) for another type of frames context
+ */
+int av_vpe_frames_get_stats(AVHWFramesContext *ctx, AVVpeFramesStats *stats);
+
+/**
+ * Reference one of the downscaled pictures of a VPE frame.
+ *
+ * A VPE decoder or vpe_pp configured with low_res outputs all the
+ * resolutions in one frame, the picture read by the next component is the
+ * enabled pic_info of the frame. dst references the same device memory as
+ * src, with pic_info buffers of its own where only the given output is
+ * enabled, and the size of that output. src is not modified, so the full
+ * resolution frame and its downscaled pictures can be consumed
+ * independently without a pp pass.
+ *
+ * @param dst   an empty frame, filled with the reference
+ * @param src   an AV_PIX_FMT_VPE frame
+ * @param index index of the output, in [1, PIC_INDEX_MAX_NUMBER)
+ * @return 0 on success, AVERROR(EINVAL) if src does not have the output
+ */
+int av_vpe_frame_ref_output(AVFrame *dst, const AVFrame *src, int index);
+
+/**
+ * Get the current utilisation of a device.
+ *
+ * @param ctx   an AV_HWDEVICE_TYPE_VPE device context
+ * @param index index of the device in AVVpeDeviceContext.devices
+ * @param load  filled with the utilisation of the device
+ * @return 0 on success, AVERROR(EINVAL) if index is out of range
+ */
+int av_vpe_device_get_load(AVHWDeviceContext *ctx, int index,
+                           AVVpeDeviceLoad *load);
+
 #endif /* AVUTIL_HWCONTEXT_VPE_H */
@@ -0,0 +1,52 @@
+/*
+ * Verisilicon hardware context
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVUTIL_HWCONTEXT_VPE_INTERNAL_H
+#define AVUTIL_HWCONTEXT_VPE_INTERNAL_H
+
+#include "frame.h"
+#include "hwcontext.h"
+#include "hwcontext_vpe.h"
+
+/**
+ * @file
+ * FFmpeg internal API for VPE.
+ */
+
+/**
+ * Wait until the pixels of an AV_PIX_FMT_VPE frame are on the device.
+ *
+ * Uploads run asynchronously when AVVpeFramesContext.transfer_depth is
+ * not 0, every component reading a frame from the device calls this first.
+ * Frames which are not being uploaded return at once.
+ *
+ * @return 0 on success, a negative AVERROR if the upload failed
+ */
+int avpriv_vpe_frame_wait(const AVFrame *frame);
+
+/**
+ * Account for a VPI session created (delta 1) or destroyed (delta -1) on
+ * AVVpeFramesContext.device of ctx. Frames contexts are placed on the device
+ * with the fewest sessions, so every session is counted.
+ */
+void avpriv_vpe_device_session_add(AVHWFramesContext *ctx, int delta);
+
+#endif /* AVUTIL_HWCONTEXT_VPE_INTERNAL_H */
@@ -0,0 +1,163 @@
+/*
+ * Verisilicon VPE frame pool
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdint.h>
+
+#include "error.h"
+#include "mem.h"
+#include "vpe_frame_pool.h"
+
+/**
+ * Add one free entry, the index lists are sized for the whole pool so
+ * that releasing never needs to allocate.
+ */
+static int vpe_frame_pool_grow(VpeFramePool *pool)
+{
+    VpeFramePoolEntry **entries, *entry;
+    int *free_list, *used_list;
+    int nb = pool->nb_entries + 1;
+
+    free_list = av_realloc_array(pool->free_list, nb, sizeof(*free_list));
+    if (!free_list)
+        return AVERROR(ENOMEM);
+    pool->free_list = free_list;
+
+    used_list = av_realloc_array(pool->used_list, nb, sizeof(*used_list));
+    if (!used_list)
+        return AVERROR(ENOMEM);
+    pool->used_list = used_list;
+
+    entries = av_realloc_array(pool->entries, nb, sizeof(*entries));
+    if (!entries)
+        return AVERROR(ENOMEM);
+    pool->entries = entries;
+
+    entry = av_mallocz(sizeof(*entry));
+    if (!entry)
+        return AVERROR(ENOMEM);
+    entry->frame = av_frame_alloc();
+    if (!entry->frame) {
+        av_freep(&entry);
+        return AVERROR(ENOMEM);
+    }
+    entry->index    = pool->nb_entries;
+    entry->used_pos = -1;
+
+    pool->entries[pool->nb_entries]  = entry;
+    pool->free_list[pool->nb_free++] = pool->nb_entries++;
+
+    return 0;
+}
+
+int avpriv_vpe_frame_pool_get(VpeFramePool *pool, VpeFramePoolEntry **entry)
+{
+    int ret;
+
+    if (!pool->nb_free) {
+        ret = vpe_frame_pool_grow(pool);
+        if (ret < 0)
+            return ret;
+    }
+
+    *entry = pool->entries[pool->free_list[--pool->nb_free]];
+    return 0;
+}
+
+void avpriv_vpe_frame_pool_publish(VpeFramePool *pool, VpeFramePoolEntry *entry)
+{
+    entry->vpi_frame         = (VpiFrame *)entry->frame->data[0];
+    entry->vpi_frame->opaque = (void *)(intptr_t)(entry->index + 1);
+
+    entry->used_pos                  = pool->nb_used;
+    pool->used_list[pool->nb_used++] = entry->index;
+}
+
+VpeFramePoolEntry *avpriv_vpe_frame_pool_find(VpeFramePool *pool,
+                                              const VpiFrame *vpi_frame)
+{
+    intptr_t index = (intptr_t)vpi_frame->opaque - 1;
+    int i;
+
+    if (index >= 0 && index < pool->nb_entries &&
+        pool->entries[index]->vpi_frame == vpi_frame &&
+        pool->entries[index]->used_pos >= 0)
+        return pool->entries[index];
+
+    /* the tag has been overwritten by the device, fall back to a lookup */
+    for (i = 0; i < pool->nb_used; i++) {
+        VpeFramePoolEntry *entry = pool->entries[pool->used_list[i]];
+
+        if (entry->vpi_frame == vpi_frame)
+            return entry;
+    }
+    return NULL;
+}
+
+void avpriv_vpe_frame_pool_release(VpeFramePool *pool, VpeFramePoolEntry *entry)
+{
+    int last;
+
+    if (entry->used_pos >= 0) {
+        last = pool->used_list[--pool->nb_used];
+        pool->used_list[entry->used_pos] = last;
+        pool->entries[last]->used_pos    = entry->used_pos;
+        entry->used_pos                  = -1;
+    }
+    entry->vpi_frame = NULL;
+    av_frame_unref(entry->frame);
+
+    pool->free_list[pool->nb_free++] = entry->index;
+}
+
+void avpriv_vpe_frame_pool_release_unlocked(VpeFramePool *pool,
+                                            void (*consume)(void *opaque,
+                                                            VpiFrame *vpi_frame),
+                                            void *opaque)
+{
+    VpeFramePoolEntry *entry;
+    int i;
+
+    /* walk backwards, releasing moves the last entry into the hole */
+    for (i = pool->nb_used - 1; i >= 0; i--) {
+        entry = pool->entries[pool->used_list[i]];
+        if (entry->vpi_frame->locked)
+            continue;
+        if (consume)
+            consume(opaque, entry->vpi_frame);
+        avpriv_vpe_frame_pool_release(pool, entry);
+    }
+}
+
+void avpriv_vpe_frame_pool_uninit(VpeFramePool *pool)
+{
+    int i;
+
+    for (i = 0; i < pool->nb_entries; i++) {
+        av_frame_free(&pool->entries[i]->frame);
+        av_freep(&pool->entries[i]);
+    }
+    av_freep(&pool->entries);
+    av_freep(&pool->free_list);
+    av_freep(&pool->used_list);
+    pool->nb_entries = 0;
+    pool->nb_free    = 0;
+    pool->nb_used    = 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Verisilicon VPE frame pool
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVUTIL_VPE_FRAME_POOL_H
+#define AVUTIL_VPE_FRAME_POOL_H
+
+#include <vpe/vpi_types.h>
+
+#include "frame.h"
+
+/**
+ * @file
+ * Index addressed pool of the AV_PIX_FMT_VPE frames lent to the VPE device
+ * by the decoders and filters.
+ *
+ * Every entry keeps a reference to its AVFrame until the device no longer
+ * locks the VpiFrame. The entry index is stored in VpiFrame.opaque, so
+ * finding the entry of a VpiFrame returned by the device, taking a free
+ * entry and releasing one are constant time, and no memory is allocated
+ * once the pool has grown to the pipeline depth.
+ */
+
+typedef struct VpeFramePoolEntry {
+    AVFrame *frame;
+    // frame structure used for external hw device, frame->data[0]
+    VpiFrame *vpi_frame;
+    // index of the entry in the pool
+    int index;
+    // position in the in use list, -1 when the entry is free
+    int used_pos;
+} VpeFramePoolEntry;
+
+typedef struct VpeFramePool {
+    VpeFramePoolEntry **entries;
+    int nb_entries;
+    // stack of the free entry indexes
+    int *free_list;
+    int nb_free;
+    // dense list of the entry indexes lent to the device
+    int *used_list;
+    int nb_used;
+} VpeFramePool;
+
+/**
+ * Take a free entry from the pool, growing it when all entries are in use.
+ *
+ * The AVFrame of the entry is blank, the caller allocates its buffer and
+ * then calls avpriv_vpe_frame_pool_publish(), or hands the entry back with
+ * avpriv_vpe_frame_pool_release() on failure.
+ */
+int avpriv_vpe_frame_pool_get(VpeFramePool *pool, VpeFramePoolEntry **entry);
+
+/**
+ * Mark the entry as lent to the device once entry->frame holds a
+ * AV_PIX_FMT_VPE buffer, and tag its VpiFrame with the entry index.
+ */
+void avpriv_vpe_frame_pool_publish(VpeFramePool *pool, VpeFramePoolEntry *entry);
+
+/**
+ * Find the entry owning a VpiFrame, NULL if the frame is not from the pool.
+ */
+VpeFramePoolEntry *avpriv_vpe_frame_pool_find(VpeFramePool *pool,
+                                              const VpiFrame *vpi_frame);
+
+/**
+ * Unreference the frame of the entry and put the entry back on the free list.
+ */
+void avpriv_vpe_frame_pool_release(VpeFramePool *pool, VpeFramePoolEntry *entry);
+
+/**
+ * Release all the entries whose VpiFrame is no longer locked by the device.
+ *
+ * @param consume called with each VpiFrame before it is released, may be NULL
+ */
+void avpriv_vpe_frame_pool_release_unlocked(VpeFramePool *pool,
+                                            void (*consume)(void *opaque,
+                                                            VpiFrame *vpi_frame),
+                                            void *opaque);
+
+/**
+ * Free all the entries, whether they are in use or not.
+ */
+void avpriv_vpe_frame_pool_uninit(VpeFramePool *pool);
+
+#endif /* AVUTIL_VPE_FRAME_POOL_H */
@@ -0,0 +1,116 @@
+/*
+ * Verisilicon VPE pipeline statistics
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "avutil.h"
+#include "common.h"
+#include "log.h"
+#include "time.h"
+#include "vpe_stats.h"
+
+void avpriv_vpe_stats_submit(VpeStats *stats, int64_t key)
+{
+    int64_t now = av_gettime_relative();
+
+    if (key == AV_NOPTS_VALUE)
+        return;
+    if (!stats->first_submit)
+        stats->first_submit = now;
+
+    // a frame the device never returned, forget the oldest
+    if (stats->nb_pending == VPE_STATS_NB_PENDING) {
+        memmove(stats->pending, stats->pending + 1,
+                --stats->nb_pending * sizeof(*stats->pending));
+    }
+    stats->pending[stats->nb_pending].key  = key;
+    stats->pending[stats->nb_pending].time = now;
+    stats->nb_pending++;
+
+    stats->depth     = stats->nb_pending;
+    stats->max_depth = FFMAX(stats->max_depth, stats->depth);
+}
+
+int64_t avpriv_vpe_stats_complete(VpeStats *stats, int64_t key)
+{
+    int64_t now = av_gettime_relative();
+    int64_t latency;
+    int i, bucket;
+
+    if (key == AV_NOPTS_VALUE)
+        return -1;
+    for (i = 0; i < stats->nb_pending; i++) {
+        if (stats->pending[i].key == key)
+            break;
+    }
+    if (i == stats->nb_pending)
+        return -1;
+
+    latency = now - stats->pending[i].time;
+    memmove(stats->pending + i, stats->pending + i + 1,
+            (--stats->nb_pending - i) * sizeof(*stats->pending));
+    stats->depth = stats->nb_pending;
+
+    stats->nb_frames++;
+    if (now > stats->first_submit)
+        stats->fps = stats->nb_frames * 1000000.0 / (now - stats->first_submit);
+    stats->total_latency += latency;
+    stats->avg_latency    = stats->total_latency / stats->nb_frames;
+    stats->max_latency    = FFMAX(stats->max_latency, latency);
+    bucket = latency < 1000 ? 0 : av_log2(latency / 1000) + 1;
+    stats->hist[FFMIN(bucket, VPE_STATS_NB_BUCKETS - 1)]++;
+
+    return latency;
+}
+
+void avpriv_vpe_stats_export(const VpeStats *stats, AVDictionary **metadata,
+                             const char *prefix, int64_t latency)
+{
+    char key[64];
+
+    if (latency < 0)
+        return;
+
+    snprintf(key, sizeof(key), "%s.latency", prefix);
+    av_dict_set_int(metadata, key, latency, 0);
+    if (stats->sync)
+        return;
+    snprintf(key, sizeof(key), "%s.depth", prefix);
+    av_dict_set_int(metadata, key, stats->depth, 0);
+}
+
+void avpriv_vpe_stats_log(void *avcl, const char *stage, const VpeStats *stats)
+{
+    if (!stats->nb_frames)
+        return;
+
+    av_log(avcl, AV_LOG_VERBOSE, "%s: %"PRId64" frames, %.2f fps, latency "
+           "avg %"PRId64" max %"PRId64" us", stage, stats->nb_frames,
+           stats->fps, stats->avg_latency, stats->max_latency);
+    if (!stats->sync)
+        av_log(avcl, AV_LOG_VERBOSE, ", max depth %d", stats->max_depth);
+    av_log(avcl, AV_LOG_VERBOSE, ", latency ms <1:%"PRId64" <2:%"PRId64
+           " <4:%"PRId64" <8:%"PRId64" <16:%"PRId64" <32:%"PRId64" <64:%"PRId64
+           " >=64:%"PRId64"\n", stats->hist[0], stats->hist[1],
+           stats->hist[2], stats->hist[3], stats->hist[4], stats->hist[5],
+           stats->hist[6], stats->hist[7]);
+}
@@ -0,0 +1,122 @@
+/*
+ * Verisilicon VPE pipeline statistics
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVUTIL_VPE_STATS_H
+#define AVUTIL_VPE_STATS_H
+
+#include <float.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "dict.h"
+#include "opt.h"
+
+/**
+ * @file
+ * Latency and throughput counters of one VPE pipeline stage.
+ *
+ * A stage records the time each frame is submitted to the device and the
+ * time it comes back, matching them by a key: the pts of the frame, or a
+ * sequence number for stages which reorder frames. The aggregate counters
+ * are exported as read-only AVOptions with VPE_STATS_OPTIONS() and logged
+ * at close, the latency of each frame is exported in its metadata.
+ */
+
+// latency buckets: <1ms, <2ms, <4ms, ... <64ms, more
+#define VPE_STATS_NB_BUCKETS 8
+// frames in flight whose submit time is kept
+#define VPE_STATS_NB_PENDING 128
+
+typedef struct VpeStats {
+    // the stage completes each frame before submitting the next one, so the
+    // depth is always 0 or 1 and is neither logged nor exported
+    int sync;
+
+    // frames completed, only counting those whose submission was recorded
+    int64_t nb_frames;
+    // latency in microseconds
+    int64_t total_latency;
+    int64_t avg_latency;
+    int64_t max_latency;
+    int64_t hist[VPE_STATS_NB_BUCKETS];
+    // frames submitted and not completed yet, i.e. nb_pending
+    int depth;
+    int max_depth;
+    // completed frames per second since the first submission
+    double fps;
+    int64_t first_submit;
+
+    // submit time of the frames in flight, oldest first
+    struct {
+        int64_t key;
+        int64_t time;
+    } pending[VPE_STATS_NB_PENDING];
+    int nb_pending;
+} VpeStats;
+
+/**
+ * Read-only AVOptions exporting the counters of the VpeStats member
+ * stats of the context at offset off.
+ */
+#define VPE_STATS_OPTIONS(off, stats, flags)                                 \
+    { "stats_frames", "Frames completed (read-only)",                        \
+      off(stats.nb_frames), AV_OPT_TYPE_INT64, { .i64 = 0 }, 0, INT64_MAX,   \
+      (flags) | AV_OPT_FLAG_EXPORT | AV_OPT_FLAG_READONLY },                 \
+    { "stats_avg_latency", "Average latency in us (read-only)",              \
+      off(stats.avg_latency), AV_OPT_TYPE_INT64, { .i64 = 0 }, 0, INT64_MAX, \
+      (flags) | AV_OPT_FLAG_EXPORT | AV_OPT_FLAG_READONLY },                 \
+    { "stats_max_latency", "Maximum latency in us (read-only)",              \
+      off(stats.max_latency), AV_OPT_TYPE_INT64, { .i64 = 0 }, 0, INT64_MAX, \
+      (flags) | AV_OPT_FLAG_EXPORT | AV_OPT_FLAG_READONLY },                 \
+    { "stats_max_depth", "Maximum frames in flight (read-only)",             \
+      off(stats.max_depth), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, INT_MAX,      \
+      (flags) | AV_OPT_FLAG_EXPORT | AV_OPT_FLAG_READONLY },                 \
+    { "stats_fps", "Completed frames per second (read-only)",                \
+      off(stats.fps), AV_OPT_TYPE_DOUBLE, { .dbl = 0 }, 0, DBL_MAX,          \
+      (flags) | AV_OPT_FLAG_EXPORT | AV_OPT_FLAG_READONLY }
+
+/**
+ * Record the submission of the frame with the given key, nothing is
+ * recorded for AV_NOPTS_VALUE.
+ */
+void avpriv_vpe_stats_submit(VpeStats *stats, int64_t key);
+
+/**
+ * Record the completion of the frame with the given key.
+ *
+ * @return the latency of the frame in microseconds, -1 if its submission
+ *         was not recorded, the frame is then not counted
+ */
+int64_t avpriv_vpe_stats_complete(VpeStats *stats, int64_t key);
+
+/**
+ * Set the "<prefix>.latency" and, unless the stage is sync, "<prefix>.depth"
+ * entries of a frame metadata, nothing is set for a negative latency.
+ */
+void avpriv_vpe_stats_export(const VpeStats *stats, AVDictionary **metadata,
+                             const char *prefix, int64_t latency);
+
+/**
+ * Log the counters at verbose level.
+ */
+void avpriv_vpe_stats_log(void *avcl, const char *stage, const VpeStats *stats);
+
+#endif /* AVUTIL_VPE_STATS_H */
@@ -410,6 +410,23 @@ pixfmts(){
     test=$outertest
 }
 
+inplace(){
+    filter=${test#filter-inplace-}
+    filter_args=$1
+    pix_fmts=$2
+
+    # the frames shared with the other output of split cannot be written
+    # in place, the output must be the same
+    outertest=$test
+    for pix_fmt in $pix_fmts; do
+        test=$pix_fmt
+        video_filter "format=$pix_fmt,$filter=$filter_args" -pix_fmt $pix_fmt
+        test=${pix_fmt}_split
+        video_filter "format=$pix_fmt,split[a][b];[a]$filter=$filter_args;[b]nullsink" -pix_fmt $pix_fmt
+    done
+    test=$outertest
+}
+
 gapless(){
     sample=$(target_path $1)
     extra_args=$2
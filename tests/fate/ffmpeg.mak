@@ -41,6 +41,29 @@ fate-ffmpeg-filter_colorkey: CMD = framecrc -idct simple -fflags +bitexact -flag
 FATE_FFMPEG-$(CONFIG_COLOR_FILTER) += fate-ffmpeg-lavfi
 fate-ffmpeg-lavfi: CMD = framecrc -lavfi color=d=1:r=5 -fflags +bitexact
 
+# filtering in a thread with -filter_queue_size must not change the output
+FATE_FFMPEG-$(call ALLYES, RAWVIDEO_DEMUXER HFLIP_FILTER SCALE_FILTER) += fate-ffmpeg-filter_queue fate-ffmpeg-filter_queue_size
+fate-ffmpeg-filter_queue fate-ffmpeg-filter_queue_size: tests/data/vsynth1.yuv
+fate-ffmpeg-filter_queue: CMD = framecrc -f rawvideo -s 352x288 -pix_fmt yuv420p -i $(TARGET_PATH)/tests/data/vsynth1.yuv -sws_flags +bitexact -vf hflip,scale=176x144
+fate-ffmpeg-filter_queue_size: CMD = framecrc -filter_queue_size 4 -f rawvideo -s 352x288 -pix_fmt yuv420p -i $(TARGET_PATH)/tests/data/vsynth1.yuv -sws_flags +bitexact -vf hflip,scale=176x144
+fate-ffmpeg-filter_queue_size: REF = $(SRC_PATH)/tests/ref/fate/ffmpeg-filter_queue
+
+# the branches of split run concurrently and share the frame pool of their
+# geometry, the output must be the same as with slice threading only
+FATE_FFMPEG-$(call ALLYES, RAWVIDEO_DEMUXER SPLIT_FILTER HFLIP_FILTER VFLIP_FILTER SCALE_FILTER HSTACK_FILTER) += fate-ffmpeg-filter_frame_threads fate-ffmpeg-filter_slice_threads
+fate-ffmpeg-filter_frame_threads fate-ffmpeg-filter_slice_threads: tests/data/vsynth1.yuv
+fate-ffmpeg-filter_slice_threads: CMD = framecrc -filter_complex_threads 4 -f rawvideo -s 352x288 -pix_fmt yuv420p -i $(TARGET_PATH)/tests/data/vsynth1.yuv -sws_flags +bitexact -filter_complex "split[a][b];[a]hflip,scale=176x144[a1];[b]vflip,scale=176x144[b1];[a1][b1]hstack"
+fate-ffmpeg-filter_frame_threads: CMD = framecrc -filter_frame_threads -filter_complex_threads 4 -f rawvideo -s 352x288 -pix_fmt yuv420p -i $(TARGET_PATH)/tests/data/vsynth1.yuv -sws_flags +bitexact -filter_complex "split[a][b];[a]hflip,scale=176x144[a1];[b]vflip,scale=176x144[b1];[a1][b1]hstack"
+fate-ffmpeg-filter_frame_threads: REF = $(SRC_PATH)/tests/ref/fate/ffmpeg-filter_slice_threads
+
+# scale splits the picture into bands scaled by the filter threads, the
+# output must be the same as with a single thread
+FATE_FFMPEG-$(call ALLYES, RAWVIDEO_DEMUXER SCALE_FILTER) += fate-ffmpeg-scale_bands fate-ffmpeg-scale_nobands
+fate-ffmpeg-scale_bands fate-ffmpeg-scale_nobands: tests/data/vsynth1.yuv
+fate-ffmpeg-scale_nobands: CMD = framecrc -filter_threads 1 -f rawvideo -s 352x288 -pix_fmt yuv420p -i $(TARGET_PATH)/tests/data/vsynth1.yuv -sws_flags +bitexact -vf scale=176x144:out_range=full
+fate-ffmpeg-scale_bands: CMD = framecrc -filter_threads 4 -f rawvideo -s 352x288 -pix_fmt yuv420p -i $(TARGET_PATH)/tests/data/vsynth1.yuv -sws_flags +bitexact -vf scale=176x144:out_range=full
+fate-ffmpeg-scale_bands: REF = $(SRC_PATH)/tests/ref/fate/ffmpeg-scale_nobands
+
 FATE_SAMPLES_FFMPEG-$(CONFIG_RAWVIDEO_DEMUXER) += fate-force_key_frames
 fate-force_key_frames: tests/data/vsynth_lena.yuv
 fate-force_key_frames: CMD = enc_dec \
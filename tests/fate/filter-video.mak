@@ -720,6 +720,19 @@ FATE_FILTER_VSYNTH-$(CONFIG_FORMAT_FILTER) += $(FATE_FILTER_PIXFMTS-yes)
 
 fate-filter-pixfmts: $(FATE_FILTER_PIXFMTS-yes)
 
+FATE_FILTER_INPLACE-$(CONFIG_EQ_FILTER) += fate-filter-inplace-eq
+fate-filter-inplace-eq: CMD = inplace "contrast=1.5:brightness=0.1:saturation=1.5" "yuv420p"
+
+FATE_FILTER_INPLACE-$(CONFIG_HFLIP_FILTER) += fate-filter-inplace-hflip
+fate-filter-inplace-hflip: CMD = inplace "" "yuv420p rgb24 pal8 yuv444p16le"
+
+FATE_FILTER_INPLACE-$(CONFIG_LUT_FILTER) += fate-filter-inplace-lut
+fate-filter-inplace-lut: CMD = inplace "c0=2*val:c1=2*val:c2=val/2:c3=negval+40" "yuv420p rgb24 yuv444p16le"
+
+FATE_FILTER_VSYNTH-$(call ALLYES, FORMAT_FILTER SPLIT_FILTER NULLSINK_FILTER) += $(FATE_FILTER_INPLACE-yes)
+
+fate-filter-inplace: $(FATE_FILTER_INPLACE-yes)
+
 $(FATE_FILTER_VSYNTH-yes): $(VREF)
 $(FATE_FILTER_VSYNTH-yes): SRC = $(TARGET_PATH)/tests/vsynth1/%02d.pgm
 
@@ -0,0 +1,1444 @@
+/*
+ * Software reference implementation of the VPE VPI interface
+ * Copyright (C) 2020 VeriSilicon Holdings Co., Ltd.
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * Host-only stand-in for libvpi, so that the VPE codecs, filters and
+ * hwcontext can be exercised and profiled without a transcoder card.
+ *
+ * Decoding is done with the native FFmpeg decoders, post processing and
+ * uploads with swscale, and the encoders are null encoders emitting one
+ * small packet per picture which carries the Adler-32 of the luma plane
+ * it was given, so that the output stays comparable between runs.
+ *
+ * Build it against the VPE SDK headers and preload it in place of the
+ * real library:
+ *
+ *   make tools/libvpi_sw.so
+ *   LD_PRELOAD=tools/libvpi_sw.so ffmpeg -init_hw_device vpe=dev0:sw ...
+ *
+ * The behaviour is tuned with environment variables:
+ *   VPI_SW_LATENCY_US  time the "device" spends on each picture [0]
+ *   VPI_SW_STATS       print per session host overhead at destroy time
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vpe/vpi_types.h>
+#include <vpe/vpi_api.h>
+
+#include "libavcodec/avcodec.h"
+#include "libavutil/adler32.h"
+#include "libavutil/fifo.h"
+#include "libavutil/frame.h"
+#include "libavutil/imgutils.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/pixdesc.h"
+#include "libavutil/time.h"
+#include "libswscale/swscale.h"
+
+#define SW_SURFACE_MAGIC MKTAG('V', 'S', 'W', 'S')
+#define SW_CTX_MAGIC     MKTAG('V', 'S', 'W', 'C')
+
+/* Pictures the decoder may hold before asking for output to be drained */
+#define SW_DEC_MAX_PENDING 16
+/* Output buffers kept in reserve for reordering and the final flush */
+#define SW_DEC_RESERVE     16
+#define SW_ENC_SLOTS       (MAX_WAIT_DEPTH + 1)
+#define SW_ENC_PKT_SIZE    20
+
+#define SW_ERR_GENERIC  -1
+#define SW_ERR_NOMEM    -2
+#define SW_ERR_PARAM    -3
+
+/**
+ * Device buffer handed out for VPI_CMD_GET_FRAME_BUFFER.
+ *
+ * The hwcontext clears the VpiFrame every time the buffer is taken from
+ * its pool, so the pictures are kept in a header in front of it.
+ */
+typedef struct SwSurface {
+    uint32_t magic;
+    /* picture of each pp channel, index 1 is the full resolution one */
+    AVFrame *pic[PIC_INDEX_MAX_NUMBER];
+    VpiFrame frame;
+} SwSurface;
+
+typedef struct SwStats {
+    int64_t calls;
+    /* time spent inside the plugin, excluding the simulated latency */
+    int64_t host_us;
+    int64_t latency_us;
+    int64_t frames;
+    int64_t bytes_copied;
+    int64_t allocs;
+} SwStats;
+
+typedef struct SwLowRes {
+    int crop_x, crop_y, crop_w, crop_h;
+    int width, height;
+    int div;
+} SwLowRes;
+
+typedef struct SwDecPic {
+    AVFrame *frame;
+    int64_t ready;
+} SwDecPic;
+
+typedef struct SwEncJob {
+    VpiFrame *slot;
+    int64_t ready;
+} SwEncJob;
+
+typedef struct SwEncPkt {
+    uint8_t data[SW_ENC_PKT_SIZE];
+    int64_t pts;
+    int64_t dts;
+    int flags;
+} SwEncPkt;
+
+typedef struct SwCtx {
+    uint32_t magic;
+    VpiPlugin type;
+    int fd;
+    SwStats stats;
+    int64_t latency;
+    int64_t busy_until;
+    struct SwCtx *next;
+
+    /* post processing shared by the decoders, pp and hwupload */
+    SwLowRes low_res[PIC_INDEX_MAX_NUMBER];
+    int nb_low_res;
+    int force_10bit;
+    enum AVPixelFormat in_format;
+    VpiFrame *tmpl;
+    struct SwsContext *sws[PIC_INDEX_MAX_NUMBER];
+
+    /* decoder */
+    VpiDecOption *dec_opt;
+    VpiPacket strm_pkt;
+    AVCodecContext *dec;
+    AVFifoBuffer *used_strm;
+    AVFifoBuffer *decoded;
+    AVFifoBuffer *out_bufs;
+    int dec_eof;
+
+    /* pp */
+    VpiPPOption *pp_opt;
+
+    /* hwdownload */
+    int hwdw_index;
+
+    /* encoder */
+    void *enc_cfg;
+    int enc_width;
+    int enc_height;
+    VpiFrame enc_slots[SW_ENC_SLOTS];
+    int enc_slot_used[SW_ENC_SLOTS];
+    AVFifoBuffer *enc_jobs;
+    AVFifoBuffer *enc_consumed;
+    AVFifoBuffer *enc_pkts;
+    uint32_t enc_frame_num;
+    int enc_eof;
+} SwCtx;
+
+static pthread_mutex_t sw_lock = PTHREAD_MUTEX_INITIALIZER;
+static SwCtx *sw_ctx_list;
+static int sw_next_fd = 1000;
+static int64_t sw_dev_buffers;
+
+static const struct {
+    VpiPixsFmt vpi;
+    enum AVPixelFormat av;
+} sw_fmt_map[] = {
+    { VPI_FMT_YUV420P,     AV_PIX_FMT_YUV420P },
+    { VPI_FMT_YUV422P,     AV_PIX_FMT_YUV422P },
+    { VPI_FMT_NV12,        AV_PIX_FMT_NV12 },
+    { VPI_FMT_NV21,        AV_PIX_FMT_NV21 },
+    { VPI_FMT_YUV420P10LE, AV_PIX_FMT_YUV420P10LE },
+    { VPI_FMT_YUV420P10BE, AV_PIX_FMT_YUV420P10BE },
+    { VPI_FMT_YUV422P10LE, AV_PIX_FMT_YUV422P10LE },
+    { VPI_FMT_YUV422P10BE, AV_PIX_FMT_YUV422P10BE },
+    { VPI_FMT_P010LE,      AV_PIX_FMT_P010LE },
+    { VPI_FMT_P010BE,      AV_PIX_FMT_P010BE },
+    { VPI_FMT_YUV444P,     AV_PIX_FMT_YUV444P },
+    { VPI_FMT_RGB24,       AV_PIX_FMT_RGB24 },
+    { VPI_FMT_BGR24,       AV_PIX_FMT_BGR24 },
+    { VPI_FMT_ARGB,        AV_PIX_FMT_ARGB },
+    { VPI_FMT_RGBA,        AV_PIX_FMT_RGBA },
+    { VPI_FMT_ABGR,        AV_PIX_FMT_ABGR },
+    { VPI_FMT_BGRA,        AV_PIX_FMT_BGRA },
+    { VPI_FMT_UYVY,        AV_PIX_FMT_UYVY422 },
+};
+
+static enum AVPixelFormat sw_map_format(VpiPixsFmt fmt)
+{
+    int i;
+
+    for (i = 0; i < FF_ARRAY_ELEMS(sw_fmt_map); i++) {
+        if (sw_fmt_map[i].vpi == fmt)
+            return sw_fmt_map[i].av;
+    }
+    return AV_PIX_FMT_NONE;
+}
+
+static SwSurface *sw_surface(VpiFrame *frame)
+{
+    SwSurface *s;
+
+    if (!frame)
+        return NULL;
+    s = (SwSurface *)((uint8_t *)frame - offsetof(SwSurface, frame));
+    return s->magic == SW_SURFACE_MAGIC ? s : NULL;
+}
+
+static SwCtx *sw_ctx(VpiCtx ctx)
+{
+    SwCtx *c = ctx;
+
+    return c && c->magic == SW_CTX_MAGIC ? c : NULL;
+}
+
+static int64_t sw_enter(void)
+{
+    return av_gettime_relative();
+}
+
+static void sw_leave(SwCtx *c, int64_t start)
+{
+    c->stats.calls++;
+    c->stats.host_us += av_gettime_relative() - start;
+}
+
+/**
+ * Time at which a picture submitted now leaves the simulated device,
+ * which works on one picture at a time.
+ */
+static int64_t sw_schedule(SwCtx *c)
+{
+    int64_t now = av_gettime_relative();
+
+    c->busy_until = FFMAX(now, c->busy_until) + c->latency;
+    return c->busy_until;
+}
+
+static int sw_is_ready(int64_t ready)
+{
+    return av_gettime_relative() >= ready;
+}
+
+/**
+ * Block for the simulated processing time of a synchronous call.
+ */
+static void sw_process_delay(SwCtx *c)
+{
+    if (c->latency > 0) {
+        av_usleep(c->latency);
+        c->stats.latency_us += c->latency;
+    }
+}
+
+static int sw_parse_low_res(SwCtx *c, const char *str, int with_count)
+{
+    const char *p = str;
+    int n = 0;
+
+    c->nb_low_res = 0;
+    if (!str || !*str)
+        return 0;
+
+    if (with_count) {
+        p = strchr(str, ':');
+        if (!p)
+            return SW_ERR_PARAM;
+        p++;
+    }
+
+    while ((p = strchr(p, '('))) {
+        SwLowRes *lr;
+        int v[4];
+
+        /* index 1 is the full resolution picture, 0 is kept internal */
+        if (n + 2 >= PIC_INDEX_MAX_NUMBER)
+            return SW_ERR_PARAM;
+        lr = &c->low_res[n];
+        memset(lr, 0, sizeof(*lr));
+        p++;
+        if (*p == 'd') {
+            lr->div = atoi(p + 1);
+            if (lr->div <= 0)
+                return SW_ERR_PARAM;
+        } else if (sscanf(p, "%d,%d,%d,%d,%dx%d", &v[0], &v[1], &v[2], &v[3],
+                          &lr->width, &lr->height) == 6) {
+            lr->crop_x = v[0];
+            lr->crop_y = v[1];
+            lr->crop_w = v[2];
+            lr->crop_h = v[3];
+        } else if (sscanf(p, "%dx%d", &lr->width, &lr->height) != 2) {
+            return SW_ERR_PARAM;
+        }
+        n++;
+    }
+    c->nb_low_res = n;
+    return 0;
+}
+
+/**
+ * Compute the size of a downscaled channel from the source size.
+ */
+static void sw_low_res_size(const SwLowRes *lr, int src_w, int src_h,
+                            int *w, int *h)
+{
+    if (lr->crop_w > 0 && lr->crop_h > 0) {
+        src_w = lr->crop_w;
+        src_h = lr->crop_h;
+    }
+
+    if (lr->div) {
+        *w = src_w / lr->div;
+        *h = src_h / lr->div;
+    } else if (lr->width == -1) {
+        *h = lr->height;
+        *w = av_rescale(src_w, lr->height, src_h);
+    } else if (lr->height == -1) {
+        *w = lr->width;
+        *h = av_rescale(src_h, lr->width, src_w);
+    } else {
+        *w = lr->width;
+        *h = lr->height;
+    }
+    *w = FFALIGN(FFMAX(*w, 2), 2);
+    *h = FFALIGN(FFMAX(*h, 2), 2);
+}
+
+static AVFrame *sw_alloc_picture(SwCtx *c, enum AVPixelFormat format,
+                                 int width, int height)
+{
+    AVFrame *pic = av_frame_alloc();
+
+    if (!pic)
+        return NULL;
+    pic->format = format;
+    pic->width  = width;
+    pic->height = height;
+    if (av_frame_get_buffer(pic, 0) < 0) {
+        av_frame_free(&pic);
+        return NULL;
+    }
+    c->stats.allocs++;
+    return pic;
+}
+
+/**
+ * Scale and convert src into a newly allocated picture.
+ */
+static AVFrame *sw_convert(SwCtx *c, int index, const AVFrame *src,
+                           const SwLowRes *lr, enum AVPixelFormat format,
+                           int width, int height)
+{
+    const uint8_t *src_data[4] = { NULL };
+    int src_w = src->width, src_h = src->height;
+    AVFrame *dst;
+    int i;
+
+    for (i = 0; i < 4; i++)
+        src_data[i] = src->data[i];
+
+    if (lr && lr->crop_w > 0 && lr->crop_h > 0) {
+        const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(src->format);
+
+        for (i = 0; i < 4 && src->data[i]; i++) {
+            int shift_x = (i == 1 || i == 2) ? desc->log2_chroma_w : 0;
+            int shift_y = (i == 1 || i == 2) ? desc->log2_chroma_h : 0;
+            int max_step[4];
+
+            av_image_fill_max_pixsteps(max_step, NULL, desc);
+            src_data[i] += (lr->crop_y >> shift_y) * src->linesize[i] +
+                           (lr->crop_x >> shift_x) * max_step[i];
+        }
+        src_w = lr->crop_w;
+        src_h = lr->crop_h;
+    }
+
+    dst = sw_alloc_picture(c, format, width, height);
+    if (!dst)
+        return NULL;
+
+    c->sws[index] = sws_getCachedContext(c->sws[index], src_w, src_h,
+                                         src->format, width, height, format,
+                                         SWS_BILINEAR, NULL, NULL, NULL);
+    if (!c->sws[index]) {
+        av_frame_free(&dst);
+        return NULL;
+    }
+    sws_scale(c->sws[index], src_data, src->linesize, 0, src_h,
+              dst->data, dst->linesize);
+    c->stats.bytes_copied += av_image_get_buffer_size(format, width, height, 1);
+
+    return dst;
+}
+
+static void sw_surface_unref(SwSurface *s)
+{
+    int i;
+
+    for (i = 0; i < PIC_INDEX_MAX_NUMBER; i++)
+        av_frame_free(&s->pic[i]);
+}
+
+/**
+ * Publish a full resolution picture and its downscaled versions in a
+ * device surface.
+ */
+static int sw_surface_fill(SwCtx *c, SwSurface *s, AVFrame *full,
+                           const AVFrame *props)
+{
+    VpiFrame *f = &s->frame;
+    int i;
+
+    sw_surface_unref(s);
+    s->pic[1] = full;
+
+    for (i = 0; i < c->nb_low_res; i++) {
+        int w, h;
+
+        sw_low_res_size(&c->low_res[i], full->width, full->height, &w, &h);
+        s->pic[i + 2] = sw_convert(c, i + 2, full, &c->low_res[i],
+                                   full->format, w, h);
+        if (!s->pic[i + 2])
+            return SW_ERR_NOMEM;
+    }
+
+    f->src_width   = full->width;
+    f->src_height  = full->height;
+    f->width       = full->width;
+    f->height      = full->height;
+    f->linesize[0] = full->linesize[0];
+    f->linesize[1] = full->linesize[1];
+    f->linesize[2] = full->linesize[2];
+    f->data[0]     = full->data[0];
+    f->data[1]     = full->data[1];
+    f->data[2]     = full->data[2];
+    f->key_frame   = props->key_frame;
+    f->pts         = props->pts;
+    f->pkt_dts     = props->pkt_dts;
+    f->locked      = 0;
+    f->nb_outputs  = c->nb_low_res + 1;
+
+    for (i = 1; i < PIC_INDEX_MAX_NUMBER; i++) {
+        f->pic_info[i].enabled = !!s->pic[i];
+        f->pic_info[i].flag    = 0;
+        f->pic_info[i].width   = s->pic[i] ? s->pic[i]->width : 0;
+        f->pic_info[i].height  = s->pic[i] ? s->pic[i]->height : 0;
+    }
+
+    if (c->tmpl) {
+        c->tmpl->nb_outputs = f->nb_outputs;
+        for (i = 0; i < PIC_INDEX_MAX_NUMBER; i++)
+            c->tmpl->pic_info[i] = f->pic_info[i];
+    }
+
+    c->stats.frames++;
+    return 0;
+}
+
+/**
+ * Describe the layout of the template frame before the first picture,
+ * filters read it while the graph is configured.
+ */
+static void sw_fill_template(SwCtx *c, int width, int height)
+{
+    int i;
+
+    if (!c->tmpl || width <= 0 || height <= 0)
+        return;
+
+    c->tmpl->nb_outputs = c->nb_low_res + 1;
+    c->tmpl->pic_info[1].enabled = 1;
+    c->tmpl->pic_info[1].width   = width;
+    c->tmpl->pic_info[1].height  = height;
+    for (i = 0; i < c->nb_low_res; i++) {
+        int w, h;
+
+        sw_low_res_size(&c->low_res[i], width, height, &w, &h);
+        c->tmpl->pic_info[i + 2].enabled = 1;
+        c->tmpl->pic_info[i + 2].width   = w;
+        c->tmpl->pic_info[i + 2].height  = h;
+    }
+}
+
+/* ----------------------------------------------------------------------
+ * HWCONTEXT_VPE: device buffers
+ */
+
+static int sw_hwcontext_control(VpiCtx ctx, void *indata, void *outdata)
+{
+    VpiCtrlCmdParam *cmd = indata;
+    SwSurface *s;
+
+    switch (cmd->cmd) {
+    case VPI_CMD_GET_VPEFRAME_SIZE:
+        *(int *)outdata = sizeof(VpiFrame);
+        return 0;
+    case VPI_CMD_GET_PICINFO_SIZE:
+        *(int *)outdata = sizeof(VpiPicInfo);
+        return 0;
+    case VPI_CMD_SET_VPEFRAME:
+        return 0;
+    case VPI_CMD_GET_FRAME_BUFFER:
+        s = av_mallocz(sizeof(*s));
+        if (!s) {
+            *(VpiFrame **)outdata = NULL;
+            return SW_ERR_NOMEM;
+        }
+        s->magic = SW_SURFACE_MAGIC;
+        pthread_mutex_lock(&sw_lock);
+        sw_dev_buffers++;
+        pthread_mutex_unlock(&sw_lock);
+        *(VpiFrame **)outdata = &s->frame;
+        return 0;
+    case VPI_CMD_FREE_FRAME_BUFFER:
+        s = sw_surface(cmd->data);
+        if (!s)
+            return SW_ERR_PARAM;
+        sw_surface_unref(s);
+        s->magic = 0;
+        av_free(s);
+        pthread_mutex_lock(&sw_lock);
+        sw_dev_buffers--;
+        pthread_mutex_unlock(&sw_lock);
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+static VpiApi sw_hwcontext_api = {
+    .control = sw_hwcontext_control,
+};
+
+/* ----------------------------------------------------------------------
+ * Decoders
+ */
+
+static int sw_dec_drain(SwCtx *c)
+{
+    AVFrame *frame;
+    SwDecPic pic;
+    int ret;
+
+    while (1) {
+        frame = av_frame_alloc();
+        if (!frame)
+            return SW_ERR_NOMEM;
+        ret = avcodec_receive_frame(c->dec, frame);
+        if (ret < 0) {
+            av_frame_free(&frame);
+            return ret == AVERROR(EAGAIN) || ret == AVERROR_EOF ?
+                   0 : SW_ERR_GENERIC;
+        }
+        pic.frame = frame;
+        pic.ready = sw_schedule(c);
+        if (av_fifo_space(c->decoded) < sizeof(pic) &&
+            av_fifo_grow(c->decoded, sizeof(pic)) < 0) {
+            av_frame_free(&frame);
+            return SW_ERR_NOMEM;
+        }
+        av_fifo_generic_write(c->decoded, &pic, sizeof(pic), NULL);
+    }
+}
+
+static int sw_dec_init(VpiCtx ctx, void *cfg)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiDecOption *opt = cfg;
+    const char *name;
+    const AVCodec *codec;
+    int64_t start;
+    int ret;
+
+    if (!c || !opt)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    name = c->type == H264DEC_VPE ? "h264" :
+           c->type == HEVCDEC_VPE ? "hevc" : "vp9";
+    codec = avcodec_find_decoder_by_name(name);
+    if (!codec)
+        return SW_ERR_GENERIC;
+    c->dec = avcodec_alloc_context3(codec);
+    if (!c->dec)
+        return SW_ERR_NOMEM;
+    c->dec->thread_count = 1;
+    if (avcodec_open2(c->dec, codec, NULL) < 0)
+        return SW_ERR_GENERIC;
+
+    ret = sw_parse_low_res(c, (const char *)opt->pp_setting, 1);
+    if (ret < 0)
+        return ret;
+
+    c->tmpl = opt->frame;
+    sw_fill_template(c, opt->src_width, opt->src_height);
+
+    c->used_strm = av_fifo_alloc_array(MAX_WAIT_DEPTH, sizeof(AVBufferRef *));
+    c->decoded   = av_fifo_alloc_array(SW_DEC_MAX_PENDING, sizeof(SwDecPic));
+    c->out_bufs  = av_fifo_alloc_array(SW_DEC_RESERVE, sizeof(VpiFrame *));
+    if (!c->used_strm || !c->decoded || !c->out_bufs)
+        return SW_ERR_NOMEM;
+
+    sw_leave(c, start);
+    return 0;
+}
+
+static int sw_dec_put_packet(VpiCtx ctx, void *indata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiPacket *vpi_pkt = indata;
+    AVBufferRef *ref;
+    AVPacket pkt;
+    int64_t start;
+    int ret;
+
+    if (!c || !vpi_pkt)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    if (vpi_pkt->size <= 0) {
+        if (!c->dec_eof) {
+            avcodec_send_packet(c->dec, NULL);
+            c->dec_eof = 1;
+        }
+        ret = sw_dec_drain(c);
+        sw_leave(c, start);
+        return ret;
+    }
+
+    av_init_packet(&pkt);
+    pkt.data     = vpi_pkt->data;
+    pkt.size     = vpi_pkt->size;
+    pkt.pts      = vpi_pkt->pts;
+    pkt.dts      = vpi_pkt->pkt_dts;
+    pkt.duration = vpi_pkt->duration;
+
+    /* the packet is copied by avcodec_send_packet(), so the stream
+       buffer can be handed back right away */
+    ret = avcodec_send_packet(c->dec, &pkt);
+    if (ret < 0 && ret != AVERROR_INVALIDDATA)
+        return SW_ERR_GENERIC;
+    c->stats.bytes_copied += pkt.size;
+
+    ref = vpi_pkt->opaque;
+    if (av_fifo_space(c->used_strm) < sizeof(ref) &&
+        av_fifo_grow(c->used_strm, sizeof(ref)) < 0)
+        return SW_ERR_NOMEM;
+    av_fifo_generic_write(c->used_strm, &ref, sizeof(ref), NULL);
+
+    ret = sw_dec_drain(c);
+    sw_leave(c, start);
+    return ret < 0 ? ret : vpi_pkt->size;
+}
+
+static int sw_dec_get_frame(VpiCtx ctx, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiFrame *out;
+    SwSurface *s;
+    SwDecPic pic;
+    int64_t start;
+    int ret;
+
+    if (!c)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    if (!av_fifo_size(c->decoded)) {
+        sw_leave(c, start);
+        return c->dec_eof ? 2 : 0;
+    }
+    av_fifo_generic_peek(c->decoded, &pic, sizeof(pic), NULL);
+    if (!sw_is_ready(pic.ready) || !av_fifo_size(c->out_bufs)) {
+        sw_leave(c, start);
+        return 0;
+    }
+    av_fifo_generic_read(c->decoded, &pic, sizeof(pic), NULL);
+    av_fifo_generic_read(c->out_bufs, &out, sizeof(out), NULL);
+
+    s = sw_surface(out);
+    if (!s) {
+        av_frame_free(&pic.frame);
+        return SW_ERR_PARAM;
+    }
+
+    if (pic.frame->format == AV_PIX_FMT_NV12 ||
+        pic.frame->format == AV_PIX_FMT_P010LE) {
+        ret = sw_surface_fill(c, s, pic.frame, pic.frame);
+    } else {
+        const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(pic.frame->format);
+        enum AVPixelFormat fmt = desc->comp[0].depth > 8 ?
+                                 AV_PIX_FMT_P010LE : AV_PIX_FMT_NV12;
+        AVFrame *full = sw_convert(c, 1, pic.frame, NULL, fmt,
+                                   pic.frame->width, pic.frame->height);
+
+        ret = full ? sw_surface_fill(c, s, full, pic.frame) : SW_ERR_NOMEM;
+        av_frame_free(&pic.frame);
+    }
+    if (ret < 0)
+        return ret;
+
+    *(VpiFrame **)outdata = out;
+    sw_leave(c, start);
+    return 1;
+}
+
+static int sw_dec_control(VpiCtx ctx, void *indata, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiCtrlCmdParam *cmd = indata;
+    VpiFrame *buf;
+    AVBufferRef *ref = NULL;
+    int pending, ret = 0;
+    int64_t start;
+
+    if (!c)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    switch (cmd->cmd) {
+    case VPI_CMD_DEC_INIT_OPTION:
+        /* released by the caller with free() */
+        c->dec_opt = calloc(1, sizeof(*c->dec_opt));
+        *(VpiDecOption **)outdata = c->dec_opt;
+        ret = c->dec_opt ? 0 : SW_ERR_NOMEM;
+        break;
+    case VPI_CMD_DEC_GET_STRM_BUF_PKT:
+        *(VpiPacket **)outdata = &c->strm_pkt;
+        break;
+    case VPI_CMD_DEC_STRM_BUF_COUNT:
+        pending = av_fifo_size(c->decoded) / sizeof(SwDecPic);
+        *(int *)outdata = pending >= SW_DEC_MAX_PENDING ? -1 :
+                          SW_DEC_MAX_PENDING - pending;
+        break;
+    case VPI_CMD_DEC_GET_USED_STRM_MEM:
+        if (av_fifo_size(c->used_strm))
+            av_fifo_generic_read(c->used_strm, &ref, sizeof(ref), NULL);
+        *(AVBufferRef **)outdata = ref;
+        break;
+    case VPI_CMD_DEC_GET_FRAME_BUFFER_REQUEST:
+        pending = av_fifo_size(c->decoded) / sizeof(SwDecPic);
+        *(int *)outdata = av_fifo_size(c->out_bufs) / sizeof(VpiFrame *) <
+                          pending + SW_DEC_RESERVE;
+        break;
+    case VPI_CMD_DEC_SET_FRAME_BUFFER:
+        buf = cmd->data;
+        /* held until it is output, the decoder must not reclaim it before */
+        buf->locked = 1;
+        if (av_fifo_space(c->out_bufs) < sizeof(buf) &&
+            av_fifo_grow(c->out_bufs, sizeof(buf)) < 0) {
+            ret = SW_ERR_NOMEM;
+            break;
+        }
+        av_fifo_generic_write(c->out_bufs, &buf, sizeof(buf), NULL);
+        break;
+    case VPI_CMD_DEC_PIC_CONSUME:
+        /* the buffer goes back to the hwcontext pool, nothing is kept */
+        break;
+    default:
+        break;
+    }
+
+    sw_leave(c, start);
+    return ret;
+}
+
+static int sw_dec_close(VpiCtx ctx)
+{
+    SwCtx *c = sw_ctx(ctx);
+    AVBufferRef *ref;
+    SwDecPic pic;
+
+    if (!c)
+        return SW_ERR_PARAM;
+
+    avcodec_free_context(&c->dec);
+    while (c->used_strm && av_fifo_size(c->used_strm)) {
+        av_fifo_generic_read(c->used_strm, &ref, sizeof(ref), NULL);
+        av_buffer_unref(&ref);
+    }
+    while (c->decoded && av_fifo_size(c->decoded)) {
+        av_fifo_generic_read(c->decoded, &pic, sizeof(pic), NULL);
+        av_frame_free(&pic.frame);
+    }
+    av_fifo_freep(&c->used_strm);
+    av_fifo_freep(&c->decoded);
+    av_fifo_freep(&c->out_bufs);
+    return 0;
+}
+
+static VpiApi sw_dec_api = {
+    .init              = sw_dec_init,
+    .decode_put_packet = sw_dec_put_packet,
+    .decode_get_frame  = sw_dec_get_frame,
+    .control           = sw_dec_control,
+    .close             = sw_dec_close,
+};
+
+/* ----------------------------------------------------------------------
+ * Post processing, hwupload and hwdownload
+ */
+
+/**
+ * Wrap the planes of a host VpiFrame in an AVFrame without copying.
+ */
+static void sw_wrap_host_frame(AVFrame *dst, const VpiFrame *src,
+                               enum AVPixelFormat format, int width, int height)
+{
+    int i;
+
+    dst->format = format;
+    dst->width  = width;
+    dst->height = height;
+    for (i = 0; i < 3; i++) {
+        dst->data[i]     = src->data[i];
+        dst->linesize[i] = src->linesize[i];
+    }
+    dst->key_frame = src->key_frame;
+    dst->pts       = src->pts;
+    dst->pkt_dts   = src->pkt_dts;
+}
+
+static int sw_pp_init(VpiCtx ctx, void *cfg)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiPPOption *opt = cfg;
+    int ret;
+
+    if (!c || !opt)
+        return SW_ERR_PARAM;
+
+    ret = sw_parse_low_res(c, opt->low_res, 0);
+    if (ret < 0)
+        return ret;
+    c->force_10bit = opt->force_10bit;
+    c->in_format   = opt->format == VPI_FMT_VPE ? AV_PIX_FMT_NONE :
+                     sw_map_format(opt->format);
+    c->tmpl        = opt->frame;
+    sw_fill_template(c, opt->w, opt->h);
+    return 0;
+}
+
+static int sw_pp_process(VpiCtx ctx, void *indata, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiFrame *in = indata;
+    SwSurface *out = sw_surface(outdata);
+    AVFrame host = { { 0 } };
+    const AVFrame *src;
+    SwSurface *in_s;
+    AVFrame *full;
+    enum AVPixelFormat fmt;
+    int64_t start;
+    int ret;
+
+    if (!c || !in || !out)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    if (c->in_format == AV_PIX_FMT_NONE) {
+        in_s = sw_surface(in);
+        if (!in_s || !in_s->pic[1])
+            return SW_ERR_PARAM;
+        src = in_s->pic[1];
+    } else {
+        sw_wrap_host_frame(&host, in, c->in_format,
+                           c->pp_opt->w, c->pp_opt->h);
+        src = &host;
+    }
+
+    fmt = c->force_10bit || av_pix_fmt_desc_get(src->format)->comp[0].depth > 8 ?
+          AV_PIX_FMT_P010LE : AV_PIX_FMT_NV12;
+    if (src->format == fmt && c->in_format == AV_PIX_FMT_NONE) {
+        /* already in device layout, share the picture */
+        full = av_frame_clone(src);
+    } else {
+        full = sw_convert(c, 1, src, NULL, fmt, src->width, src->height);
+    }
+    if (!full)
+        return SW_ERR_NOMEM;
+
+    ret = sw_surface_fill(c, out, full, c->in_format == AV_PIX_FMT_NONE ?
+                                        src : &host);
+    if (c->in_format == AV_PIX_FMT_NONE) {
+        out->frame.key_frame = in->key_frame;
+        out->frame.pts       = in->pts;
+        out->frame.pkt_dts   = in->pkt_dts;
+    }
+    sw_leave(c, start);
+    sw_process_delay(c);
+    return ret;
+}
+
+static int sw_pp_control(VpiCtx ctx, void *indata, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiCtrlCmdParam *cmd = indata;
+
+    if (!c)
+        return SW_ERR_PARAM;
+
+    if (cmd->cmd == VPI_CMD_PP_INIT_OPTION) {
+        c->pp_opt = calloc(1, sizeof(*c->pp_opt));
+        *(VpiPPOption **)outdata = c->pp_opt;
+        return c->pp_opt ? 0 : SW_ERR_NOMEM;
+    }
+    return 0;
+}
+
+static int sw_pp_close(VpiCtx ctx)
+{
+    SwCtx *c = sw_ctx(ctx);
+
+    if (!c)
+        return SW_ERR_PARAM;
+    free(c->pp_opt);
+    c->pp_opt = NULL;
+    return 0;
+}
+
+static VpiApi sw_pp_api = {
+    .init    = sw_pp_init,
+    .process = sw_pp_process,
+    .control = sw_pp_control,
+    .close   = sw_pp_close,
+};
+
+static int sw_hwul_init(VpiCtx ctx, void *cfg)
+{
+    SwCtx *c = sw_ctx(ctx);
+
+    if (!c || !cfg)
+        return SW_ERR_PARAM;
+    c->in_format = sw_map_format(*(VpiPixsFmt *)cfg);
+    return c->in_format == AV_PIX_FMT_NONE ? SW_ERR_PARAM : 0;
+}
+
+static int sw_hwul_process(VpiCtx ctx, void *indata, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiFrame *in = indata;
+    SwSurface *out = sw_surface(outdata);
+    AVFrame host = { { 0 } };
+    AVFrame *pic;
+    int64_t start;
+    int ret;
+
+    if (!c || !in || !out)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    sw_wrap_host_frame(&host, in, c->in_format, in->src_width, in->src_height);
+    pic = sw_alloc_picture(c, c->in_format, in->src_width, in->src_height);
+    if (!pic)
+        return SW_ERR_NOMEM;
+    av_frame_copy(pic, &host);
+    c->stats.bytes_copied += av_image_get_buffer_size(pic->format, pic->width,
+                                                      pic->height, 1);
+
+    ret = sw_surface_fill(c, out, pic, &host);
+    sw_leave(c, start);
+    sw_process_delay(c);
+    return ret;
+}
+
+static VpiApi sw_hwul_api = {
+    .init    = sw_hwul_init,
+    .process = sw_hwul_process,
+    .control = sw_pp_control,
+    .close   = sw_pp_close,
+};
+
+static int sw_hwdw_init(VpiCtx ctx, void *cfg)
+{
+    SwCtx *c = sw_ctx(ctx);
+
+    if (!c)
+        return SW_ERR_PARAM;
+    c->hwdw_index = 1;
+    return 0;
+}
+
+static int sw_hwdw_process(VpiCtx ctx, void *indata, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    SwSurface *in = sw_surface(indata);
+    VpiFrame *out = outdata;
+    uint8_t *dst_data[4] = { NULL };
+    int dst_linesize[4] = { 0 };
+    const AVFrame *pic;
+    int64_t start;
+    int i;
+
+    if (!c || !in || !out)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    pic = in->pic[c->hwdw_index] ? in->pic[c->hwdw_index] : in->pic[1];
+    if (!pic)
+        return SW_ERR_PARAM;
+
+    for (i = 0; i < 3; i++) {
+        dst_data[i]     = out->data[i];
+        dst_linesize[i] = out->linesize[i];
+    }
+    av_image_copy(dst_data, dst_linesize, (const uint8_t **)pic->data,
+                  pic->linesize, pic->format, pic->width, pic->height);
+    c->stats.bytes_copied += av_image_get_buffer_size(pic->format, pic->width,
+                                                      pic->height, 1);
+    c->stats.frames++;
+
+    sw_leave(c, start);
+    sw_process_delay(c);
+    return 0;
+}
+
+static int sw_hwdw_control(VpiCtx ctx, void *indata, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiCtrlCmdParam *cmd = indata;
+    int index;
+
+    if (!c)
+        return SW_ERR_PARAM;
+
+    if (cmd->cmd == VPI_CMD_HWDW_SET_INDEX) {
+        index = *(int *)cmd->data;
+        if (index < 1 || index >= PIC_INDEX_MAX_NUMBER)
+            return SW_ERR_PARAM;
+        c->hwdw_index = index;
+    }
+    return 0;
+}
+
+static int sw_noop_close(VpiCtx ctx)
+{
+    return 0;
+}
+
+static VpiApi sw_hwdw_api = {
+    .init    = sw_hwdw_init,
+    .process = sw_hwdw_process,
+    .control = sw_hwdw_control,
+    .close   = sw_noop_close,
+};
+
+/* ----------------------------------------------------------------------
+ * Null encoders
+ */
+
+/**
+ * Pick the pp channel matching the configured encoder size.
+ */
+static const AVFrame *sw_enc_picture(SwCtx *c, SwSurface *s)
+{
+    int i;
+
+    for (i = 1; i < PIC_INDEX_MAX_NUMBER; i++) {
+        if (s->pic[i] && s->pic[i]->width == c->enc_width &&
+            s->pic[i]->height == c->enc_height)
+            return s->pic[i];
+    }
+    return s->pic[1];
+}
+
+static void sw_enc_release_slot(SwCtx *c, VpiFrame *slot)
+{
+    c->enc_slot_used[slot - c->enc_slots] = 0;
+}
+
+static int sw_fifo_push(AVFifoBuffer *fifo, void *data, int size)
+{
+    if (av_fifo_space(fifo) < size && av_fifo_grow(fifo, size) < 0)
+        return SW_ERR_NOMEM;
+    av_fifo_generic_write(fifo, data, size, NULL);
+    return 0;
+}
+
+/**
+ * Complete the pictures whose simulated processing time has elapsed.
+ */
+static int sw_enc_pump(SwCtx *c)
+{
+    const AVFrame *pic;
+    SwSurface *s;
+    SwEncJob job;
+    SwEncPkt pkt;
+    uint32_t sum;
+    int y, ret;
+
+    while (av_fifo_size(c->enc_jobs)) {
+        av_fifo_generic_peek(c->enc_jobs, &job, sizeof(job), NULL);
+        if (!sw_is_ready(job.ready))
+            break;
+        av_fifo_generic_read(c->enc_jobs, &job, sizeof(job), NULL);
+
+        if (!job.slot->opaque) {
+            c->enc_eof = 1;
+            sw_enc_release_slot(c, job.slot);
+            continue;
+        }
+
+        s   = sw_surface(job.slot->vpi_opaque);
+        pic = s ? sw_enc_picture(c, s) : NULL;
+        sum = 1;
+        if (pic) {
+            int bytes = pic->width *
+                        av_pix_fmt_desc_get(pic->format)->comp[0].step;
+
+            for (y = 0; y < pic->height; y++)
+                sum = av_adler32_update(sum, pic->data[0] + y * pic->linesize[0],
+                                        bytes);
+        }
+
+        memcpy(pkt.data, "VPSW", 4);
+        AV_WB32(pkt.data + 4, c->enc_frame_num);
+        AV_WB64(pkt.data + 8, job.slot->pts);
+        AV_WB32(pkt.data + 16, sum);
+        pkt.pts   = job.slot->pts;
+        pkt.dts   = job.slot->pts;
+        pkt.flags = !c->enc_frame_num || job.slot->key_frame;
+        c->enc_frame_num++;
+        c->stats.frames++;
+
+        ret = sw_fifo_push(c->enc_pkts, &pkt, sizeof(pkt));
+        if (ret < 0)
+            return ret;
+        ret = sw_fifo_push(c->enc_consumed, &job.slot->opaque,
+                           sizeof(job.slot->opaque));
+        if (ret < 0)
+            return ret;
+        sw_enc_release_slot(c, job.slot);
+    }
+    return 0;
+}
+
+static int sw_enc_init(VpiCtx ctx, void *cfg)
+{
+    SwCtx *c = sw_ctx(ctx);
+
+    if (!c || !cfg)
+        return SW_ERR_PARAM;
+
+    if (c->type == H26XENC_VPE) {
+        VpiH26xEncCfg *h26x = cfg;
+
+        c->enc_width  = h26x->lum_width_src;
+        c->enc_height = h26x->lum_height_src;
+    } else {
+        VpiVp9EncCfg *vp9 = cfg;
+
+        c->enc_width  = vp9->width;
+        c->enc_height = vp9->height;
+    }
+
+    c->enc_jobs     = av_fifo_alloc_array(SW_ENC_SLOTS, sizeof(SwEncJob));
+    c->enc_consumed = av_fifo_alloc_array(SW_ENC_SLOTS, sizeof(void *));
+    c->enc_pkts     = av_fifo_alloc_array(SW_ENC_SLOTS, sizeof(SwEncPkt));
+    if (!c->enc_jobs || !c->enc_consumed || !c->enc_pkts)
+        return SW_ERR_NOMEM;
+    return 0;
+}
+
+static int sw_enc_put_frame(VpiCtx ctx, void *indata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    SwEncJob job;
+    int64_t start;
+    int ret;
+
+    if (!c || !indata)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    job.slot  = indata;
+    job.ready = sw_schedule(c);
+    ret = sw_fifo_push(c->enc_jobs, &job, sizeof(job));
+
+    sw_leave(c, start);
+    return ret;
+}
+
+static int sw_enc_get_packet(VpiCtx ctx, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiPacket *vpi_pkt = outdata;
+    SwEncPkt pkt;
+
+    if (!c || !vpi_pkt || av_fifo_size(c->enc_pkts) < sizeof(pkt))
+        return SW_ERR_PARAM;
+
+    av_fifo_generic_read(c->enc_pkts, &pkt, sizeof(pkt), NULL);
+    memcpy(vpi_pkt->data, pkt.data, FFMIN(vpi_pkt->size, sizeof(pkt.data)));
+    vpi_pkt->size    = sizeof(pkt.data);
+    vpi_pkt->pts     = pkt.pts;
+    vpi_pkt->pkt_dts = pkt.dts;
+    vpi_pkt->flags   = pkt.flags;
+    return 0;
+}
+
+static int sw_enc_control(VpiCtx ctx, void *indata, void *outdata)
+{
+    SwCtx *c = sw_ctx(ctx);
+    VpiCtrlCmdParam *cmd = indata;
+    void *opaque = NULL;
+    int64_t start;
+    int i, ret = 0;
+
+    if (!c)
+        return SW_ERR_PARAM;
+    start = sw_enter();
+
+    switch (cmd->cmd) {
+    case VPI_CMD_ENC_INIT_OPTION:
+        /* released by the caller with free() */
+        c->enc_cfg = c->type == H26XENC_VPE ?
+                     calloc(1, sizeof(VpiH26xEncCfg)) :
+                     calloc(1, sizeof(VpiVp9EncCfg));
+        *(void **)outdata = c->enc_cfg;
+        ret = c->enc_cfg ? 0 : SW_ERR_NOMEM;
+        break;
+    case VPI_CMD_ENC_GET_EXTRADATA_SIZE:
+        *(int *)outdata = 0;
+        break;
+    case VPI_CMD_ENC_GET_EMPTY_FRAME_SLOT:
+        *(VpiFrame **)outdata = NULL;
+        for (i = 0; i < SW_ENC_SLOTS; i++) {
+            if (!c->enc_slot_used[i]) {
+                c->enc_slot_used[i] = 1;
+                memset(&c->enc_slots[i], 0, sizeof(c->enc_slots[i]));
+                *(VpiFrame **)outdata = &c->enc_slots[i];
+                break;
+            }
+        }
+        ret = i < SW_ENC_SLOTS ? 0 : SW_ERR_GENERIC;
+        break;
+    case VPI_CMD_ENC_CONSUME_PIC:
+        ret = sw_enc_pump(c);
+        if (ret >= 0 && av_fifo_size(c->enc_consumed))
+            av_fifo_generic_read(c->enc_consumed, &opaque, sizeof(opaque), NULL);
+        *(void **)outdata = opaque;
+        break;
+    case VPI_CMD_ENC_GET_FRAME_PACKET:
+        ret = sw_enc_pump(c);
+        if (ret < 0)
+            break;
+        if (av_fifo_size(c->enc_pkts)) {
+            *(int *)outdata = SW_ENC_PKT_SIZE;
+            ret = 0;
+        } else {
+            ret = c->enc_eof && !av_fifo_size(c->enc_jobs) ? 1 : -1;
+        }
+        break;
+    default:
+        break;
+    }
+
+    sw_leave(c, start);
+    return ret;
+}
+
+static int sw_enc_close(VpiCtx ctx)
+{
+    SwCtx *c = sw_ctx(ctx);
+
+    if (!c)
+        return SW_ERR_PARAM;
+    av_fifo_freep(&c->enc_jobs);
+    av_fifo_freep(&c->enc_consumed);
+    av_fifo_freep(&c->enc_pkts);
+    return 0;
+}
+
+static VpiApi sw_enc_api = {
+    .init              = sw_enc_init,
+    .encode_put_frame  = sw_enc_put_frame,
+    .encode_get_packet = sw_enc_get_packet,
+    .control           = sw_enc_control,
+    .close             = sw_enc_close,
+};
+
+/* ----------------------------------------------------------------------
+ * libvpi entry points
+ */
+
+static const char *sw_plugin_name(VpiPlugin type)
+{
+    switch (type) {
+    case H264DEC_VPE:    return "h264dec";
+    case HEVCDEC_VPE:    return "hevcdec";
+    case VP9DEC_VPE:     return "vp9dec";
+    case H26XENC_VPE:    return "h26xenc";
+    case VP9ENC_VPE:     return "vp9enc";
+    case PP_VPE:         return "pp";
+    case HWUPLOAD_VPE:   return "hwupload";
+    case HWDOWNLOAD_VPE: return "hwdownload";
+    default:             return "unknown";
+    }
+}
+
+static void sw_print_stats(SwCtx *c)
+{
+    const SwStats *st = &c->stats;
+    int64_t frames    = FFMAX(st->frames, 1);
+
+    av_log(NULL, AV_LOG_INFO,
+           "[vpi_sw %s] frames:%"PRId64" calls:%"PRId64" "
+           "host:%"PRId64"us (%.1fus/frame) latency:%"PRId64"us "
+           "copied:%"PRId64" bytes/frame allocs:%.2f/frame\n",
+           sw_plugin_name(c->type), st->frames, st->calls, st->host_us,
+           (double)st->host_us / frames, st->latency_us,
+           st->bytes_copied / frames, (double)st->allocs / frames);
+}
+
+int vpi_create(VpiCtx *ctx, VpiApi **vpi, int fd, VpiPlugin plugin)
+{
+    const char *env;
+    SwCtx *c;
+
+    if (plugin == HWCONTEXT_VPE) {
+        /* the context is the VpiSysInfo owned by the caller */
+        *vpi = &sw_hwcontext_api;
+        return 0;
+    }
+
+    c = av_mallocz(sizeof(*c));
+    if (!c)
+        return SW_ERR_NOMEM;
+    c->magic = SW_CTX_MAGIC;
+    c->type  = plugin;
+    c->fd    = fd;
+    env = getenv("VPI_SW_LATENCY_US");
+    c->latency = env ? strtoll(env, NULL, 10) : 0;
+
+    switch (plugin) {
+    case H264DEC_VPE:
+    case HEVCDEC_VPE:
+    case VP9DEC_VPE:
+        *vpi = &sw_dec_api;
+        break;
+    case H26XENC_VPE:
+    case VP9ENC_VPE:
+        *vpi = &sw_enc_api;
+        break;
+    case PP_VPE:
+        *vpi = &sw_pp_api;
+        break;
+    case HWUPLOAD_VPE:
+        *vpi = &sw_hwul_api;
+        break;
+    case HWDOWNLOAD_VPE:
+        *vpi = &sw_hwdw_api;
+        break;
+    default:
+        av_free(c);
+        return SW_ERR_PARAM;
+    }
+
+    pthread_mutex_lock(&sw_lock);
+    c->next     = sw_ctx_list;
+    sw_ctx_list = c;
+    pthread_mutex_unlock(&sw_lock);
+
+    *ctx = c;
+    return 0;
+}
+
+int vpi_destroy(VpiCtx ctx, int fd)
+{
+    SwCtx **p, *c = NULL;
+    int i;
+
+    /* the hwcontext destroys its VpiSysInfo, which is not ours */
+    pthread_mutex_lock(&sw_lock);
+    for (p = &sw_ctx_list; *p; p = &(*p)->next) {
+        if (*p == ctx) {
+            c  = *p;
+            *p = c->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&sw_lock);
+    if (!c)
+        return 0;
+
+    if (getenv("VPI_SW_STATS"))
+        sw_print_stats(c);
+
+    for (i = 0; i < PIC_INDEX_MAX_NUMBER; i++)
+        sws_freeContext(c->sws[i]);
+    c->magic = 0;
+    av_free(c);
+    return 0;
+}
+
+int vpi_get_sys_info_struct(VpiSysInfo **info)
+{
+    *info = calloc(1, sizeof(**info));
+    return *info ? 0 : SW_ERR_NOMEM;
+}
+
+int vpi_freep(void *arg)
+{
+    void **ptr = arg;
+
+    free(*ptr);
+    *ptr = NULL;
+    return 0;
+}
+
+int vpi_open_hwdevice(const char *device)
+{
+    int fd;
+
+    pthread_mutex_lock(&sw_lock);
+    fd = sw_next_fd++;
+    pthread_mutex_unlock(&sw_lock);
+    av_log(NULL, AV_LOG_VERBOSE, "[vpi_sw] opened %s as device %d\n",
+           device, fd);
+    return fd;
+}
+
+int vpi_close_hwdevice(int fd)
+{
+    if (getenv("VPI_SW_STATS"))
+        av_log(NULL, AV_LOG_INFO, "[vpi_sw] device %d closed, "
+               "%"PRId64" buffers still allocated\n", fd, sw_dev_buffers);
+    return 0;
+}
+
+const char *vpi_error_str(int err)
+{
+    switch (err) {
+    case SW_ERR_NOMEM: return "vpi_sw: out of memory";
+    case SW_ERR_PARAM: return "vpi_sw: invalid parameter";
+    default:           return "vpi_sw: error";
+    }
+}